@@ -16,10 +16,17 @@
 // #include "scenes/CubeTextureScene.h"
 // #include "scenes/MeshScene.h"
 // #include "scenes/SimpleScene.h"
+// #include "scenes/LightBenchmarkScene.h"
+// #include "scenes/SceneFormatBenchmarkScene.h"
 #include <iostream>
 
 // WARNING: THIS IS BROKEN FOR NOW, USE CbitGameEngine INSTEAD OF CbitApplication
 
+// The benchmark scenes (light_benchmark_1k/5k, scene_format_benchmark) are only reachable from here. To run one,
+// uncomment the Application block below together with the includes above, and make the benchmark the active scene
+// instead of "simple". The light benchmarks log their timings every few seconds, the scene format benchmark once
+// during setup.
+
 int main(int argc, char *args[]) {
     // Application game; // Create game here
     //
@@ -34,6 +41,9 @@ int main(int argc, char *args[]) {
     // game.getSceneManager().addScene("cube_texture", std::make_shared<CubeTextureScene>());
     // game.getSceneManager().addScene("mesh", std::make_shared<MeshScene>());
     // game.getSceneManager().addScene("simple", std::make_shared<SimpleScene>());
+    // game.getSceneManager().addScene("light_benchmark_1k", std::make_shared<LightBenchmarkScene>(1000));
+    // game.getSceneManager().addScene("light_benchmark_5k", std::make_shared<LightBenchmarkScene>(5000));
+    // game.getSceneManager().addScene("scene_format_benchmark", std::make_shared<SceneFormatBenchmarkScene>(100000));
     //
     // game.getSceneManager().setActiveScene("simple");
     //
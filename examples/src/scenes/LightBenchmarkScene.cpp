@@ -0,0 +1,116 @@
+/**
+ * @file    LightBenchmarkScene.cpp
+ * @brief   LightBenchmarkScene class implementation file
+ * @details LightBenchmarkScene fills a floor of cubes with a configurable number of moving point lights to
+ *          measure how clustered lighting scales (e.g. 1k vs 5k lights). Timings are logged every few seconds.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "LightBenchmarkScene.h"
+
+#include <cmath>
+#include <random>
+#include "../../../src/core/ecs/Components.h"
+#include "../../src/utilities/Logger.h"
+
+namespace {
+    constexpr int FLOOR_TILES = 64; // per side
+    constexpr float FLOOR_SIZE = 128.0f; // world units per side
+    constexpr float REPORT_INTERVAL = 2.0f; // seconds
+}
+
+LightBenchmarkScene::LightBenchmarkScene(const int lightCount) : _lightCount(lightCount) {
+}
+
+LightBenchmarkScene::~LightBenchmarkScene() = default;
+
+void LightBenchmarkScene::setup() {
+    Scene::setup();
+
+    // camera looking down at the floor from an angle
+    auto camera = _world.createGameObject("Benchmark Camera");
+    camera.addComponent<TransformComponent>();
+    auto &cameraComponent = camera.addComponent<CameraComponent>();
+    cameraComponent.isPrimary = true;
+    cameraComponent.distance = FLOOR_SIZE * 0.75f;
+    cameraComponent.pitch = 35.0f;
+    cameraComponent.farClip = FLOOR_SIZE * 2.0f;
+
+    // dim directional light so the point lights dominate
+    auto sun = _world.createGameObject("Benchmark Sun");
+    auto &directionalLight = sun.addComponent<DirectionalLightComponent>();
+    directionalLight.color = glm::vec3(0.05f);
+    directionalLight.ambient = glm::vec3(0.02f);
+
+    // floor of cubes
+    constexpr float tileSize = FLOOR_SIZE / static_cast<float>(FLOOR_TILES);
+    for (int z = 0; z < FLOOR_TILES; ++z) {
+        for (int x = 0; x < FLOOR_TILES; ++x) {
+            auto tile = _world.createGameObject("Tile");
+            auto &transform = tile.addComponent<TransformComponent>();
+            transform.position = glm::vec3((static_cast<float>(x) + 0.5f) * tileSize - FLOOR_SIZE * 0.5f,
+                                           -0.5f,
+                                           (static_cast<float>(z) + 0.5f) * tileSize - FLOOR_SIZE * 0.5f);
+            transform.scale = glm::vec3(tileSize * 0.95f, 1.0f, tileSize * 0.95f);
+            tile.addComponent<CubeComponent>();
+        }
+    }
+
+    // small colored point lights scattered over the floor; fixed seed so runs are comparable
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-FLOOR_SIZE * 0.5f, FLOOR_SIZE * 0.5f);
+    std::uniform_real_distribution<float> height(0.5f, 3.0f);
+    std::uniform_real_distribution<float> channel(0.2f, 1.0f);
+
+    _lights.reserve(_lightCount);
+    _lightOrigins.reserve(_lightCount);
+    for (int i = 0; i < _lightCount; ++i) {
+        auto light = _world.createGameObject("Light " + std::to_string(i));
+        auto &pointLight = light.addComponent<PointLightComponent>();
+        pointLight.position = glm::vec3(position(generator), height(generator), position(generator));
+        pointLight.color = glm::vec3(channel(generator), channel(generator), channel(generator));
+        // roughly a 10 unit radius, see ClusteredLighting::pointLightRange
+        pointLight.linear = 0.7f;
+        pointLight.quadratic = 1.8f;
+
+        _lights.push_back(light);
+        _lightOrigins.push_back(pointLight.position);
+    }
+
+    LOG_INFO("Light benchmark: {} point lights over {} cubes", _lightCount, FLOOR_TILES * FLOOR_TILES);
+}
+
+void LightBenchmarkScene::update(const float deltaTime, Input &input) {
+    Scene::update(deltaTime, input);
+    _time += deltaTime;
+
+    // keep the lights moving so they are re-binned into different clusters every frame
+    for (std::size_t i = 0; i < _lights.size(); ++i) {
+        const float phase = _time + static_cast<float>(i) * 0.37f;
+        _lights[i].getComponent<PointLightComponent>().position =
+                _lightOrigins[i] + glm::vec3(std::cos(phase) * 2.0f, 0.0f, std::sin(phase) * 2.0f);
+    }
+
+    const auto &renderStats = _world.getRenderStats();
+    const auto &clusterStats = _world.getLightingSystem().getClusterStats();
+    _renderTimeMs += renderStats.renderTimeMs;
+    _binningTimeMs += clusterStats.binningTimeMs;
+    ++_frames;
+
+    _reportTimer += deltaTime;
+    if (_reportTimer >= REPORT_INTERVAL) {
+        const auto frames = static_cast<float>(_frames);
+        LOG_INFO("Light benchmark ({} lights): {:.3f} ms render, {:.3f} ms binning, {} cluster refs, {} dropped",
+                 _lightCount, _renderTimeMs / frames, _binningTimeMs / frames, clusterStats.clusterReferences,
+                 clusterStats.droppedReferences);
+        _reportTimer = 0.0f;
+        _frames = 0;
+        _renderTimeMs = 0.0f;
+        _binningTimeMs = 0.0f;
+    }
+}
+
+void LightBenchmarkScene::render() {
+    Scene::render();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file    LightBenchmarkScene.h
+ * @brief   Header file for the LightBenchmarkScene class.
+ * @details LightBenchmarkScene fills a floor of cubes with a configurable number of moving point lights to
+ *          measure how clustered lighting scales (e.g. 1k vs 5k lights). Timings are logged every few seconds.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef LIGHTBENCHMARKSCENE_H
+#define LIGHTBENCHMARKSCENE_H
+
+#include <vector>
+#include "../../../src/core/ecs/GameObject.h"
+#include "../../../src/core/project/Scene.h"
+
+class LightBenchmarkScene final : public Scene {
+public:
+    explicit LightBenchmarkScene(int lightCount);
+
+    ~LightBenchmarkScene() override;
+
+    void setup() override;
+
+    void update(float deltaTime, Input &input) override;
+
+    void render() override;
+
+private:
+    int _lightCount;
+    float _time = 0.0f;
+
+    std::vector<GameObject> _lights;
+    std::vector<glm::vec3> _lightOrigins;
+
+    // running totals for the periodic log
+    float _reportTimer = 0.0f;
+    int _frames = 0;
+    float _renderTimeMs = 0.0f;
+    float _binningTimeMs = 0.0f;
+};
+
+
+#endif //LIGHTBENCHMARKSCENE_H
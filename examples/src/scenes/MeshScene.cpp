@@ -10,9 +10,8 @@
 #include "MeshScene.h"
 #include "../../../src/core/locator/Locator.h"
 #include "glm/ext/matrix_clip_space.hpp"
-#include "glm/ext/matrix_transform.hpp"
 
-MeshScene::MeshScene(): _viewMatrix(), _projectionMatrix() {
+MeshScene::MeshScene(): _cameraBuffer(UniformBlockBinding::Camera, sizeof(CameraBlock)) {
 }
 
 MeshScene::~MeshScene() {
@@ -24,11 +23,10 @@ void MeshScene::setup() {
     _quad.setPosition({100.0f, 5.0f, 0.0f}); // move it back 2 units
     _quad.setSize({200.0f, 200.0f}); // make it twice as big
 
-    _viewMatrix = glm::mat4(1.0f); // no camera
-
+    // no camera entity: the quad is placed in pixels, so the scene projects the window with an ortho camera
     const auto width = Locator::window()->getWidth();
     const auto height = Locator::window()->getHeight();
-    _projectionMatrix = glm::ortho(
+    _camera.projection = glm::ortho(
         0.0f, static_cast<float>(width),
         0.0f, static_cast<float>(height),
         -1.0f, 1.0f
@@ -43,8 +41,8 @@ void MeshScene::render() {
     Scene::render();
     const std::shared_ptr<ShaderProgram> meshShader = Locator::shaders().get("mesh");
 
+    // Scene::render() binds no camera here, so write our own into the Camera uniform block
+    _cameraBuffer.update(_camera);
     meshShader->use();
-    meshShader->setMat4("view", _viewMatrix);
-    meshShader->setMat4("projection", _projectionMatrix);
     _quad.draw(*meshShader);
 }
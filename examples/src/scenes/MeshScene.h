@@ -11,6 +11,7 @@
 #define CBIT_MESHSCENE_H
 
 #include "../../../src/core/mesh/MeshQuad.h"
+#include "core/ecs/CameraSystem.h"
 #include "core/project/Scene.h"
 
 class MeshScene : public Scene {
@@ -26,8 +27,8 @@ public:
     void render() override;
 private:
     MeshQuad _quad;
-    glm::mat4 _viewMatrix;
-    glm::mat4 _projectionMatrix;
+    CameraBlock _camera;
+    UniformBuffer _cameraBuffer;
 
 };
 
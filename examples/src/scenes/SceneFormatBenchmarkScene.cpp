@@ -0,0 +1,113 @@
+/**
+ * @file    SceneFormatBenchmarkScene.cpp
+ * @brief   SceneFormatBenchmarkScene class implementation file
+ * @details SceneFormatBenchmarkScene fills a scene with a configurable number of entities (e.g. 100k) and times
+ *          saving and loading it through SceneSerializer (JSON, loaded with both rapidjson and simdjson) and
+ *          SceneSnapshot (binary). Results are logged once during setup.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "SceneFormatBenchmarkScene.h"
+
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include "../../../src/core/ecs/Components.h"
+#include "../../../src/core/ecs/GameObject.h"
+#include "../../../src/core/project/SceneSerializer.h"
+#include "../../../src/core/project/SceneSnapshot.h"
+#include "../../src/utilities/Logger.h"
+
+namespace {
+    constexpr float WORLD_SIZE = 256.0f; // world units per side
+
+    template<typename Function>
+    float timeMs(Function &&function) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        function();
+        const std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+SceneFormatBenchmarkScene::SceneFormatBenchmarkScene(const int entityCount) : _entityCount(entityCount) {
+}
+
+SceneFormatBenchmarkScene::~SceneFormatBenchmarkScene() = default;
+
+void SceneFormatBenchmarkScene::setup() {
+    Scene::setup();
+    _populate();
+    _runBenchmark();
+}
+
+void SceneFormatBenchmarkScene::_populate() {
+    auto camera = _world.createGameObject("Benchmark Camera");
+    camera.addComponent<TransformComponent>();
+    auto &cameraComponent = camera.addComponent<CameraComponent>();
+    cameraComponent.isPrimary = true;
+    cameraComponent.distance = WORLD_SIZE * 0.75f;
+    cameraComponent.pitch = 35.0f;
+    cameraComponent.farClip = WORLD_SIZE * 2.0f;
+
+    _world.createGameObject("Benchmark Sun").addComponent<DirectionalLightComponent>();
+
+    // mostly colored cubes, with a light every 16 entities and a texture every 64; fixed seed so runs compare
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-WORLD_SIZE * 0.5f, WORLD_SIZE * 0.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (int i = 0; i < _entityCount; ++i) {
+        auto entity = _world.createGameObject("Cube " + std::to_string(i % 100));
+        entity.addComponent<TransformComponent>(
+            glm::vec3(position(generator), unit(generator) * 4.0f, position(generator)),
+            glm::vec3(0.0f, unit(generator) * 360.0f, 0.0f),
+            glm::vec3(0.5f + unit(generator)));
+        entity.addComponent<CubeComponent>().mesh.color =
+                glm::vec4(unit(generator), unit(generator), unit(generator), 1.0f);
+
+        if (i % 16 == 0) {
+            auto &pointLight = entity.addComponent<PointLightComponent>();
+            pointLight.position = glm::vec3(position(generator), 2.0f, position(generator));
+            pointLight.color = glm::vec3(unit(generator), unit(generator), unit(generator));
+        }
+        if (i % 64 == 0) {
+            entity.addComponent<TextureComponent>("assets/textures/crate.jpg");
+        }
+    }
+}
+
+void SceneFormatBenchmarkScene::_runBenchmark() {
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string jsonPath = (directory / "cbit_scene_benchmark.json").string();
+    const std::string snapshotPath = (directory / "cbit_scene_benchmark.cbscene").string();
+
+    const float jsonSaveMs = timeMs([&] { SceneSerializer(*this).saveToFile(jsonPath); });
+    const float snapshotSaveMs = timeMs([&] { SceneSnapshot(*this).saveToFile(snapshotPath); });
+
+    // load into scratch scenes so this one keeps rendering
+    Scene jsonScene;
+    const float jsonLoadMs = timeMs([&] {
+        SceneSerializer(jsonScene).loadFromFile(jsonPath, JsonBackend::RapidJson);
+    });
+    Scene simdjsonScene;
+    const float simdjsonLoadMs = timeMs([&] {
+        SceneSerializer(simdjsonScene).loadFromFile(jsonPath, JsonBackend::Simdjson);
+    });
+    Scene snapshotScene;
+    const float snapshotLoadMs = timeMs([&] { SceneSnapshot(snapshotScene).loadFromFile(snapshotPath); });
+
+    std::error_code error;
+    const auto jsonBytes = std::filesystem::file_size(jsonPath, error);
+    const auto snapshotBytes = std::filesystem::file_size(snapshotPath, error);
+
+    LOG_INFO("Scene format benchmark ({} entities):", _entityCount);
+    LOG_INFO("  JSON     save {:.1f} ms, load {:.1f} ms (rapidjson) / {:.1f} ms (simdjson), {} KB", jsonSaveMs,
+             jsonLoadMs, simdjsonLoadMs, jsonBytes / 1024);
+    LOG_INFO("  Snapshot save {:.1f} ms, load {:.1f} ms, {} KB", snapshotSaveMs, snapshotLoadMs,
+             snapshotBytes / 1024);
+
+    std::filesystem::remove(jsonPath, error);
+    std::filesystem::remove(snapshotPath, error);
+}
@@ -0,0 +1,33 @@
+/**
+ * @file    SceneFormatBenchmarkScene.h
+ * @brief   Header file for the SceneFormatBenchmarkScene class.
+ * @details SceneFormatBenchmarkScene fills a scene with a configurable number of entities (e.g. 100k) and times
+ *          saving and loading it through SceneSerializer (JSON, loaded with both rapidjson and simdjson) and
+ *          SceneSnapshot (binary). Results are logged once during setup.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef SCENEFORMATBENCHMARKSCENE_H
+#define SCENEFORMATBENCHMARKSCENE_H
+
+#include "../../../src/core/project/Scene.h"
+
+class SceneFormatBenchmarkScene final : public Scene {
+public:
+    explicit SceneFormatBenchmarkScene(int entityCount);
+
+    ~SceneFormatBenchmarkScene() override;
+
+    void setup() override;
+
+private:
+    int _entityCount;
+
+    void _populate();
+
+    void _runBenchmark();
+};
+
+
+#endif //SCENEFORMATBENCHMARKSCENE_H
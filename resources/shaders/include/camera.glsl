@@ -0,0 +1,8 @@
+// camera.glsl
+
+// per-frame camera data (CameraSystem, binding point 0)
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+};
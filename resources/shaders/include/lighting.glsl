@@ -0,0 +1,79 @@
+// lighting.glsl
+// Expects camera.glsl to be included first; clusterIndex() needs the view and projection
+
+// per-frame lighting data (LightingSystem, binding point 1)
+layout(std140) uniform Lighting {
+    vec4 lightDirection;  // xyz: directional light direction
+    vec4 lightColor;      // rgb: directional light color, a: shininess
+    vec4 ambientColor;    // rgb
+    vec4 clusterDepth;    // x: near, y: far, z: slice scale, w: slice bias
+    uvec4 clusterCounts;  // xyz: clusters per axis, w: number of lights
+};
+
+vec3 evaluateDirectionalLight(vec3 norm, vec3 viewDir, float shininess) {
+    vec3 lightDir = normalize(-lightDirection.xyz);
+    float diffuse = max(dot(norm, lightDir), 0.0);
+    float specular = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), shininess);
+    return (diffuse + specular) * lightColor.rgb;
+}
+
+#ifdef CLUSTERED_LIGHTS
+// clustered point/spot lights (ClusteredLighting)
+uniform samplerBuffer lightData;      // 4 texels per light
+uniform usamplerBuffer lightClusters; // per cluster: offset into lightIndices, light count
+uniform usamplerBuffer lightIndices;
+
+int clusterIndex(vec3 worldPosition) {
+    vec4 viewSpace = view * vec4(worldPosition, 1.0);
+    vec4 clip = projection * viewSpace;
+    vec2 ndc = clip.xy / clip.w;
+    float depth = max(-viewSpace.z, clusterDepth.x);
+
+    ivec3 counts = ivec3(clusterCounts.xyz);
+    int x = clamp(int((ndc.x * 0.5 + 0.5) * float(counts.x)), 0, counts.x - 1);
+    int y = clamp(int((ndc.y * 0.5 + 0.5) * float(counts.y)), 0, counts.y - 1);
+    int z = clamp(int(floor(log(depth) * clusterDepth.z + clusterDepth.w)), 0, counts.z - 1);
+    return x + counts.x * (y + counts.y * z);
+}
+
+vec3 evaluateLight(int light, vec3 worldPosition, vec3 norm, vec3 viewDir, float shininess) {
+    vec4 positionRange = texelFetch(lightData, light * 4);
+    vec4 colorType = texelFetch(lightData, light * 4 + 1);
+    vec4 directionOuter = texelFetch(lightData, light * 4 + 2);
+    vec4 attenuationInner = texelFetch(lightData, light * 4 + 3);
+
+    vec3 toLight = positionRange.xyz - worldPosition;
+    float dist = length(toLight);
+    if (dist >= positionRange.w) {
+        return vec3(0.0);
+    }
+    vec3 lightDir = toLight / dist;
+
+    // fade smoothly to zero at the range so the cluster cut-off is invisible
+    float fade = clamp(1.0 - pow(dist / positionRange.w, 4.0), 0.0, 1.0);
+    float attenuation = fade * fade /
+            (attenuationInner.x + attenuationInner.y * dist + attenuationInner.z * (dist * dist));
+
+    if (colorType.a > 0.5) {
+        // spot light: soft edge between the inner and outer cone
+        float theta = dot(-lightDir, normalize(directionOuter.xyz));
+        float epsilon = attenuationInner.w - directionOuter.w;
+        attenuation *= clamp((theta - directionOuter.w) / max(epsilon, 1e-4), 0.0, 1.0);
+    }
+
+    float diffuse = max(dot(norm, lightDir), 0.0);
+    float specular = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), shininess);
+    return (diffuse + specular) * colorType.rgb * attenuation;
+}
+
+// only the lights touching this fragment's cluster
+vec3 evaluateClusteredLights(vec3 worldPosition, vec3 norm, vec3 viewDir, float shininess) {
+    vec3 result = vec3(0.0);
+    uvec2 cluster = texelFetch(lightClusters, clusterIndex(worldPosition)).xy;
+    for (uint i = 0u; i < cluster.y; ++i) {
+        int light = int(texelFetch(lightIndices, int(cluster.x + i)).r);
+        result += evaluateLight(light, worldPosition, norm, viewDir, shininess);
+    }
+    return result;
+}
+#endif
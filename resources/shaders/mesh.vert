@@ -7,8 +7,8 @@ layout(location = 2) in vec2 aTexCoords; // <- correct!
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+#include "include/camera.glsl"
 
 void main() {
     TexCoords = aTexCoords;
@@ -1,19 +1,38 @@
 // mesh_lighting.vert
+// Variants (ShaderManager::getVariant): INSTANCED takes the model matrix, color and texture layer per instance
 #version 330 core
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoords;
 
+#ifdef INSTANCED
+// per-instance attributes (see InstanceData)
+layout(location = 3) in mat4 aModel;
+layout(location = 7) in vec4 aColor;
+layout(location = 8) in float aTextureLayer;
+#else
+uniform mat4 model;
+uniform vec4 color;
+#endif
+
 out vec2 TexCoords;
 out vec3 FragPos;
 out vec3 Normal;
+out vec4 Color;
+flat out float TextureLayer; // only the instanced path draws from texture arrays
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#include "include/camera.glsl"
 
 void main() {
+#ifdef INSTANCED
+    mat4 model = aModel;
+    Color = aColor;
+    TextureLayer = aTextureLayer;
+#else
+    Color = color;
+    TextureLayer = 0.0;
+#endif
     TexCoords = aTexCoords;
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
@@ -1,11 +1,11 @@
 // text.frag
 #version 330 core
 in vec2 TexCoords;
+in vec4 TextColor;
 out vec4 FragColor;
 uniform sampler2D text;
-uniform vec3 textColor;
 void main() {
-    // sample the alpha channel of our glyph texture
+    // the glyph atlas stores coverage in the red channel
     float alpha = texture(text, TexCoords).r;
-    FragColor = vec4(textColor, alpha);
+    FragColor = vec4(TextColor.rgb, TextColor.a * alpha);
 }
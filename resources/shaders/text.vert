@@ -1,9 +1,12 @@
 // text.vert
 #version 330 core
 layout(location = 0) in vec4 vertex; // (pos.xy, texcoord.xy)
+layout(location = 1) in vec4 color; // per glyph, so differently coloured text shares one draw
 out vec2 TexCoords;
+out vec4 TextColor;
 uniform mat4 projection;
 void main() {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    TextColor = color;
 }
@@ -13,6 +13,8 @@
 #include "Config.h"
 #include <SDL2/SDL_mixer.h>
 #include <glad/glad.h>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 #include "utilities/Logger.h"
 #include "utilities/LocalMachine.h"
@@ -20,12 +22,27 @@
 #include <utility>
 
 #include "core/locator/Locator.h"
+#include "core/graphic/RenderState.h"
 #include "core/splash/SplashScreen.h"
 #include "editor/EditorLogSink.h"
 #include <SDL2/SDL_image.h>
 #include "utilities/AssetsManager.h"
 #include "utilities/BuildGenerator.h"
 
+namespace {
+    struct DefaultShader {
+        const char *name;
+        const char *vertexShaderPath;
+        const char *fragmentShaderPath;
+    };
+
+    constexpr DefaultShader DEFAULT_SHADERS[] = {
+        {"color", "resources/shaders/color.vert", "resources/shaders/color.frag"},
+        {"mesh", "resources/shaders/mesh.vert", "resources/shaders/mesh.frag"},
+        {"default", "resources/shaders/default.vert", "resources/shaders/default.frag"},
+    };
+}
+
 Application::Application()
     : _window(TITLE, WIN_WIDTH, WIN_HEIGHT),
       _isRunning(true),
@@ -60,106 +77,88 @@ Application::~Application() {
 }
 
 bool Application::initialize() {
+    _initializeStart = std::chrono::steady_clock::now();
     Logger::initialize();
     BuildGenerator::GenerateBuildVersion();
 
     LOG_INFO("Starting Cbit Game Engine application");
 
-    // Initialize the SDL (here use everything)
-    if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
-        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
-        LOG_INFO("Unable to initialize SDL: %s", SDL_GetError());
-        return false;
-    }
-
-    // initialize SDL_ttf
-    if (TTF_Init() != 0) {
-        SDL_Log("Unable to initialize SDL_ttf: %s", SDL_GetError());
-        LOG_INFO("Unable to initialize SDL_ttf: %s", SDL_GetError());
-        return false;
-    }
-
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) == -1) {
-        LOG_ERROR("SDL_mixer could not initialize! SDL_mixer Error: {}", Mix_GetError());
-        return false;
-    }
-
-    // Initialize SDL_image for PNG support
-    if (constexpr int imgFlags = IMG_INIT_PNG; (IMG_Init(imgFlags) & imgFlags) != imgFlags) {
-        LOG_ERROR("SDL_image could not initialize PNG support! SDL_image Error: {}", IMG_GetError());
-        return false;
-    }
-
-    // Set OpenGL attributes
-    // Use the core OpenGL profile
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
-    // Specify version 3.3
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
-    // Request a color buffer with 8-bits per RGBA channel
-    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-    // Enable double buffering
-    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-    // Force OpenGL to use hardware acceleration
-    SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
-
-    // Initialize our Window wrapper (creates SDL_Window + GL context + vsync + viewport)
-    if (!_window.initialize()) {
-        LOG_ERROR("Window initialization failed");
-        return false;
-    }
-
-    Locator::provideWindow(&_window);
-
-    SDL_GL_SetSwapInterval(1); // Enable vsync
-
-    // initialize GLAD before calling any OpenGL functions
-    if (!gladLoadGL()) {
-        LOG_ERROR("Failed to initialize GLAD");
-        return false;
-    }
+    // SDL, the GL context and everything that touches them stay on this thread; file reads, parsing and directory
+    // scans run on worker threads meanwhile. Each task's timing is written to STARTUP_TRACE_PATH.
+    using Affinity = TaskGraph::Affinity;
+    TaskGraph startup;
+    std::vector<ShaderSources> shaderSources(std::size(DEFAULT_SHADERS));
+
+    const auto subsystems = startup.add("sdl", Affinity::Main, [this] { return _initializeSubsystems(); });
+    const auto window = startup.add("window", Affinity::Main, [this] { return _initializeWindow(); }, {subsystems});
+
+    // before anything reads resources: shaders and textures come from the pack when one is shipped
+    const auto assets = startup.add("assets", Affinity::Worker, [] {
+        AssetsManager::Get().initialize("resources/assets");
+        return true;
+    });
+
+    // SDL_ttf is used by nothing else until the graph is done
+    const auto font = startup.add("font", Affinity::Worker, [this] {
+        _font = TTF_OpenFont(LocalMachine::getFontPath(), 32);
+        if (_font == nullptr) {
+            LOG_ERROR("Failed to load font: {}", TTF_GetError());
+            return false;
+        }
+        return true;
+    }, {subsystems});
+
+    const auto readShaders = startup.add("read shaders", Affinity::Worker, [&shaderSources] {
+        return _readDefaultShaders(shaderSources);
+    }, {assets});
+    startup.add("compile shaders", Affinity::Main, [this, &shaderSources] {
+        if (!_initializeDefaultShaders(shaderSources)) {
+            LOG_ERROR("Failed to load default shaders");
+            return false;
+        }
+        return true;
+    }, {window, readShaders});
 
-    _logOpenGlInfo();
+    // reads the project file only, its scenes are loaded once the splash screen is done
+    const auto project = startup.add("recent project", Affinity::Worker, [this] {
+        _projectManager.loadRecentProjectIfExists();
+        return true;
+    });
 
-    _font = TTF_OpenFont(LocalMachine::getFontPath(), 32);
-    if (_font == nullptr) {
-        LOG_ERROR("Failed to load font: %s", TTF_GetError());
-        return false;
-    }
+    startup.add("cameras", Affinity::Main, [this] {
+        _initializeCameras();
+        return true;
+    });
 
 #ifdef ENABLE_EDITOR
-    _editor = new Editor(this, _window.getSDLWindow(), _window.getGLContext(), _editorCamera);
-    const auto editor_sink = std::make_shared<EditorLogSink>(_editor);
-    Logger::getLogger()->sinks().push_back(editor_sink);
-    _editor->setup(_screenWidth, _screenHeight);
+    const auto editor = startup.add("editor", Affinity::Main, [this] {
+        _editor = new Editor(this, _window.getSDLWindow(), _window.getGLContext(), _editorCamera);
+        _editor->setup(_screenWidth, _screenHeight);
+
+        // only the editor edits scenes; a running game must not write its state back into the project
+        _sceneManager.setAutosaveInterval(AUTOSAVE_INTERVAL_SECONDS);
+        return true;
+    }, {window});
+
+    // spdlog doesn't guard its sink list against other threads logging, so the console joins once the workers are done
+    startup.add("editor console", Affinity::Main, [this] {
+        const auto editor_sink = std::make_shared<EditorLogSink>(_editor);
+        Logger::getLogger()->sinks().push_back(editor_sink);
+        return true;
+    }, {editor, assets, font, readShaders, project});
 #endif
 
-    if (!_initializeDefaultShaders()) {
-        LOG_ERROR("Failed to load default shaders");
+    const bool started = startup.run();
+    startup.writeTrace(STARTUP_TRACE_PATH);
+    _startupStats = startup.getStats();
+    LOG_INFO("Startup: {} tasks in {:.1f} ms, {:.1f} ms of work on worker threads", _startupStats.tasks,
+             _startupStats.elapsedMs, _startupStats.workerMs);
+    if (!started) {
+        LOG_ERROR("Startup failed ({} failed, {} skipped), see {}", _startupStats.failed, _startupStats.skipped,
+                  STARTUP_TRACE_PATH);
         return false;
     }
 
-    AssetsManager::Get().initialize("resources/assets");
-
-    _editorCamera.setAspect(static_cast<float>(_screenWidth) / static_cast<float>(_screenHeight));
-
-    _uiCamera.setOrtho(0.0f, static_cast<float>(_screenWidth),
-                       static_cast<float>(_screenHeight), 0.0f); // y flipped for UI
-
-    // Register cameras
-    _cameraManager.registerCamera(CameraType::Editor, &_editorCamera);
-    _cameraManager.registerCamera(CameraType::UI, &_uiCamera);
-    // Register others like _gameCamera3D, _camera2D if you have them
-
-    // Optionally set the default active camera
-    _cameraManager.setActiveCamera(CameraType::Editor);
-
-    _projectManager.loadRecentProjectIfExists();
-
     _isRunning = true;
     return true;
 }
@@ -184,6 +183,11 @@ void Application::run() {
 
         _window.swapBuffers();
 
+        if (!_firstFramePresented) {
+            _firstFramePresented = true;
+            _recordTimeToFirstFrame();
+        }
+
         const Uint32 frameEnd = SDL_GetTicks();
 
         // Delay if the frame finished early
@@ -193,6 +197,10 @@ void Application::run() {
     }
 }
 
+void Application::setProgramBinaryCacheEnabled(const bool enabled) {
+    _programBinaryCacheEnabled = enabled;
+}
+
 void Application::exit() {
     LOG_INFO("Exiting application...");
     // Set the running flag to false to exit the main loop
@@ -230,6 +238,12 @@ void Application::_update(const float deltaTime) {
         }
     }
 
+    // hot reload: only the shaders and textures whose files changed are rebuilt
+    for (const auto &path: AssetsManager::Get().pollChanges()) {
+        _shaderManager.reloadFile(path);
+        _textureCache.reload(path);
+    }
+
     _sceneManager.update(deltaTime, _input);
 #ifdef ENABLE_EDITOR
     if (_sceneManager.getActiveSceneName() != "splash") {
@@ -243,6 +257,11 @@ void Application::_update(const float deltaTime) {
 }
 
 void Application::_render() {
+    RenderState::beginFrame();
+
+    // finish a budgeted share of the textures decoded in the background
+    Locator::textures().update();
+
     // Set the clear color (for example, black)
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     // Clear the color and depth buffers to remove any leftover splash screen image
@@ -260,6 +279,95 @@ void Application::_render() {
 #endif
 }
 
+bool Application::_initializeSubsystems() {
+    // Initialize the SDL (here use everything)
+    if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
+        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+        LOG_INFO("Unable to initialize SDL: {}", SDL_GetError());
+        return false;
+    }
+
+    // initialize SDL_ttf
+    if (TTF_Init() != 0) {
+        SDL_Log("Unable to initialize SDL_ttf: %s", SDL_GetError());
+        LOG_INFO("Unable to initialize SDL_ttf: {}", SDL_GetError());
+        return false;
+    }
+
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) == -1) {
+        LOG_ERROR("SDL_mixer could not initialize! SDL_mixer Error: {}", Mix_GetError());
+        return false;
+    }
+
+    // Initialize SDL_image for PNG support
+    if (constexpr int imgFlags = IMG_INIT_PNG; (IMG_Init(imgFlags) & imgFlags) != imgFlags) {
+        LOG_ERROR("SDL_image could not initialize PNG support! SDL_image Error: {}", IMG_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool Application::_initializeWindow() {
+    // Set OpenGL attributes
+    // Use the core OpenGL profile
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    // Specify version 3.3
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    // Request a color buffer with 8-bits per RGBA channel
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    // Enable double buffering
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    // Force OpenGL to use hardware acceleration
+    SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
+
+    // Initialize our Window wrapper (creates SDL_Window + GL context + vsync + viewport)
+    if (!_window.initialize()) {
+        LOG_ERROR("Window initialization failed");
+        return false;
+    }
+
+    Locator::provideWindow(&_window);
+    Locator::provideGeometry(&_geometryRegistry);
+    Locator::provideTextures(&_textureCache);
+    Locator::provideTextureArrays(&_textureArrays);
+
+    SDL_GL_SetSwapInterval(1); // Enable vsync
+
+    // initialize GLAD before calling any OpenGL functions
+    if (!gladLoadGL()) {
+        LOG_ERROR("Failed to initialize GLAD");
+        return false;
+    }
+
+    _logOpenGlInfo();
+
+    // before the first shader is compiled, so every program can come from the cache
+    if (_programBinaryCacheEnabled && _programBinaryCache.initialize(PROGRAM_BINARY_CACHE_DIRECTORY)) {
+        Locator::provideProgramBinaries(&_programBinaryCache);
+    }
+    return true;
+}
+
+void Application::_initializeCameras() {
+    _editorCamera.setAspect(static_cast<float>(_screenWidth) / static_cast<float>(_screenHeight));
+
+    _uiCamera.setOrtho(0.0f, static_cast<float>(_screenWidth),
+                       static_cast<float>(_screenHeight), 0.0f); // y flipped for UI
+
+    // Register cameras
+    _cameraManager.registerCamera(CameraType::Editor, &_editorCamera);
+    _cameraManager.registerCamera(CameraType::UI, &_uiCamera);
+    // Register others like _gameCamera3D, _camera2D if you have them
+
+    // Optionally set the default active camera
+    _cameraManager.setActiveCamera(CameraType::Editor);
+}
+
 void Application::_logOpenGlInfo() {
     LOG_INFO("OpenGL Version {}.{}", GLVersion.major, GLVersion.minor);
     // OpenGL version info
@@ -270,35 +378,58 @@ void Application::_logOpenGlInfo() {
     LOG_INFO("OpenGL Initialization Complete");
 }
 
-bool Application::_initializeDefaultShaders() {
-    if (!_shaderManager.loadFromFile(
-        "color",
-        "resources/shaders/color.vert",
-        "resources/shaders/color.frag")) {
-        return false;
+void Application::_recordTimeToFirstFrame() const {
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - _initializeStart;
+    const auto &[hits, misses, rejected, stored] = _programBinaryCache.getStats();
+    if (!_programBinaryCache.isEnabled()) {
+        LOG_INFO("Time to first frame: {:.1f} ms (program binary cache off)", elapsed.count());
+    } else {
+        LOG_INFO("Time to first frame: {:.1f} ms (program binary cache: {} hits, {} misses, {} rejected)",
+                 elapsed.count(), hits, misses, rejected);
     }
 
-    if (!_shaderManager.loadFromFile(
-        "mesh",
-        "resources/shaders/mesh.vert",
-        "resources/shaders/mesh.frag")) {
-        return false;
+    // one row per start, so cold-start time can be compared across builds
+    std::error_code error;
+    const bool exists = std::filesystem::exists(STARTUP_METRICS_PATH, error);
+    if (const auto parent = std::filesystem::path(STARTUP_METRICS_PATH).parent_path(); !parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+    std::ofstream metrics(STARTUP_METRICS_PATH, std::ios::app);
+    if (!metrics.is_open()) {
+        LOG_WARN("Could not open startup metrics file: {}", STARTUP_METRICS_PATH);
+        return;
+    }
+    if (!exists) {
+        metrics << "timestamp,build,startup_ms,worker_ms,first_frame_ms,program_cache_hits,program_cache_misses\n";
     }
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    metrics << timestamp << ',' << BuildGenerator::GetBuildVersion() << ',' << _startupStats.elapsedMs << ','
+            << _startupStats.workerMs << ',' << elapsed.count() << ',' << hits << ',' << misses << '\n';
+}
 
-    if (!_shaderManager.loadFromFile(
-        "default",
-        "resources/shaders/default.vert",
-        "resources/shaders/default.frag")) {
-        return false;
+bool Application::_readDefaultShaders(std::vector<ShaderSources> &sources) {
+    for (std::size_t i = 0; i < std::size(DEFAULT_SHADERS); ++i) {
+        if (!ShaderPreprocessor::process(DEFAULT_SHADERS[i].vertexShaderPath, {}, sources[i].vertexShader) ||
+            !ShaderPreprocessor::process(DEFAULT_SHADERS[i].fragmentShaderPath, {}, sources[i].fragmentShader)) {
+            return false;
+        }
     }
+    return true;
+}
 
-    if (!_shaderManager.loadFromFile(
-        "mesh_lighting",
-        "resources/shaders/mesh_lighting.vert",
-        "resources/shaders/mesh_lighting.frag")) {
-        return false;
+bool Application::_initializeDefaultShaders(const std::vector<ShaderSources> &sources) {
+    for (std::size_t i = 0; i < std::size(DEFAULT_SHADERS); ++i) {
+        if (!_shaderManager.loadPreprocessed(DEFAULT_SHADERS[i].name, sources[i].vertexShader,
+                                             sources[i].fragmentShader)) {
+            return false;
+        }
     }
 
+    // lit meshes: each renderer asks for the textured/instanced/lighting combination it needs, built on first use
+    _shaderManager.addVariants("mesh_lighting", "resources/shaders/mesh_lighting.vert",
+                               "resources/shaders/mesh_lighting.frag");
+
     Locator::provide(&_shaderManager);
 
     return true;
@@ -314,6 +445,7 @@ void Application::_cleanup() {
     }
 #endif
     _sceneManager.cleanup();
+    AssetsManager::Get().shutdown();
     if (_font) {
         TTF_CloseFont(_font);
         _font = nullptr;
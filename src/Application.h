@@ -14,15 +14,21 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <chrono>
 
 #include "core/camera/CameraManager.h"
 #include "core/project/SceneManager.h"
 #include "core/input/Input.h"
 #include "core/camera/OrbitCamera.h"
+#include "core/graphic/ProgramBinaryCache.h"
 #include "core/graphic/ShaderManager.h"
+#include "core/graphic/TextureArrayAllocator.h"
+#include "core/graphic/TextureCache.h"
+#include "core/mesh/GeometryRegistry.h"
 #include "core/camera/UICamera.h"
 #include "core/window/Window.h"
 #include "core/project/ProjectManager.h"
+#include "utilities/TaskGraph.h"
 
 #ifdef ENABLE_EDITOR
 #include "editor/Editor.h"
@@ -38,6 +44,9 @@ public:
 
     bool initialize();
 
+    // Call before initialize(); off compiles every shader from source, to compare startup times
+    void setProgramBinaryCacheEnabled(bool enabled);
+
     void run();
 
     void exit();
@@ -74,6 +83,24 @@ private:
     // Shader Manager
     ShaderManager _shaderManager;
 
+    // Linked shader programs stored between runs
+    ProgramBinaryCache _programBinaryCache;
+    bool _programBinaryCacheEnabled = true;
+
+    // startup is measured up to the first presented frame
+    std::chrono::steady_clock::time_point _initializeStart;
+    TaskGraph::Stats _startupStats;
+    bool _firstFramePresented = false;
+
+    // Shared primitive geometry (cube, quad, ...)
+    GeometryRegistry _geometryRegistry;
+
+    // Shared textures (declared before the scenes so they outlive the handles held by components)
+    TextureCache _textureCache;
+
+    // Texture arrays shared by the instanced path (declared before the scenes so it outlives their layers)
+    TextureArrayAllocator _textureArrays;
+
     // Project manager
     ProjectManager _projectManager;
 
@@ -92,9 +119,27 @@ private:
 
     void _cleanup();
 
+    // Shader sources read and preprocessed off the main thread, in the order of the default shader list
+    struct ShaderSources {
+        ShaderSource vertexShader;
+        ShaderSource fragmentShader;
+    };
+
+    // startup steps, run as tasks of a TaskGraph by initialize()
+    static bool _initializeSubsystems();
+
+    bool _initializeWindow();
+
+    void _initializeCameras();
+
+    static bool _readDefaultShaders(std::vector<ShaderSources> &sources);
+
+    bool _initializeDefaultShaders(const std::vector<ShaderSources> &sources);
+
     static void _logOpenGlInfo();
 
-    bool _initializeDefaultShaders();
+    // Logs the time to first frame and appends this start to STARTUP_METRICS_PATH
+    void _recordTimeToFirstFrame() const;
 };
 
 #endif //GAME_H
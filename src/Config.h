@@ -9,6 +9,8 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <cstddef>
+
 // =============  window attributes ======================================== //
 inline auto TITLE = "Cbit Engine"; // window title
 inline auto VERSION = "3.0.1"; // engine version
@@ -20,6 +22,10 @@ inline auto glsl_version = "#version 130";
 constexpr unsigned int FPS = 60; // Frame per seconds
 constexpr unsigned int FRAME_TARGET_TIME = 1000 / FPS; // this makes 60 miliseconds
 inline bool wireframe = false;
+constexpr float AUTOSAVE_INTERVAL_SECONDS = 5.0f; // editor appends scene edits to the journal this often
+constexpr std::size_t ASSET_MEMORY_BUDGET_BYTES = 256u * 1024u * 1024u; // resident textures, music and sounds
+inline auto STARTUP_TRACE_PATH = "cache/startup_trace.json"; // per-task timings of the last start, Chrome trace format
+inline auto STARTUP_METRICS_PATH = "cache/startup_metrics.csv"; // one row per start, to track cold-start time
 
 // ================== camera attributes ==================================== //
 inline float yaw = 0.f;
@@ -37,6 +43,8 @@ inline bool show_another_window = false;
 // ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
 // ================== shader attributes ==================================== //
+inline auto PROGRAM_BINARY_CACHE_DIRECTORY = "cache/programs"; // linked shader programs kept between runs
+
 // Vertex Shader source code
 inline auto vertexShaderSource = R"glsl(
     #version 330 core
@@ -0,0 +1,89 @@
+/**
+ * @file    Frustum.cpp
+ * @brief   Implementation file for the Frustum class.
+ * @details This file contains the implementation of the Frustum class which holds the six clip planes of a
+ *          view-projection matrix and tests bounding spheres against them, four at a time where SSE is available.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "Frustum.h"
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FRUSTUM_USE_SSE 1
+#include <xmmintrin.h>
+#endif
+
+Frustum::Frustum(const glm::mat4 &viewProjection) {
+    // glm is column major, transposing gives us the rows of the matrix to combine (Gribb & Hartmann)
+    const glm::mat4 rows = glm::transpose(viewProjection);
+
+    _planes[0] = rows[3] + rows[0]; // left
+    _planes[1] = rows[3] - rows[0]; // right
+    _planes[2] = rows[3] + rows[1]; // bottom
+    _planes[3] = rows[3] - rows[1]; // top
+    _planes[4] = rows[3] + rows[2]; // near
+    _planes[5] = rows[3] - rows[2]; // far
+
+    for (auto &plane: _planes) {
+        if (const float length = glm::length(glm::vec3(plane)); length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+bool Frustum::intersectsSphere(const glm::vec4 &sphere) const {
+    const glm::vec3 center(sphere);
+    for (const auto &plane: _planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -sphere.w) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t Frustum::cullSpheres(const glm::vec4 *spheres, const std::size_t count, std::uint8_t *visible) const {
+    std::size_t insideCount = 0;
+    std::size_t i = 0;
+
+#ifdef FRUSTUM_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        // load four spheres and transpose them to one register per component
+        __m128 x = _mm_loadu_ps(glm::value_ptr(spheres[i + 0]));
+        __m128 y = _mm_loadu_ps(glm::value_ptr(spheres[i + 1]));
+        __m128 z = _mm_loadu_ps(glm::value_ptr(spheres[i + 2]));
+        __m128 radius = _mm_loadu_ps(glm::value_ptr(spheres[i + 3]));
+        _MM_TRANSPOSE4_PS(x, y, z, radius);
+
+        const __m128 negativeRadius = _mm_sub_ps(zero, radius);
+        __m128 outside = zero;
+
+        for (const auto &plane: _planes) {
+            __m128 distance = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            const bool inside = (outsideMask & (1 << lane)) == 0;
+            visible[i + lane] = inside ? 1 : 0;
+            insideCount += inside ? 1 : 0;
+        }
+    }
+#endif
+
+    // scalar tail, or everything when SSE isn't available
+    for (; i < count; ++i) {
+        const bool inside = intersectsSphere(spheres[i]);
+        visible[i] = inside ? 1 : 0;
+        insideCount += inside ? 1 : 0;
+    }
+
+    return insideCount;
+}
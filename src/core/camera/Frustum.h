@@ -0,0 +1,38 @@
+/**
+ * @file    Frustum.h
+ * @brief   Header file for the Frustum class.
+ * @details This file contains the definition of the Frustum class which holds the six clip planes of a
+ *          view-projection matrix and tests bounding spheres against them, four at a time where SSE is available.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class Frustum {
+public:
+    Frustum() = default;
+
+    // Extract the planes from an OpenGL style (clip z in [-w, w]) projection * view matrix
+    explicit Frustum(const glm::mat4 &viewProjection);
+
+    // `sphere` is xyz: world center, w: radius. True if the sphere is at least partly inside.
+    [[nodiscard]] bool intersectsSphere(const glm::vec4 &sphere) const;
+
+    // Batch version of intersectsSphere: writes 1 (inside) or 0 (outside) to visible[i] for each of the
+    // `count` spheres and returns how many are inside
+    std::size_t cullSpheres(const glm::vec4 *spheres, std::size_t count, std::uint8_t *visible) const;
+
+private:
+    // left, right, bottom, top, near, far; xyz is the inward facing unit normal, w the distance
+    std::array<glm::vec4, 6> _planes{};
+};
+
+
+#endif //FRUSTUM_H
@@ -9,7 +9,9 @@
 #include "CameraSystem.h"
 #include "Components.h"
 
-CameraSystem::CameraSystem(entt::registry &registry): _registry(registry) {
+CameraSystem::CameraSystem(entt::registry &registry)
+    : _registry(registry),
+      _cameraBuffer(UniformBlockBinding::Camera, sizeof(CameraBlock)) {
 }
 
 void CameraSystem::updateViewport(const int width, const int height) {
@@ -17,9 +19,11 @@ void CameraSystem::updateViewport(const int width, const int height) {
     _height = height;
 }
 
-void CameraSystem::bindActiveCamera(const std::shared_ptr<ShaderProgram> &shader) const {
+void CameraSystem::bindActiveCamera() {
+    CameraBlock block;
+
     for (const auto view = _registry.view<CameraComponent, TransformComponent>(); const auto entity: view) {
-        auto &transform = view.get<TransformComponent>(entity);
+        const auto &transform = view.get<TransformComponent>(entity);
         const auto &camera = view.get<CameraComponent>(entity);
         if (!camera.isPrimary) continue;
 
@@ -33,11 +37,16 @@ void CameraSystem::bindActiveCamera(const std::shared_ptr<ShaderProgram> &shader
             direction.z = sin(yawRadian) * cos(pitchRadian);
             const glm::vec3 position = camera.target - direction * camera.distance;
 
-            transform.position = position;
+            // pitch around X, yaw around Y (adjust +90° if your forward axis differs)
+            const glm::vec3 rotation(-camera.pitch, -camera.yaw + 90.0f, 0.0f);
 
-            transform.rotation.x = -camera.pitch; // pitch around X
-            transform.rotation.y = -camera.yaw + 90.0f; // yaw around Y (adjust +90° if your forward axis differs)
-            transform.rotation.z = 0.0f;
+            // patch only on change, an orbit camera at rest must not dirty its world matrix every frame
+            if (transform.position != position || transform.rotation != rotation) {
+                _registry.patch<TransformComponent>(entity, [&](TransformComponent &cameraTransform) {
+                    cameraTransform.position = position;
+                    cameraTransform.rotation = rotation;
+                });
+            }
 
             // Build view matrix with lookAt:
             const glm::mat4 viewMatrix = glm::lookAt(position,
@@ -53,20 +62,27 @@ void CameraSystem::bindActiveCamera(const std::shared_ptr<ShaderProgram> &shader
 
             _lastViewMatrix = viewMatrix;
             _lastProjectionMatrix = projection;
-            // Set uniforms in shader
-            shader->setMat4("view", viewMatrix);
-            shader->setMat4("projection", projection);
+
+            block.view = viewMatrix;
+            block.projection = projection;
+            block.viewPosition = glm::vec4(position, 1.0f);
         } else if (camera.type == CameraComponentType::UI) {
             auto viewMatrix = glm::mat4(1.0f);
             glm::mat4 projectionMatrix = glm::ortho(camera.orthographicLeft, camera.orthographicRight,
                                                     camera.orthographicBottom, camera.orthographicTop,
                                                     -1.0f, +1.0f);
-            shader->setMat4("view", viewMatrix);
-            shader->setMat4("projection", projectionMatrix);
+            _lastViewMatrix = viewMatrix;
+            _lastProjectionMatrix = projectionMatrix;
+
+            block.view = viewMatrix;
+            block.projection = projectionMatrix;
+            block.viewPosition = glm::vec4(transform.position, 1.0f);
         }
 
-        return;
+        break;
     }
+
+    _cameraBuffer.update(block);
 }
 
 glm::vec3 CameraSystem::getActiveCameraPosition() const {
@@ -10,7 +10,15 @@
 #define CAMERASYSTEM_H
 
 #include <entt/entt.hpp>
-#include "../graphic/ShaderManager.h"
+#include <glm/glm.hpp>
+#include "../graphic/UniformBuffer.h"
+
+// std140 layout of the "Camera" uniform block (see UniformBlockBinding::Camera)
+struct CameraBlock {
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::vec4 viewPosition{0.0f}; // xyz: camera position in world space
+};
 
 class CameraSystem {
 public:
@@ -18,7 +26,8 @@ public:
 
     void updateViewport(int width, int height);
 
-    void bindActiveCamera(const std::shared_ptr<ShaderProgram> &shader) const;
+    // Upload the primary camera into the "Camera" uniform block, shared by every shader that declares it
+    void bindActiveCamera();
 
     [[nodiscard]] glm::vec3 getActiveCameraPosition() const;
 
@@ -26,7 +35,7 @@ public:
 
     [[nodiscard]] glm::mat4 getActiveProjectionMatrix() const;
 
-    // these give you back the *exact* view/proj just used in bindActiveCamera()
+    // these give you back the *exact* view/proj just uploaded in bindActiveCamera()
     [[nodiscard]] glm::mat4 getLastViewMatrix() const;
 
     [[nodiscard]] glm::mat4 getLastProjectionMatrix() const;
@@ -39,6 +48,8 @@ private:
     // mutable so we can update in a const method
     mutable glm::mat4 _lastViewMatrix = glm::mat4(1.0f);
     mutable glm::mat4 _lastProjectionMatrix = glm::mat4(1.0f);
+
+    UniformBuffer _cameraBuffer;
 };
 
 
@@ -10,6 +10,7 @@
 #ifndef COMPONENTS_H
 #define COMPONENTS_H
 
+#include <cmath>
 #include <string>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/matrix_transform.hpp>
@@ -20,6 +21,8 @@
 
 #include "../mesh/CubeMesh.h"
 #include "../mesh/MeshQuad.h"
+#include "../graphic/TextureArrayAllocator.h"
+#include "../locator/Locator.h"
 
 struct TagComponent {
     std::string tag;
@@ -29,6 +32,8 @@ struct IdComponent {
     std::string uuid;
 };
 
+// After construction, change a transform through registry.patch (or GameObject / EntityComponentSystem
+// patchComponent) so its cached WorldMatrixComponent gets rebuilt; plain writes are not noticed.
 struct TransformComponent {
     glm::vec3 position{0.0f, 0.0f, 0.0f}; // world space
     glm::vec3 rotation{0.0f, 0.0f, 0.0f}; // Euler angles in degrees
@@ -46,14 +51,59 @@ struct TransformComponent {
         : position(pos), rotation(rot), scale(scl) {
     }
 
+    // Same convention as the renderers (translate, rotate X then Y then Z, scale). Computing this is what
+    // the cached WorldMatrixComponent saves; prefer reading that one.
     [[nodiscard]] glm::mat4 getMatrix() const {
-        auto mat = glm::mat4(1.0f);
-        mat = glm::translate(mat, position);
-        // Note: GLM rotates in radians, ImGuizmo gives/needs degrees
-        mat *= glm::toMat4(glm::quat(glm::radians(rotation)));
-        mat = glm::scale(mat, scale);
-        return mat;
+        return Mesh::buildModelMatrix(position, rotation, scale);
     }
+
+    // Inverse of getMatrix() for matrices without shear, e.g. the result of a gizmo manipulation
+    void setFromMatrix(const glm::mat4 &matrix) {
+        position = glm::vec3(matrix[3]);
+        scale = glm::vec3(glm::length(glm::vec3(matrix[0])),
+                          glm::length(glm::vec3(matrix[1])),
+                          glm::length(glm::vec3(matrix[2])));
+
+        glm::mat3 basis(1.0f);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] > 0.0f) {
+                basis[axis] = glm::vec3(matrix[axis]) / scale[axis];
+            }
+        }
+
+        // basis = Rx * Ry * Rz
+        const float sinY = glm::clamp(basis[2][0], -1.0f, 1.0f);
+        const float y = std::asin(sinY);
+        float x;
+        float z;
+        if (std::abs(sinY) < 0.99999f) {
+            x = std::atan2(-basis[2][1], basis[2][2]);
+            z = std::atan2(-basis[1][0], basis[0][0]);
+        } else {
+            // gimbal lock, only X + Z is defined so put it all in X
+            x = std::atan2(basis[0][1] * sinY, basis[1][1]);
+            z = 0.0f;
+        }
+        rotation = glm::degrees(glm::vec3(x, y, z));
+    }
+};
+
+// Cached model matrix of a TransformComponent, rebuilt by the TransformSystem only when the transform is
+// created or patched. Renderers, culling and the gizmo read this instead of recomputing the matrix.
+struct WorldMatrixComponent {
+    glm::mat4 matrix{1.0f};
+};
+
+// Tag set on entities whose TransformComponent changed since the last TransformSystem::update
+struct TransformDirtyComponent {
+};
+
+// World space bounding sphere of a quad or cube, kept up to date by the CullingSystem. The sphere is only
+// recomputed after the TransformSystem rebuilt the entity's world matrix.
+struct BoundsComponent {
+    glm::vec4 sphere{0.0f}; // xyz: world center, w: radius
+    bool valid = false; // cleared when the world matrix changes
+    bool visible = true; // result of the last culling pass
 };
 
 struct QuadComponent {
@@ -69,13 +119,21 @@ struct CubeComponent {
 };
 
 struct TextureComponent {
-    Texture texture;
+    ref<Texture> texture; // shared through the TextureCache
     std::string path;
+    ref<TextureArrayLayer> arrayLayer; // copy of the texture in a texture array, made on first instanced use
 
     TextureComponent() = default;
 
-    explicit TextureComponent(std::string texturePath): path(std::move(texturePath)) {
-        texture.loadTexture(path);
+    explicit TextureComponent(std::string texturePath) {
+        load(std::move(texturePath));
+    }
+
+    void load(std::string texturePath) {
+        path = std::move(texturePath);
+        // never blocks: a placeholder is drawn until the image has been decoded and uploaded
+        texture = Locator::textures().acquireAsync(path);
+        arrayLayer.reset();
     }
 };
 
@@ -121,6 +179,7 @@ struct SpotLightComponent {
     glm::vec3 color = glm::vec3(1.0f);
     float cutOff = 12.5f;
     float outerCutOff = 17.5f;
+    float range = 10.0f; // distance at which the light fades out completely
 };
 
 #endif //COMPONENTS_H
@@ -0,0 +1,89 @@
+/**
+ * @file    CullingSystem.cpp
+ * @brief   Implementation file for the CullingSystem class
+ * @details The CullingSystem class keeps the world bounds of every quad and cube up to date and flags the ones
+ *          outside the camera frustum, so the render paths can skip them before anything reaches the GL.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "CullingSystem.h"
+#include <algorithm>
+#include <chrono>
+#include "Components.h"
+
+CullingSystem::CullingSystem(entt::registry &registry)
+    : _registry(registry) {
+}
+
+template<typename MeshComponent>
+void CullingSystem::_addMissingBounds() {
+    _missing.clear();
+    for (const auto entity: _registry.view<MeshComponent, WorldMatrixComponent>(entt::exclude<BoundsComponent>)) {
+        _missing.push_back(entity);
+    }
+    for (const auto entity: _missing) {
+        _registry.emplace<BoundsComponent>(entity);
+    }
+}
+
+template<typename MeshComponent>
+void CullingSystem::_gatherBounds() {
+    for (const auto view = _registry.view<MeshComponent, WorldMatrixComponent, BoundsComponent>();
+         const auto entity: view
+    ) {
+        auto &bounds = view.template get<BoundsComponent>(entity);
+
+        // only rebuild the world sphere after the world matrix changed
+        if (!bounds.valid) {
+            const glm::mat4 &model = view.template get<WorldMatrixComponent>(entity).matrix;
+            const glm::vec4 &local = view.template get<MeshComponent>(entity).mesh.geometry().getBoundingSphere();
+            const glm::vec3 center = model * glm::vec4(glm::vec3(local), 1.0f);
+            const float scale = std::max({
+                glm::length(glm::vec3(model[0])),
+                glm::length(glm::vec3(model[1])),
+                glm::length(glm::vec3(model[2]))
+            });
+
+            bounds.sphere = glm::vec4(center, local.w * scale);
+            bounds.valid = true;
+        }
+
+        _spheres.push_back(bounds.sphere);
+        _bounds.push_back(&bounds);
+    }
+}
+
+void CullingSystem::update(const glm::mat4 &viewProjection) {
+    const auto cullStart = std::chrono::high_resolution_clock::now();
+
+    // emplace first: adding components while holding pointers into the storage would invalidate them
+    _addMissingBounds<QuadComponent>();
+    _addMissingBounds<CubeComponent>();
+
+    _spheres.clear();
+    _bounds.clear();
+    _gatherBounds<QuadComponent>();
+    _gatherBounds<CubeComponent>();
+
+    const std::size_t count = _spheres.size();
+    std::size_t visibleCount = count;
+
+    if (_enabled) {
+        _visible.resize(count);
+        visibleCount = Frustum(viewProjection).cullSpheres(_spheres.data(), count, _visible.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            _bounds[i]->visible = _visible[i] != 0;
+        }
+    } else {
+        for (auto *bounds: _bounds) {
+            bounds->visible = true;
+        }
+    }
+
+    _stats.visible = static_cast<int>(visibleCount);
+    _stats.culled = static_cast<int>(count - visibleCount);
+
+    const std::chrono::duration<float, std::milli> cullTime = std::chrono::high_resolution_clock::now() - cullStart;
+    _stats.cullTimeMs = cullTime.count();
+}
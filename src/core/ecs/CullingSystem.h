@@ -0,0 +1,60 @@
+/**
+ * @file    CullingSystem.h
+ * @brief   Header file for the CullingSystem class
+ * @details The CullingSystem class keeps the world bounds of every quad and cube up to date and flags the ones
+ *          outside the camera frustum, so the render paths can skip them before anything reaches the GL.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef CULLINGSYSTEM_H
+#define CULLINGSYSTEM_H
+
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include "../camera/Frustum.h"
+
+struct BoundsComponent;
+
+class CullingSystem {
+public:
+    // Per-frame numbers, shown in the profile panel
+    struct Stats {
+        int visible = 0;
+        int culled = 0;
+        float cullTimeMs = 0.0f;
+    };
+
+    explicit CullingSystem(entt::registry &registry);
+
+    // Refresh the bounds of every quad and cube and set BoundsComponent::visible against `viewProjection`.
+    // Adds a BoundsComponent to renderables that don't have one yet. Run after TransformSystem::update.
+    void update(const glm::mat4 &viewProjection);
+
+    // When disabled, update() still maintains the bounds but marks everything visible
+    void setEnabled(const bool enabled) { _enabled = enabled; }
+    [[nodiscard]] bool isEnabled() const { return _enabled; }
+
+    [[nodiscard]] const Stats &getStats() const { return _stats; }
+
+private:
+    entt::registry &_registry;
+    bool _enabled = true;
+    Stats _stats;
+
+    // scratch storage reused every frame; _spheres[i] belongs to _bounds[i]
+    std::vector<glm::vec4> _spheres;
+    std::vector<BoundsComponent *> _bounds;
+    std::vector<std::uint8_t> _visible;
+    std::vector<entt::entity> _missing;
+
+    template<typename MeshComponent>
+    void _addMissingBounds();
+
+    template<typename MeshComponent>
+    void _gatherBounds();
+};
+
+#endif //CULLINGSYSTEM_H
@@ -7,13 +7,15 @@
  */
 
 #include "EntityComponentSystem.h"
+#include <array>
+#include <chrono>
 #include <random>
+#include <utility>
 #include "Components.h"
 #include "GameObject.h"
 #include "../locator/Locator.h"
 #include "../../utilities/UUIDGenerator.h"
 #define GLM_ENABLE_EXPERIMENTAL
-#include "../graphic/Lighting.h"
 #include "glm/gtx/string_cast.hpp"
 
 EntityComponentSystem::EntityComponentSystem() = default;
@@ -26,60 +28,182 @@ void EntityComponentSystem::update(float deltaTime) {
 
 
 void EntityComponentSystem::render(const CameraManager &cameraManager) {
+    const auto frameStart = std::chrono::high_resolution_clock::now();
+
     const auto &windowWidth = Locator::window()->getWidth();
     const auto &windowHeight = Locator::window()->getHeight();
+    _cameraSystem.updateViewport(windowWidth, windowHeight);
 
-    const std::shared_ptr<ShaderProgram> meshShader = Locator::shaders().get("mesh_lighting");
-    meshShader->use();
+    // rebuild only the world matrices whose transform changed since the last frame
+    _transformSystem.update();
 
-    _cameraSystem.updateViewport(windowWidth, windowHeight);
-    _cameraSystem.bindActiveCamera(meshShader);
-    const glm::vec3 cameraPosition = _cameraSystem.getActiveCameraPosition();
+    // per-frame data goes into the shared uniform blocks once, whichever shaders draw afterwards
+    _cameraSystem.bindActiveCamera();
+    _lightingSystem.applyAllLights(_cameraSystem.getLastViewMatrix(), _cameraSystem.getLastProjectionMatrix());
+
+    // flag what the camera can't see, both render paths skip those entities
+    _cullingSystem.update(_cameraSystem.getLastProjectionMatrix() * _cameraSystem.getLastViewMatrix());
+
+    if (_instancedRendering) {
+        _renderInstanced();
+    } else {
+        _renderPerEntity();
+    }
 
-    _lightingSystem.applyAllLights(*meshShader, cameraPosition);
+    const std::chrono::duration<float, std::milli> frameTime = std::chrono::high_resolution_clock::now() - frameStart;
+    _renderStats.renderTimeMs = frameTime.count();
+}
+
+const ShaderProgram *EntityComponentSystem::_meshShader(ShaderDefines defines) const {
+    _lightingSystem.addShaderDefines(defines);
+    const std::shared_ptr<ShaderProgram> shader = Locator::shaders().getVariant("mesh_lighting", defines);
+    if (!shader) {
+        return nullptr;
+    }
+
+    _lightingSystem.bindLightData(*shader);
+    if (defines.contains("TEXTURE_ARRAY")) {
+        shader->setInt("textureArraySampler", TextureArrayAllocator::TEXTURE_ARRAY_UNIT);
+    } else if (defines.contains("TEXTURED")) {
+        shader->setInt("textureSampler", 0);
+    }
+    // the manager keeps the variant alive; programs are only replaced by hot reloads, between frames
+    return shader.get();
+}
 
-    for (const auto quadView = _registry.view<QuadComponent, TransformComponent>();
+void EntityComponentSystem::_renderPerEntity() {
+    _renderStats.drawCalls = 0;
+    _renderStats.instances = 0;
+
+    // the cheapest variant per draw: untextured meshes don't sample, and neither compiles in missing lights
+    std::array<const ShaderProgram *, 2> shaders{};
+    std::array<bool, 2> selected{};
+    const auto shaderFor = [&](const bool textured) {
+        if (!selected[textured]) {
+            shaders[textured] = _meshShader(textured ? ShaderDefines{{"TEXTURED", ""}} : ShaderDefines{});
+            selected[textured] = true;
+        }
+        return shaders[textured];
+    };
+
+    for (const auto quadView = _registry.view<QuadComponent, WorldMatrixComponent, BoundsComponent>();
          const auto entity: quadView
     ) {
-        auto &transform = quadView.get<TransformComponent>(entity);
-        auto &quad = quadView.get<QuadComponent>(entity);
+        if (!quadView.get<BoundsComponent>(entity).visible) {
+            continue;
+        }
 
-        quad.mesh.setPosition(transform.position);
-        quad.mesh.setRotation(transform.rotation);
-        quad.mesh.setScale(transform.scale);
+        const auto &world = quadView.get<WorldMatrixComponent>(entity);
+        auto &quad = quadView.get<QuadComponent>(entity);
 
-        if (_registry.any_of<TextureComponent>(entity)) {
-            auto &texture = _registry.get<TextureComponent>(entity);
+        const auto *texture = _registry.try_get<TextureComponent>(entity);
+        const bool textured = texture && texture->texture;
+        if (textured) {
             quad.mesh.setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-            quad.mesh.setTexture(&texture.texture);
+            quad.mesh.setTexture(texture->texture.get());
         } else {
             quad.mesh.clearTexture();
         }
 
-        quad.mesh.draw(*meshShader);
+        const ShaderProgram *shader = shaderFor(textured);
+        if (!shader) {
+            continue;
+        }
+        quad.mesh.draw(*shader, world.matrix);
+        ++_renderStats.drawCalls;
     }
 
-    for (const auto cubeView = _registry.view<CubeComponent, TransformComponent>();
+    for (const auto cubeView = _registry.view<CubeComponent, WorldMatrixComponent, BoundsComponent>();
          const auto entity: cubeView
     ) {
-        auto &transform = cubeView.get<TransformComponent>(entity);
-        auto &cube = cubeView.get<CubeComponent>(entity);
+        if (!cubeView.get<BoundsComponent>(entity).visible) {
+            continue;
+        }
 
-        cube.mesh.setPosition(transform.position);
-        cube.mesh.setRotation(transform.rotation);
-        cube.mesh.setScale(transform.scale);
+        const auto &world = cubeView.get<WorldMatrixComponent>(entity);
+        auto &cube = cubeView.get<CubeComponent>(entity);
 
-        if (_registry.any_of<TextureComponent>(entity)) {
-            auto &texture = _registry.get<TextureComponent>(entity);
+        const auto *texture = _registry.try_get<TextureComponent>(entity);
+        const bool textured = texture && texture->texture;
+        if (textured) {
             // set color white
             cube.mesh.setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-            cube.mesh.setTexture(&texture.texture);
+            cube.mesh.setTexture(texture->texture.get());
         } else {
             cube.mesh.clearTexture();
         }
 
-        cube.mesh.draw(*meshShader);
+        const ShaderProgram *shader = shaderFor(textured);
+        if (!shader) {
+            continue;
+        }
+        cube.mesh.draw(*shader, world.matrix);
+        ++_renderStats.drawCalls;
     }
+
+    _renderStats.instances = _renderStats.drawCalls;
+}
+
+template<typename MeshComponent>
+void EntityComponentSystem::_submitInstanced() {
+    // textured meshes are drawn white, the texture alone gives the color
+    constexpr auto white = glm::vec4(1.0f);
+
+    for (const auto view = _registry.view<MeshComponent, WorldMatrixComponent, BoundsComponent>();
+         const auto entity: view
+    ) {
+        if (!view.template get<BoundsComponent>(entity).visible) {
+            continue;
+        }
+
+        const auto &world = view.template get<WorldMatrixComponent>(entity);
+        const auto &mesh = view.template get<MeshComponent>(entity).mesh;
+
+        auto *texture = _registry.try_get<TextureComponent>(entity);
+        if (!texture || !texture->texture) {
+            _renderQueue.submit(mesh.geometry(), 0, world.matrix, mesh.color);
+            continue;
+        }
+
+        // a placeholder must not be copied into an array, it would stay there after the real image arrives
+        if (_textureArrays && texture->texture->isReady()) {
+            auto &textureArrays = Locator::textureArrays();
+            if (!texture->arrayLayer) {
+                texture->arrayLayer = textureArrays.allocate(*texture->texture);
+            }
+            // textures that failed to load or didn't fit an array keep using their own 2D texture
+            if (const auto &layer = texture->arrayLayer) {
+                _renderQueue.submitLayer(mesh.geometry(), layer->bucket, layer->layer, world.matrix, white);
+                continue;
+            }
+        }
+
+        _renderQueue.submit(mesh.geometry(), texture->texture->getID(), world.matrix, white);
+    }
+}
+
+void EntityComponentSystem::_renderInstanced() {
+    _renderQueue.begin(_cameraSystem.getLastViewMatrix());
+
+    _submitInstanced<QuadComponent>();
+    _submitInstanced<CubeComponent>();
+
+    if (_textureArrays) {
+        Locator::textureArrays().update();
+    }
+
+    _renderQueue.flush([this](const RenderQueue::Surface surface) {
+        ShaderDefines defines{{"INSTANCED", ""}};
+        if (surface == RenderQueue::Surface::TextureArray) {
+            defines["TEXTURE_ARRAY"] = "";
+        } else if (surface == RenderQueue::Surface::Textured) {
+            defines["TEXTURED"] = "";
+        }
+        return _meshShader(std::move(defines));
+    });
+
+    _renderStats.drawCalls = _renderQueue.getDrawCalls();
+    _renderStats.instances = _renderQueue.getInstanceCount();
 }
 
 void EntityComponentSystem::cleanup() {
@@ -88,9 +212,13 @@ void EntityComponentSystem::cleanup() {
 }
 
 GameObject EntityComponentSystem::createGameObject(const std::string &tag) {
+    return createGameObject(tag, UUIDGenerator::generate());
+}
+
+GameObject EntityComponentSystem::createGameObject(const std::string &tag, const std::string &uuid) {
     auto entity = GameObject(_registry.create(), this);
     entity.addComponent<TagComponent>(tag);
-    entity.addComponent<IdComponent>(UUIDGenerator::generate());
+    entity.addComponent<IdComponent>(uuid);
     return entity;
 }
 
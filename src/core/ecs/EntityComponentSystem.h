@@ -13,13 +13,23 @@
 #include "CameraSystem.h"
 #include "../camera/CameraManager.h"
 #include "Components.h"
+#include "CullingSystem.h"
 #include "LightingSystem.h"
+#include "TransformSystem.h"
+#include "../graphic/RenderQueue.h"
 #include "../locator/Locator.h"
 #include "entt/entt.hpp"
 #include "utilities/Logger.h"
 
 class GameObject;
 
+// Per-frame numbers from EntityComponentSystem::render, shown in the profile panel
+struct RenderStats {
+    float renderTimeMs = 0.0f; // CPU time spent submitting the frame
+    int drawCalls = 0;
+    int instances = 0;
+};
+
 class EntityComponentSystem {
 public:
     EntityComponentSystem();
@@ -34,6 +44,9 @@ public:
 
     GameObject createGameObject(const std::string &tag);
 
+    // For entities that already have an identity, e.g. when loading a scene; no uuid is generated
+    GameObject createGameObject(const std::string &tag, const std::string &uuid);
+
     void destroyGameObject(GameObject gameObject);
 
     GameObject getGameObject(const std::string &tag);
@@ -67,6 +80,12 @@ public:
         return _registry.get<Component>(entity);
     }
 
+    // Modify a component in place and notify its observers (e.g. the TransformSystem for TransformComponent)
+    template<typename T, typename... Func>
+    T &patchComponent(const entt::entity entity, Func &&... func) {
+        return _registry.patch<T>(entity, std::forward<Func>(func)...);
+    }
+
     // add component to entity
     template<typename T, typename... Args>
     T &addComponent(const entt::entity entity, Args &&... args) {
@@ -83,11 +102,50 @@ public:
     CameraSystem &getCameraSystem() { return _cameraSystem; }
     const CameraSystem &getCameraSystem() const { return _cameraSystem; }
 
+    const LightingSystem &getLightingSystem() const { return _lightingSystem; }
+
+    const CullingSystem &getCullingSystem() const { return _cullingSystem; }
+
+    const TransformSystem &getTransformSystem() const { return _transformSystem; }
+
+    // Frustum culling is on by default; switching it off submits every quad and cube regardless of the camera
+    void setFrustumCulling(const bool enabled) { _cullingSystem.setEnabled(enabled); }
+    [[nodiscard]] bool isFrustumCulling() const { return _cullingSystem.isEnabled(); }
+
+    // Sorted, instanced submission through the RenderQueue is on by default; switching it off falls back
+    // to one draw per entity in registry order
+    void setInstancedRendering(const bool enabled) { _instancedRendering = enabled; }
+    [[nodiscard]] bool isInstancedRendering() const { return _instancedRendering; }
+
+    // Off by default. When on, the instanced path copies each texture into a texture array layer on first use,
+    // so same-sized textures share a batch instead of splitting it.
+    void setTextureArrays(const bool enabled) { _textureArrays = enabled; }
+    [[nodiscard]] bool isTextureArrays() const { return _textureArrays; }
+
+    [[nodiscard]] const RenderStats &getRenderStats() const { return _renderStats; }
+
 private:
     entt::registry _registry;
+    TransformSystem _transformSystem{_registry};
     CameraSystem _cameraSystem{_registry};
     LightingSystem _lightingSystem{_registry};
+    CullingSystem _cullingSystem{_registry};
+    RenderQueue _renderQueue;
+    bool _instancedRendering = true;
+    bool _textureArrays = false;
+    RenderStats _renderStats;
     friend class GameObject;
+
+    // The mesh_lighting variant for these defines plus the lighting of this frame, with its samplers and light
+    // buffers bound; null if it doesn't build
+    const ShaderProgram *_meshShader(ShaderDefines defines) const;
+
+    void _renderPerEntity();
+
+    void _renderInstanced();
+
+    template<typename MeshComponent>
+    void _submitInstanced();
 };
 
 
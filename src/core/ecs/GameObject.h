@@ -38,6 +38,12 @@ public:
         return _ecs->_registry.get<T>(_entity);
     }
 
+    // Modify a component in place and notify its observers; use this for TransformComponent changes
+    template<typename T, typename... Func>
+    T &patchComponent(Func &&... func) {
+        return _ecs->_registry.patch<T>(_entity, std::forward<Func>(func)...);
+    }
+
     template<typename T>
     bool hasComponent() {
         return _ecs->_registry.any_of<T>(_entity);
@@ -8,12 +8,17 @@
 
 #include "LightingSystem.h"
 #include "Components.h"
-#include "core/graphic/Lighting.h"
 
-LightingSystem::LightingSystem(entt::registry &registry): _registry(registry) {
+LightingSystem::LightingSystem(entt::registry &registry)
+    : _registry(registry),
+      _lightingBuffer(UniformBlockBinding::Lighting, sizeof(LightingBlock)) {
 }
 
-void LightingSystem::applyAllLights(ShaderProgram &shader, const glm::vec3 &cameraPosition) const {
+void LightingSystem::applyAllLights(const glm::mat4 &view, const glm::mat4 &projection) {
+    _block = LightingBlock{};
+    _directionalLight = false;
+    _clusters.clear();
+
     // Apply directional light
     for (auto entity: _registry.view<DirectionalLightComponent>()) {
         const auto &directionalLightComponent = _registry.get<DirectionalLightComponent>(entity);
@@ -21,7 +26,8 @@ void LightingSystem::applyAllLights(ShaderProgram &shader, const glm::vec3 &came
         directionalLight.direction = directionalLightComponent.direction;
         directionalLight.color = directionalLightComponent.color;
         directionalLight.ambient = directionalLightComponent.ambient;
-        Lighting::applyDirectionalLight(shader, directionalLight, cameraPosition);
+        Lighting::applyDirectionalLight(_block, directionalLight);
+        _directionalLight = true;
     }
 
     // Apply point lights
@@ -33,7 +39,7 @@ void LightingSystem::applyAllLights(ShaderProgram &shader, const glm::vec3 &came
         pointLight.constant = pointLightComponent.constant;
         pointLight.linear = pointLightComponent.linear;
         pointLight.quadratic = pointLightComponent.quadratic;
-        Lighting::applyPointLight(shader, pointLight, cameraPosition);
+        _clusters.addPointLight(pointLight);
     }
 
     // Apply spotlights
@@ -50,6 +56,26 @@ void LightingSystem::applyAllLights(ShaderProgram &shader, const glm::vec3 &came
         spotLight.color = spotLightComponent.color;
         spotLight.cutOff = glm::cos(glm::radians(spotLightComponent.cutOff));
         spotLight.outerCutOff = glm::cos(glm::radians(spotLightComponent.outerCutOff));
-        Lighting::applySpotLight(shader, spotLight, cameraPosition);
+        spotLight.range = spotLightComponent.range;
+        _clusters.addSpotLight(spotLight);
+    }
+
+    _clusters.build(view, projection, _block);
+    _lightingBuffer.update(_block);
+}
+
+void LightingSystem::bindLightData(const ShaderProgram &shader) const {
+    // variants without CLUSTERED_LIGHTS don't declare the buffers
+    if (hasClusteredLights()) {
+        _clusters.bind(shader);
+    }
+}
+
+void LightingSystem::addShaderDefines(ShaderDefines &defines) const {
+    if (_directionalLight) {
+        defines["DIRECTIONAL_LIGHT"] = "";
+    }
+    if (hasClusteredLights()) {
+        defines["CLUSTERED_LIGHTS"] = "";
     }
 }
@@ -9,16 +9,34 @@
 #define LIGHTINGSYSTEM_H
 
 #include <entt/entt.hpp>
-#include "core/graphic/ShaderProgram.h"
+#include "core/graphic/ClusteredLighting.h"
+#include "core/graphic/ShaderPreprocessor.h"
+#include "core/graphic/UniformBuffer.h"
 
 class LightingSystem {
 public:
     explicit LightingSystem(entt::registry &registry);
 
-    void applyAllLights(ShaderProgram &shader, const glm::vec3 &cameraPosition) const;
+    // Gather the scene lights for this view: the directional light goes into the "Lighting" uniform block,
+    // point and spot lights are binned into clusters. Uploaded once for all shaders.
+    void applyAllLights(const glm::mat4 &view, const glm::mat4 &projection);
+
+    // Bind the clustered light buffers for `shader` (after applyAllLights); nothing to bind without such lights
+    void bindLightData(const ShaderProgram &shader) const;
+
+    // The lighting this frame has, as mesh_lighting variant defines: DIRECTIONAL_LIGHT and CLUSTERED_LIGHTS
+    void addShaderDefines(ShaderDefines &defines) const;
+
+    [[nodiscard]] bool hasClusteredLights() const { return _clusters.getStats().lights > 0; }
+
+    [[nodiscard]] const ClusteredLighting::Stats &getClusterStats() const { return _clusters.getStats(); }
 
 private:
     entt::registry &_registry;
+    LightingBlock _block;
+    bool _directionalLight = false;
+    UniformBuffer _lightingBuffer;
+    ClusteredLighting _clusters;
 };
 
 #endif //LIGHTINGSYSTEM_H
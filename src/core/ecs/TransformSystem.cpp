@@ -0,0 +1,45 @@
+/**
+ * @file    TransformSystem.cpp
+ * @brief   Implementation file for the TransformSystem class
+ * @details The TransformSystem class keeps a cached WorldMatrixComponent next to every TransformComponent.
+ *          Construction and patches of a transform are observed through entt signals, so only the entities
+ *          that actually changed get their matrix rebuilt.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "TransformSystem.h"
+#include "Components.h"
+
+TransformSystem::TransformSystem(entt::registry &registry)
+    : _registry(registry) {
+    _registry.on_construct<TransformComponent>().connect<&TransformSystem::_markDirty>();
+    _registry.on_update<TransformComponent>().connect<&TransformSystem::_markDirty>();
+}
+
+TransformSystem::~TransformSystem() {
+    _registry.on_construct<TransformComponent>().disconnect<&TransformSystem::_markDirty>();
+    _registry.on_update<TransformComponent>().disconnect<&TransformSystem::_markDirty>();
+}
+
+void TransformSystem::update() {
+    _updatedCount = 0;
+
+    for (const auto view = _registry.view<TransformComponent, TransformDirtyComponent>();
+         const auto entity: view
+    ) {
+        _registry.emplace_or_replace<WorldMatrixComponent>(entity, view.get<TransformComponent>(entity).getMatrix());
+
+        // the world bounds derive from the matrix, let the culling pass rebuild them
+        if (auto *bounds = _registry.try_get<BoundsComponent>(entity)) {
+            bounds->valid = false;
+        }
+        ++_updatedCount;
+    }
+
+    _registry.clear<TransformDirtyComponent>();
+}
+
+void TransformSystem::_markDirty(entt::registry &registry, const entt::entity entity) {
+    registry.emplace_or_replace<TransformDirtyComponent>(entity);
+}
@@ -0,0 +1,39 @@
+/**
+ * @file    TransformSystem.h
+ * @brief   Header file for the TransformSystem class
+ * @details The TransformSystem class keeps a cached WorldMatrixComponent next to every TransformComponent.
+ *          Construction and patches of a transform are observed through entt signals, so only the entities
+ *          that actually changed get their matrix rebuilt.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef TRANSFORMSYSTEM_H
+#define TRANSFORMSYSTEM_H
+
+#include <entt/entt.hpp>
+
+class TransformSystem {
+public:
+    explicit TransformSystem(entt::registry &registry);
+
+    ~TransformSystem();
+
+    TransformSystem(const TransformSystem &) = delete;
+
+    TransformSystem &operator=(const TransformSystem &) = delete;
+
+    // Rebuild the world matrices of the transforms created or patched since the last call
+    void update();
+
+    // Number of world matrices rebuilt by the last update(); zero for a static scene
+    [[nodiscard]] int getUpdatedCount() const { return _updatedCount; }
+
+private:
+    entt::registry &_registry;
+    int _updatedCount = 0;
+
+    static void _markDirty(entt::registry &registry, entt::entity entity);
+};
+
+#endif //TRANSFORMSYSTEM_H
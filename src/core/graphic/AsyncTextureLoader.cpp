@@ -0,0 +1,212 @@
+/**
+ * @file    AsyncTextureLoader.cpp
+ * @brief   Implementation file for the AsyncTextureLoader class.
+ * @details This file contains the implementation of the AsyncTextureLoader class which decodes image files on
+ *          worker threads and uploads them through pixel buffer objects under a per-frame budget.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "AsyncTextureLoader.h"
+#include <algorithm>
+#include <cstring>
+#include <stb_image.h>
+#include "RenderState.h"
+#include "TextureCache.h"
+#include "../../utilities/AssetsManager.h"
+
+void AsyncTextureLoader::StbiDeleter::operator()(unsigned char *pixels) const {
+    stbi_image_free(pixels);
+}
+
+AsyncTextureLoader::AsyncTextureLoader(const unsigned int workerCount)
+    : _workerCount(workerCount) {
+    if (_workerCount == 0) {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        _workerCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u, 1u, 4u);
+    }
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto &worker: _workers) {
+        worker.join();
+    }
+
+    for (const GLuint pbo: _pbos) {
+        if (pbo != 0) {
+            glDeleteBuffers(1, &pbo);
+        }
+    }
+}
+
+void AsyncTextureLoader::load(const ref<Texture> &texture, const std::string &path, Callback onLoaded,
+                              Resolve resolve) {
+    // threads are only started once something is actually loaded asynchronously
+    if (_workers.empty()) {
+        for (unsigned int i = 0; i < _workerCount; ++i) {
+            _workers.emplace_back(&AsyncTextureLoader::_workerLoop, this);
+        }
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _pending.push_back({texture, path, std::move(onLoaded), std::move(resolve), Clock::now()});
+    }
+    _wake.notify_one();
+}
+
+void AsyncTextureLoader::update() {
+    const auto frameStart = Clock::now();
+    _uploadedLastFrame = 0;
+    _uploadedBytesLastFrame = 0;
+
+    while (true) {
+        Decoded decoded;
+        {
+            std::lock_guard lock(_mutex);
+            if (_decoded.empty()) {
+                break;
+            }
+
+            // the first upload of a frame always goes through, however big, so large images can't starve
+            if (_uploadedLastFrame > 0) {
+                const std::chrono::duration<float, std::milli> elapsed = Clock::now() - frameStart;
+                if (_uploadedBytesLastFrame + _decoded.front().byteSize() > _bytesPerFrame ||
+                    elapsed.count() >= _millisecondsPerFrame) {
+                    break;
+                }
+            }
+
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+
+        const auto texture = decoded.job.texture.lock();
+        if (!texture) {
+            continue; // nobody wants it anymore
+        }
+
+        const Result result{
+            decoded.pixels != nullptr, decoded.contentHash, decoded.fileSize, decoded.width, decoded.height
+        };
+        if (!result.succeeded) {
+            LOG_ERROR("Failed to load texture: {}", decoded.job.path);
+            ++_failed;
+            if (decoded.job.onLoaded) {
+                decoded.job.onLoaded(texture, result);
+            }
+            continue;
+        }
+
+        ref<Texture> resident = decoded.job.resolve ? decoded.job.resolve(texture, result) : nullptr;
+        if (resident && resident != texture) {
+            texture->share(std::move(resident)); // the image is already on the GPU, skip the upload
+        } else {
+            _upload(*texture, decoded);
+            ++_uploadedLastFrame;
+            _uploadedBytesLastFrame += decoded.byteSize();
+        }
+
+        const std::chrono::duration<float, std::milli> latency = Clock::now() - decoded.job.requested;
+        ++_completed;
+        _totalLatencyMs += latency.count();
+        _maxLatencyMs = std::max(_maxLatencyMs, latency.count());
+
+        if (decoded.job.onLoaded) {
+            decoded.job.onLoaded(texture, result);
+        }
+    }
+}
+
+void AsyncTextureLoader::setBudget(const GLsizeiptr bytesPerFrame, const float millisecondsPerFrame) {
+    _bytesPerFrame = bytesPerFrame;
+    _millisecondsPerFrame = millisecondsPerFrame;
+}
+
+AsyncTextureLoader::Stats AsyncTextureLoader::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard lock(_mutex);
+        stats.queued = static_cast<int>(_pending.size());
+        stats.awaitingUpload = static_cast<int>(_decoded.size());
+    }
+    stats.uploadedLastFrame = _uploadedLastFrame;
+    stats.uploadedBytesLastFrame = _uploadedBytesLastFrame;
+    stats.completed = _completed;
+    stats.failed = _failed;
+    stats.averageLatencyMs = _completed > 0 ? static_cast<float>(_totalLatencyMs / _completed) : 0.0f;
+    stats.maxLatencyMs = _maxLatencyMs;
+    return stats;
+}
+
+void AsyncTextureLoader::_workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(_mutex);
+            _wake.wait(lock, [this] { return _stopping || !_pending.empty(); });
+            if (_stopping) {
+                return;
+            }
+            job = std::move(_pending.front());
+            _pending.pop_front();
+        }
+
+        // skip the work entirely if the texture was released while queued
+        if (job.texture.expired()) {
+            continue;
+        }
+
+        Decoded decoded = _decode(std::move(job));
+
+        std::lock_guard lock(_mutex);
+        _decoded.push_back(std::move(decoded));
+    }
+}
+
+AsyncTextureLoader::Decoded AsyncTextureLoader::_decode(Job job) {
+    Decoded decoded;
+    decoded.job = std::move(job);
+
+    std::vector<unsigned char> bytes;
+    if (!AssetsManager::Get().readFile(decoded.job.path, bytes)) {
+        return decoded;
+    }
+    decoded.contentHash = TextureCache::hashContent(bytes);
+    decoded.fileSize = bytes.size();
+
+    // decoding keeps no shared state, so workers can decode in parallel
+    decoded.pixels.reset(Texture::decode(bytes.data(), bytes.size(), decoded.width, decoded.height, decoded.channels));
+    return decoded;
+}
+
+void AsyncTextureLoader::_upload(Texture &texture, const Decoded &decoded) {
+    const GLsizeiptr size = decoded.byteSize();
+
+    // round robin over a few buffers so a new upload doesn't wait on the previous transfer
+    GLuint &pbo = _pbos[_nextPbo];
+    _nextPbo = (_nextPbo + 1) % PBO_COUNT;
+    if (pbo == 0) {
+        glGenBuffers(1, &pbo);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW); // orphan the previous contents
+
+    if (void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)) {
+        std::memcpy(mapped, decoded.pixels.get(), static_cast<std::size_t>(size));
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        // with the unpack buffer bound, a null pointer means offset 0 and the copy happens on the GPU's time
+        texture.upload(nullptr, decoded.width, decoded.height, decoded.channels);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        texture.upload(decoded.pixels.get(), decoded.width, decoded.height, decoded.channels);
+    }
+}
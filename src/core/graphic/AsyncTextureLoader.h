@@ -0,0 +1,137 @@
+/**
+ * @file    AsyncTextureLoader.h
+ * @brief   Header file for the AsyncTextureLoader class.
+ * @details This file contains the definition of the AsyncTextureLoader class which reads and decodes image files on
+ *          worker threads. The main thread then uploads the decoded pixels through pixel buffer objects, a few per
+ *          frame under a byte and time budget, so loading a texture-heavy scene never stalls a frame.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef ASYNCTEXTURELOADER_H
+#define ASYNCTEXTURELOADER_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Texture.h"
+#include "../../utilities/SmartPointer.h"
+
+class AsyncTextureLoader {
+public:
+    // What a worker found out about the file
+    struct Result {
+        bool succeeded = false; // false if the file could not be read or decoded
+        std::uint64_t contentHash = 0; // TextureCache::hashContent of the file
+        std::size_t fileSize = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // Called on the main thread before the upload. Returning a live texture that already holds the same image makes
+    // the loading texture share it (Texture::share) instead of uploading a copy; nullptr uploads as usual.
+    using Resolve = std::function<ref<Texture>(const ref<Texture> &texture, const Result &result)>;
+
+    // Called on the main thread once the texture holds the real image, or once the load failed
+    using Callback = std::function<void(const ref<Texture> &texture, const Result &result)>;
+
+    struct Stats {
+        int queued = 0; // waiting for a worker
+        int awaitingUpload = 0; // decoded, waiting for the main thread
+        int uploadedLastFrame = 0;
+        GLsizeiptr uploadedBytesLastFrame = 0;
+        int completed = 0;
+        int failed = 0;
+        float averageLatencyMs = 0.0f; // request to upload, over all completed loads
+        float maxLatencyMs = 0.0f;
+    };
+
+    // `workerCount` 0 picks one less than the hardware threads (at least one, at most four)
+    explicit AsyncTextureLoader(unsigned int workerCount = 0);
+
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+
+    AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+
+    // Decode `path` in the background and upload it into `texture`, which keeps whatever it shows now
+    // (normally a placeholder) until then. Dropping every handle to `texture` cancels the upload.
+    void load(const ref<Texture> &texture, const std::string &path, Callback onLoaded = {}, Resolve resolve = {});
+
+    // Main thread, once per frame: upload decoded images until the budget is spent (always at least one)
+    void update();
+
+    void setBudget(GLsizeiptr bytesPerFrame, float millisecondsPerFrame);
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct StbiDeleter {
+        void operator()(unsigned char *pixels) const;
+    };
+
+    struct Job {
+        std::weak_ptr<Texture> texture;
+        std::string path;
+        Callback onLoaded;
+        Resolve resolve;
+        Clock::time_point requested;
+    };
+
+    struct Decoded {
+        Job job;
+        std::unique_ptr<unsigned char, StbiDeleter> pixels;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::uint64_t contentHash = 0;
+        std::size_t fileSize = 0;
+
+        [[nodiscard]] GLsizeiptr byteSize() const {
+            return static_cast<GLsizeiptr>(width) * height * channels;
+        }
+    };
+
+    static constexpr std::size_t PBO_COUNT = 3;
+
+    unsigned int _workerCount;
+    std::vector<std::thread> _workers;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<Job> _pending;
+    std::deque<Decoded> _decoded;
+    bool _stopping = false;
+
+    // main thread only
+    std::array<GLuint, PBO_COUNT> _pbos{};
+    std::size_t _nextPbo = 0;
+    GLsizeiptr _bytesPerFrame = 8 * 1024 * 1024;
+    float _millisecondsPerFrame = 2.0f;
+    int _uploadedLastFrame = 0;
+    GLsizeiptr _uploadedBytesLastFrame = 0;
+    int _completed = 0;
+    int _failed = 0;
+    double _totalLatencyMs = 0.0;
+    float _maxLatencyMs = 0.0f;
+
+    void _workerLoop();
+
+    static Decoded _decode(Job job);
+
+    void _upload(Texture &texture, const Decoded &decoded);
+};
+
+
+#endif //ASYNCTEXTURELOADER_H
@@ -0,0 +1,250 @@
+/**
+ * @file    ClusteredLighting.cpp
+ * @brief   Implementation file for the ClusteredLighting class.
+ * @details This file contains the implementation of the ClusteredLighting class which bins point and spot lights
+ *          into view-space clusters on the CPU and uploads them as texture buffers for the lighting shaders.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "ClusteredLighting.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include "RenderState.h"
+
+namespace {
+    // A light contributes nothing visible once it is dimmer than one 8-bit color step
+    constexpr float LIGHT_CUTOFF = 256.0f;
+
+    int clampIndex(const int value, const GLuint count) {
+        return std::clamp(value, 0, static_cast<int>(count) - 1);
+    }
+}
+
+ClusteredLighting::ClusteredLighting() : _grid(CLUSTER_COUNT), _cursor(CLUSTER_COUNT) {
+}
+
+ClusteredLighting::~ClusteredLighting() {
+    for (auto *target: {&_lightData, &_lightClusters, &_lightIndices}) {
+        if (target->texture != 0) {
+            RenderState::onTextureDeleted(target->texture);
+            glDeleteTextures(1, &target->texture);
+            glDeleteBuffers(1, &target->buffer);
+        }
+    }
+}
+
+void ClusteredLighting::clear() {
+    _lights.clear();
+}
+
+void ClusteredLighting::addPointLight(const PointLight &light) {
+    ClusterLight &packed = _lights.emplace_back();
+    packed.positionRange = glm::vec4(light.position, pointLightRange(light));
+    packed.colorType = glm::vec4(light.color, 0.0f);
+    packed.directionOuter = glm::vec4(0.0f);
+    packed.attenuationInner = glm::vec4(light.constant, light.linear, light.quadratic, 0.0f);
+}
+
+void ClusteredLighting::addSpotLight(const SpotLight &light) {
+    ClusterLight &packed = _lights.emplace_back();
+    packed.positionRange = glm::vec4(light.position, light.range);
+    packed.colorType = glm::vec4(light.color, 1.0f);
+    packed.directionOuter = glm::vec4(light.direction, light.outerCutOff);
+    // spotlights have no distance attenuation of their own, only the range fade
+    packed.attenuationInner = glm::vec4(1.0f, 0.0f, 0.0f, light.cutOff);
+}
+
+void ClusteredLighting::build(const glm::mat4 &view, const glm::mat4 &projection, LightingBlock &block) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // recover the clip planes from the projection (perspective or orthographic)
+    const bool perspective = projection[2][3] != 0.0f;
+    float zNear = perspective
+                      ? projection[3][2] / (projection[2][2] - 1.0f)
+                      : (projection[3][2] + 1.0f) / projection[2][2];
+    float zFar = perspective
+                     ? projection[3][2] / (projection[2][2] + 1.0f)
+                     : (projection[3][2] - 1.0f) / projection[2][2];
+    zNear = std::max(zNear, 0.01f);
+    zFar = std::max(zFar, zNear * 2.0f);
+
+    // depth slices are exponential: slice = log(depth) * scale + bias
+    const float logRatio = std::log(zFar / zNear);
+    const float sliceScale = static_cast<float>(CLUSTERS_Z) / logRatio;
+    const float sliceBias = -static_cast<float>(CLUSTERS_Z) * std::log(zNear) / logRatio;
+
+    // 1) find the cluster range of every light and count lights per cluster
+    _boxes.clear();
+    _boxLights.clear();
+    std::ranges::fill(_grid, glm::uvec2(0u));
+
+    for (std::uint32_t i = 0; i < _lights.size(); ++i) {
+        const glm::vec4 &positionRange = _lights[i].positionRange;
+        const glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(positionRange), 1.0f));
+
+        ClusterBox box{};
+        if (!_clusterBox(center, positionRange.w, projection, zNear, zFar, sliceScale, sliceBias, box)) {
+            continue;
+        }
+        _boxes.push_back(box);
+        _boxLights.push_back(i);
+
+        for (GLuint z = box.z0; z <= box.z1; ++z) {
+            for (GLuint y = box.y0; y <= box.y1; ++y) {
+                for (GLuint x = box.x0; x <= box.x1; ++x) {
+                    ++_grid[x + CLUSTERS_X * (y + CLUSTERS_Y * z)].y;
+                }
+            }
+        }
+    }
+
+    // 2) prefix sum into offsets, capping crowded clusters
+    GLuint total = 0;
+    GLuint dropped = 0;
+    for (GLuint cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+        const GLuint count = std::min(_grid[cluster].y, MAX_LIGHTS_PER_CLUSTER);
+        dropped += _grid[cluster].y - count;
+        _grid[cluster] = glm::uvec2(total, count);
+        _cursor[cluster] = 0;
+        total += count;
+    }
+
+    // 3) scatter light indices
+    _indices.resize(total);
+    for (std::size_t b = 0; b < _boxes.size(); ++b) {
+        const ClusterBox &box = _boxes[b];
+        for (GLuint z = box.z0; z <= box.z1; ++z) {
+            for (GLuint y = box.y0; y <= box.y1; ++y) {
+                for (GLuint x = box.x0; x <= box.x1; ++x) {
+                    const GLuint cluster = x + CLUSTERS_X * (y + CLUSTERS_Y * z);
+                    if (GLuint &cursor = _cursor[cluster]; cursor < _grid[cluster].y) {
+                        _indices[_grid[cluster].x + cursor++] = _boxLights[b];
+                    }
+                }
+            }
+        }
+    }
+
+    // 4) upload; empty buffers still get one element so the textures stay valid
+    static const glm::vec4 emptyTexel{0.0f};
+    _upload(_lightData, LIGHT_DATA_UNIT, GL_RGBA32F,
+            _lights.empty() ? static_cast<const void *>(&emptyTexel) : _lights.data(),
+            static_cast<GLsizeiptr>(std::max<std::size_t>(_lights.size() * sizeof(ClusterLight), sizeof(emptyTexel))));
+    _upload(_lightClusters, LIGHT_CLUSTERS_UNIT, GL_RG32UI, _grid.data(),
+            static_cast<GLsizeiptr>(_grid.size() * sizeof(glm::uvec2)));
+    static constexpr GLuint emptyIndex = 0;
+    _upload(_lightIndices, LIGHT_INDICES_UNIT, GL_R32UI,
+            _indices.empty() ? &emptyIndex : _indices.data(),
+            static_cast<GLsizeiptr>(std::max<std::size_t>(_indices.size() * sizeof(GLuint), sizeof(emptyIndex))));
+
+    block.clusterDepth = glm::vec4(zNear, zFar, sliceScale, sliceBias);
+    block.clusterCounts = glm::uvec4(CLUSTERS_X, CLUSTERS_Y, CLUSTERS_Z, static_cast<GLuint>(_lights.size()));
+
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    _stats.lights = static_cast<int>(_lights.size());
+    _stats.clusterReferences = static_cast<int>(total);
+    _stats.droppedReferences = static_cast<int>(dropped);
+    _stats.binningTimeMs = elapsed.count();
+}
+
+void ClusteredLighting::bind(const ShaderProgram &shader) const {
+    RenderState::bindTexture(LIGHT_DATA_UNIT, GL_TEXTURE_BUFFER, _lightData.texture);
+    RenderState::bindTexture(LIGHT_CLUSTERS_UNIT, GL_TEXTURE_BUFFER, _lightClusters.texture);
+    RenderState::bindTexture(LIGHT_INDICES_UNIT, GL_TEXTURE_BUFFER, _lightIndices.texture);
+
+    shader.setInt("lightData", LIGHT_DATA_UNIT);
+    shader.setInt("lightClusters", LIGHT_CLUSTERS_UNIT);
+    shader.setInt("lightIndices", LIGHT_INDICES_UNIT);
+}
+
+float ClusteredLighting::pointLightRange(const PointLight &light) {
+    const float brightness = std::max({light.color.r, light.color.g, light.color.b});
+    // solve constant + linear * d + quadratic * d^2 = brightness * LIGHT_CUTOFF for d
+    const float target = brightness * LIGHT_CUTOFF - light.constant;
+    if (target <= 0.0f) {
+        return 0.0f;
+    }
+    if (light.quadratic > 0.0f) {
+        const float discriminant = light.linear * light.linear + 4.0f * light.quadratic * target;
+        return (-light.linear + std::sqrt(discriminant)) / (2.0f * light.quadratic);
+    }
+    if (light.linear > 0.0f) {
+        return target / light.linear;
+    }
+    return std::numeric_limits<float>::max(); // no falloff, lights everything
+}
+
+bool ClusteredLighting::_clusterBox(const glm::vec3 &center, const float radius, const glm::mat4 &projection,
+                                    const float zNear, const float zFar, const float sliceScale,
+                                    const float sliceBias, ClusterBox &box) {
+    if (radius <= 0.0f) {
+        return false;
+    }
+
+    // view space looks down -z, so depth = -z
+    const float depthMin = -center.z - radius;
+    const float depthMax = -center.z + radius;
+    if (depthMax < zNear || depthMin > zFar) {
+        return false;
+    }
+
+    const auto slice = [&](const float depth) {
+        return clampIndex(static_cast<int>(std::floor(std::log(depth) * sliceScale + sliceBias)), CLUSTERS_Z);
+    };
+    box.z0 = static_cast<std::uint8_t>(slice(std::max(depthMin, zNear)));
+    box.z1 = static_cast<std::uint8_t>(slice(std::min(depthMax, zFar)));
+
+    if (depthMin <= zNear) {
+        // the sphere reaches behind the near plane, it can cover any tile
+        box.x0 = 0;
+        box.x1 = CLUSTERS_X - 1;
+        box.y0 = 0;
+        box.y1 = CLUSTERS_Y - 1;
+        return true;
+    }
+
+    // screen rectangle of the sphere's bounding box (all corners are in front of the camera)
+    glm::vec2 ndcMin(std::numeric_limits<float>::max());
+    glm::vec2 ndcMax(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner) {
+        const glm::vec3 offset((corner & 1) ? radius : -radius,
+                               (corner & 2) ? radius : -radius,
+                               (corner & 4) ? radius : -radius);
+        const glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+        const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) {
+        return false;
+    }
+
+    const auto tile = [](const float ndc, const GLuint count) {
+        return clampIndex(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(count))), count);
+    };
+    box.x0 = static_cast<std::uint8_t>(tile(ndcMin.x, CLUSTERS_X));
+    box.x1 = static_cast<std::uint8_t>(tile(ndcMax.x, CLUSTERS_X));
+    box.y0 = static_cast<std::uint8_t>(tile(ndcMin.y, CLUSTERS_Y));
+    box.y1 = static_cast<std::uint8_t>(tile(ndcMax.y, CLUSTERS_Y));
+    return true;
+}
+
+void ClusteredLighting::_upload(TextureBuffer &target, const GLuint unit, const GLenum format, const void *data,
+                                const GLsizeiptr size) {
+    if (target.buffer == 0) {
+        glGenBuffers(1, &target.buffer);
+        glGenTextures(1, &target.texture);
+        glBindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+        glBufferData(GL_TEXTURE_BUFFER, size, data, GL_STREAM_DRAW);
+        RenderState::bindTexture(unit, GL_TEXTURE_BUFFER, target.texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, target.buffer);
+        return;
+    }
+
+    // orphan and refill, the texture keeps pointing at the buffer object
+    glBindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, size, data, GL_STREAM_DRAW);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file    ClusteredLighting.h
+ * @brief   Header file for the ClusteredLighting class.
+ * @details This file contains the definition of the ClusteredLighting class which implements clustered forward
+ *          lighting. Point and spot lights are packed into a texture buffer and binned on the CPU into a grid of
+ *          view-space clusters every frame, so each fragment only evaluates the lights touching its cluster.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef CLUSTEREDLIGHTING_H
+#define CLUSTEREDLIGHTING_H
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "Lighting.h"
+#include "ShaderProgram.h"
+
+// One light as the shader sees it: four RGBA32F texels in the light data buffer
+struct ClusterLight {
+    glm::vec4 positionRange; // xyz: world position, w: range
+    glm::vec4 colorType; // rgb: color, a: 0 = point, 1 = spot
+    glm::vec4 directionOuter; // xyz: spot direction, w: cos(outer cut-off)
+    glm::vec4 attenuationInner; // x: constant, y: linear, z: quadratic, w: cos(inner cut-off)
+};
+
+class ClusteredLighting {
+public:
+    // Cluster grid: screen tiles in x/y, exponential depth slices in z
+    static constexpr GLuint CLUSTERS_X = 16;
+    static constexpr GLuint CLUSTERS_Y = 9;
+    static constexpr GLuint CLUSTERS_Z = 24;
+    static constexpr GLuint CLUSTER_COUNT = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+    static constexpr GLuint MAX_LIGHTS_PER_CLUSTER = 256;
+
+    // Texture units of the light buffers (unit 0 is the material texture)
+    static constexpr GLuint LIGHT_DATA_UNIT = 1;
+    static constexpr GLuint LIGHT_CLUSTERS_UNIT = 2;
+    static constexpr GLuint LIGHT_INDICES_UNIT = 3;
+
+    struct Stats {
+        int lights = 0;
+        int clusterReferences = 0; // light indices written over all clusters
+        int droppedReferences = 0; // light indices left out of clusters that hit MAX_LIGHTS_PER_CLUSTER
+        float binningTimeMs = 0.0f;
+    };
+
+    ClusteredLighting();
+
+    ~ClusteredLighting();
+
+    ClusteredLighting(const ClusteredLighting &) = delete;
+
+    ClusteredLighting &operator=(const ClusteredLighting &) = delete;
+
+    // Drop last frame's lights
+    void clear();
+
+    void addPointLight(const PointLight &light);
+
+    void addSpotLight(const SpotLight &light);
+
+    // Bin the collected lights into the clusters of this view and upload the light buffers.
+    // Writes the cluster parameters the shader needs into `block`.
+    void build(const glm::mat4 &view, const glm::mat4 &projection, LightingBlock &block);
+
+    // Bind the light buffers to their texture units and point the samplers of `shader` at them
+    void bind(const ShaderProgram &shader) const;
+
+    [[nodiscard]] const Stats &getStats() const { return _stats; }
+
+    // Distance at which a point light drops below 1/256 of its brightness (about 88 units with the default
+    // falloff). A cluster holds at most MAX_LIGHTS_PER_CLUSTER lights; the ones past the cap by light index are
+    // left out of it and counted in Stats::droppedReferences.
+    [[nodiscard]] static float pointLightRange(const PointLight &light);
+
+private:
+    struct ClusterBox {
+        std::uint8_t x0, x1, y0, y1, z0, z1;
+    };
+
+    struct TextureBuffer {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+    };
+
+    std::vector<ClusterLight> _lights;
+    std::vector<ClusterBox> _boxes; // one per light, empty lights are culled
+    std::vector<std::uint32_t> _boxLights; // light index of each box
+    std::vector<glm::uvec2> _grid; // per cluster: offset into _indices, light count
+    std::vector<GLuint> _cursor;
+    std::vector<GLuint> _indices;
+
+    TextureBuffer _lightData;
+    TextureBuffer _lightClusters;
+    TextureBuffer _lightIndices;
+
+    Stats _stats;
+
+    // Cluster range touched by a sphere in view space; false when the sphere is outside the view
+    [[nodiscard]] static bool _clusterBox(const glm::vec3 &center, float radius, const glm::mat4 &projection,
+                                          float zNear, float zFar, float sliceScale, float sliceBias,
+                                          ClusterBox &box);
+
+    static void _upload(TextureBuffer &target, GLuint unit, GLenum format, const void *data, GLsizeiptr size);
+};
+
+
+#endif //CLUSTEREDLIGHTING_H
@@ -10,7 +10,6 @@
 #define LIGHTING_H
 
 #include <glm/glm.hpp>
-#include "ShaderProgram.h"
 
 struct DirectionalLight {
     glm::vec3 direction;
@@ -32,34 +31,26 @@ struct SpotLight {
     glm::vec3 color;
     float cutOff = glm::cos(glm::radians(12.5f));
     float outerCutOff = glm::cos(glm::radians(17.5f));
+    float range = 10.0f;
+};
+
+// std140 layout of the "Lighting" uniform block (see UniformBlockBinding::Lighting).
+// Everything is packed into 16 byte vectors so the C++ and GLSL layouts match without padding rules.
+// Point and spot lights are not in here, they live in the ClusteredLighting texture buffers.
+struct LightingBlock {
+    glm::vec4 lightDirection{0.0f, -1.0f, 0.0f, 0.0f}; // xyz: directional light direction
+    glm::vec4 lightColor{0.0f, 0.0f, 0.0f, 32.0f}; // rgb: directional light color, a: shininess
+    glm::vec4 ambientColor{0.0f}; // rgb
+    glm::vec4 clusterDepth{0.1f, 100.0f, 0.0f, 0.0f}; // x: near, y: far, z: slice scale, w: slice bias
+    glm::uvec4 clusterCounts{0u}; // xyz: clusters per axis, w: number of lights
 };
 
 class Lighting {
 public:
-    static void applyDirectionalLight(ShaderProgram &shader, const DirectionalLight &light, const glm::vec3 &viewPos) {
-        shader.setVec3("lightDir", glm::normalize(light.direction));
-        shader.setVec3("lightColor", light.color);
-        shader.setVec3("ambientColor", light.ambient);
-        shader.setFloat("shininess", 32.0f);
-        shader.setVec3("viewPos", viewPos);
-    }
-
-    static void applyPointLight(ShaderProgram &shader, const PointLight &light, const glm::vec3 &viewPos) {
-        shader.setVec3("pointLight.position", light.position);
-        shader.setVec3("pointLight.color", light.color);
-        shader.setFloat("pointLight.constant", light.constant);
-        shader.setFloat("pointLight.linear", light.linear);
-        shader.setFloat("pointLight.quadratic", light.quadratic);
-        shader.setVec3("viewPos", viewPos);
-    }
-
-    static void applySpotLight(ShaderProgram &shader, const SpotLight &light, const glm::vec3 &viewPos) {
-        shader.setVec3("spotLight.position", light.position);
-        shader.setVec3("spotLight.direction", light.direction);
-        shader.setVec3("spotLight.color", light.color);
-        shader.setFloat("spotLight.cutOff", light.cutOff);
-        shader.setFloat("spotLight.outerCutOff", light.outerCutOff);
-        shader.setVec3("viewPos", viewPos);
+    static void applyDirectionalLight(LightingBlock &block, const DirectionalLight &light) {
+        block.lightDirection = glm::vec4(glm::normalize(light.direction), 0.0f);
+        block.lightColor = glm::vec4(light.color, 32.0f);
+        block.ambientColor = glm::vec4(light.ambient, 0.0f);
     }
 };
 
@@ -0,0 +1,207 @@
+/**
+ * @file    ProgramBinaryCache.cpp
+ * @brief   Implementation file for the ProgramBinaryCache class.
+ * @details This file contains the implementation of the ProgramBinaryCache class which stores and restores
+ *          linked shader programs as driver-specific binaries.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "ProgramBinaryCache.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../../utilities/Hash.h"
+#include "../../utilities/Logger.h"
+#include "../../utilities/MappedFile.h"
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace {
+    constexpr char MAGIC[4] = {'C', 'B', 'P', 'B'};
+    constexpr std::uint32_t VERSION = 1;
+
+    struct BinaryHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t driverHash; // guards against key collisions between drivers
+        std::uint32_t format;
+        std::uint32_t length;
+    };
+
+    static_assert(sizeof(BinaryHeader) == 24, "BinaryHeader layout is part of the file format");
+
+    std::string glString(const GLenum name) {
+        const auto *value = reinterpret_cast<const char *>(glGetString(name));
+        return value ? value : "";
+    }
+
+    bool hasExtension(const char *name) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            if (const auto *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+                extension && std::strcmp(extension, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+bool ProgramBinaryCache::initialize(const std::filesystem::path &directory) {
+    _enabled = false;
+
+    const bool core = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+    if (!core && !hasExtension("GL_ARB_get_program_binary")) {
+        LOG_INFO("Program binary cache disabled: the driver has no GL_ARB_get_program_binary");
+        return false;
+    }
+
+    _getProgramBinary = reinterpret_cast<GetProgramBinaryFunction>(SDL_GL_GetProcAddress("glGetProgramBinary"));
+    _programBinary = reinterpret_cast<ProgramBinaryFunction>(SDL_GL_GetProcAddress("glProgramBinary"));
+    _programParameteri = reinterpret_cast<ProgramParameteriFunction>(SDL_GL_GetProcAddress("glProgramParameteri"));
+
+    // some drivers expose the functions but support no format, which makes every stored binary useless
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (!_getProgramBinary || !_programBinary || formats <= 0) {
+        LOG_INFO("Program binary cache disabled: the driver supports no program binary formats");
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        LOG_WARN("Program binary cache disabled: could not create {}: {}", directory.string(), error.message());
+        return false;
+    }
+
+    _directory = directory;
+    _driverHash = Hash::fnv1a(glString(GL_VENDOR));
+    _driverHash = Hash::fnv1a(glString(GL_RENDERER), _driverHash);
+    _driverHash = Hash::fnv1a(glString(GL_VERSION), _driverHash);
+    _enabled = true;
+    LOG_INFO("Program binary cache enabled in {}", directory.string());
+    return true;
+}
+
+std::uint64_t ProgramBinaryCache::makeKey(const std::string &vertexSource, const std::string &fragmentSource) const {
+    // the lengths keep "ab" + "c" and "a" + "bc" apart
+    std::uint64_t key = Hash::fnv1a(vertexSource, _driverHash);
+    key = Hash::fnv1a(fragmentSource, key);
+    const std::uint64_t lengths[] = {vertexSource.size(), fragmentSource.size()};
+    return Hash::fnv1a(lengths, sizeof(lengths), key);
+}
+
+std::filesystem::path ProgramBinaryCache::_pathFor(const std::uint64_t key) const {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return _directory / name;
+}
+
+GLuint ProgramBinaryCache::load(const std::uint64_t key) {
+    if (!_enabled) {
+        return 0;
+    }
+
+    const std::filesystem::path path = _pathFor(key);
+    MappedFile file;
+    if (!std::filesystem::exists(path) || !file.open(path.string())) {
+        ++_stats.misses;
+        return 0;
+    }
+
+    BinaryHeader header{};
+    if (file.size() >= sizeof(header)) {
+        std::memcpy(&header, file.data(), sizeof(header));
+    }
+    const bool valid = file.size() >= sizeof(header) && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+                       && header.version == VERSION && header.driverHash == _driverHash
+                       && header.length == file.size() - sizeof(header);
+
+    GLuint program = 0;
+    GLint linked = GL_FALSE;
+    if (valid) {
+        program = glCreateProgram();
+        _programBinary(program, header.format, file.data() + sizeof(header), static_cast<GLsizei>(header.length));
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+
+    if (linked != GL_TRUE) {
+        if (program != 0) {
+            glDeleteProgram(program);
+        }
+        // the next successful compile stores a fresh binary in its place
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        ++_stats.rejected;
+        return 0;
+    }
+
+    ++_stats.hits;
+    return program;
+}
+
+void ProgramBinaryCache::prepare(const GLuint program) const {
+    if (_enabled && _programParameteri) {
+        _programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ProgramBinaryCache::store(const std::uint64_t key, const GLuint program) {
+    if (!_enabled) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<unsigned char> binary(static_cast<std::size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    _getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+
+    const BinaryHeader header{
+        {MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3]}, VERSION, _driverHash, format, static_cast<std::uint32_t>(written)
+    };
+
+    // written next to the target and renamed over it, so a crash never leaves a truncated binary to load
+    const std::filesystem::path path = _pathFor(key);
+    const std::string tempPath = path.string() + ".tmp";
+    FILE *file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_WARN("Could not write program binary {}", tempPath);
+        return;
+    }
+    const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+                    && std::fwrite(binary.data(), 1, static_cast<std::size_t>(written), file)
+                    == static_cast<std::size_t>(written);
+    std::error_code error;
+    if (std::fclose(file) != 0 || !ok) {
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    ++_stats.stored;
+}
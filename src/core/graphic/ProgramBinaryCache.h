@@ -0,0 +1,66 @@
+/**
+ * @file    ProgramBinaryCache.h
+ * @brief   Header file for the ProgramBinaryCache class.
+ * @details This file contains the definition of the ProgramBinaryCache class which keeps linked shader programs
+ *          on disk through glGetProgramBinary, so later launches skip compiling and linking. Entries are keyed by
+ *          a hash of the final shader sources and the driver's vendor, renderer and version strings; a binary the
+ *          driver rejects anyway (after a driver update, say) is deleted and the program compiled from source.
+ *          The entry points come from GL 4.1 or ARB_get_program_binary and are looked up at runtime, because the
+ *          context is GL 3.3.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef PROGRAMBINARYCACHE_H
+#define PROGRAMBINARYCACHE_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+class ProgramBinaryCache {
+public:
+    struct Stats {
+        int hits = 0;
+        int misses = 0;
+        int rejected = 0; // found on disk but refused by the driver
+        int stored = 0;
+    };
+
+    // Main thread, with a current context. False when the driver can't hand out program binaries; the cache
+    // then stays disabled and every program is compiled as before.
+    bool initialize(const std::filesystem::path &directory);
+
+    [[nodiscard]] bool isEnabled() const { return _enabled; }
+
+    [[nodiscard]] std::uint64_t makeKey(const std::string &vertexSource, const std::string &fragmentSource) const;
+
+    // A linked program for `key`, or 0 when there is none or the driver refused it
+    GLuint load(std::uint64_t key);
+
+    // Call between glCreateProgram and glLinkProgram of a program that will be stored
+    void prepare(GLuint program) const;
+
+    void store(std::uint64_t key, GLuint program);
+
+    [[nodiscard]] Stats getStats() const { return _stats; }
+
+private:
+    using GetProgramBinaryFunction = void (APIENTRY *)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+    using ProgramBinaryFunction = void (APIENTRY *)(GLuint, GLenum, const void *, GLsizei);
+    using ProgramParameteriFunction = void (APIENTRY *)(GLuint, GLenum, GLint);
+
+    bool _enabled = false;
+    std::filesystem::path _directory;
+    std::uint64_t _driverHash = 0;
+    GetProgramBinaryFunction _getProgramBinary = nullptr;
+    ProgramBinaryFunction _programBinary = nullptr;
+    ProgramParameteriFunction _programParameteri = nullptr;
+    Stats _stats;
+
+    [[nodiscard]] std::filesystem::path _pathFor(std::uint64_t key) const;
+};
+
+
+#endif //PROGRAMBINARYCACHE_H
@@ -0,0 +1,216 @@
+/**
+ * @file    RenderQueue.cpp
+ * @brief   Implementation file for the RenderQueue class.
+ * @details This file contains the implementation of the RenderQueue class which sorts draw packets by a packed
+ *          64-bit key and submits them as instanced runs of identical state.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "RenderQueue.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include "RenderState.h"
+#include "TextureArrayAllocator.h"
+#include "../locator/Locator.h"
+
+namespace {
+    constexpr std::uint64_t TRANSLUCENT_BIT = 1ull << 63;
+    constexpr std::uint64_t DEPTH_MASK = 0xFFFFFF;
+    constexpr std::uint64_t ID_MASK = 0xFFFF;
+
+    // 24 bits of a non-negative float; the IEEE bit pattern of positive floats sorts like the value
+    std::uint64_t quantizeDepth(const float depth) {
+        return (std::bit_cast<std::uint32_t>(std::max(depth, 0.0f)) >> 7) & DEPTH_MASK;
+    }
+}
+
+RenderQueue::RenderQueue() = default;
+
+RenderQueue::~RenderQueue() {
+    if (_instanceBuffer != 0) {
+        RenderState::onBufferDeleted(_instanceBuffer);
+        glDeleteBuffers(1, &_instanceBuffer);
+    }
+}
+
+void RenderQueue::begin(const glm::mat4 &view) {
+    _view = view;
+    _packets.clear();
+    _instances.clear();
+    _items.clear();
+    _drawCalls = 0;
+    _instanceCount = 0;
+}
+
+void RenderQueue::submit(const Geometry &geometry, const GLuint texture, const glm::mat4 &model,
+                         const glm::vec4 &color) {
+    const auto index = static_cast<std::uint32_t>(_packets.size());
+    const float depth = -(_view * model[3]).z;
+    const bool translucent = color.a < 1.0f;
+
+    _packets.push_back({&geometry, texture, static_cast<std::uint32_t>(_instances.size()), 0});
+    _instances.push_back({model, color});
+    _items.push_back({makeKey(translucent, texture, geometry.getVAO(), depth), index});
+}
+
+void RenderQueue::submitLayer(const Geometry &geometry, const int bucket, const int layer, const glm::mat4 &model,
+                              const glm::vec4 &color) {
+    const auto index = static_cast<std::uint32_t>(_packets.size());
+    const float depth = -(_view * model[3]).z;
+    const bool translucent = color.a < 1.0f;
+    const auto texture = static_cast<GLuint>(bucket);
+
+    _packets.push_back({&geometry, texture, static_cast<std::uint32_t>(_instances.size()), 1});
+    _instances.push_back({model, color, static_cast<float>(layer)});
+    _items.push_back({makeKey(translucent, texture, geometry.getVAO(), depth), index});
+}
+
+void RenderQueue::flush(const ShaderSelector &shaderFor) {
+    if (_items.empty()) {
+        return;
+    }
+
+    _sort();
+
+    // 1) lay the instance data out in draw order so every run is one contiguous range
+    _staging.clear();
+    for (const auto &[key, packet]: _items) {
+        _staging.push_back(_instances[_packets[packet].transformIndex]);
+    }
+
+    // 2) upload in one go, growing (orphaning) the buffer only when it is too small
+    const auto uploadSize = static_cast<GLsizeiptr>(_staging.size() * sizeof(InstanceData));
+    if (_instanceBuffer == 0) {
+        glGenBuffers(1, &_instanceBuffer);
+    }
+    RenderState::bindArrayBuffer(_instanceBuffer);
+    if (uploadSize > _instanceBufferSize) {
+        _instanceBufferSize = uploadSize + uploadSize / 2;
+        glBufferData(GL_ARRAY_BUFFER, _instanceBufferSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, uploadSize, _staging.data());
+
+    // 3) walk the sorted packets, one instanced draw per run of identical state; the variant for each kind of
+    // surface is only asked for once a run of it comes up
+    std::array<const ShaderProgram *, 3> shaders{};
+    std::array<bool, 3> selected{};
+    RenderState::setBlend(false);
+    RenderState::setDepthMask(true);
+
+    std::size_t runStart = 0;
+    while (runStart < _items.size()) {
+        const DrawPacket &first = _packets[_items[runStart].packet];
+        const bool translucent = (_items[runStart].key & TRANSLUCENT_BIT) != 0;
+
+        std::size_t runEnd = runStart + 1;
+        while (runEnd < _items.size()) {
+            const DrawPacket &next = _packets[_items[runEnd].packet];
+            if (next.geometry != first.geometry || next.texture != first.texture ||
+                next.textureArray != first.textureArray ||
+                ((_items[runEnd].key & TRANSLUCENT_BIT) != 0) != translucent) {
+                break;
+            }
+            ++runEnd;
+        }
+
+        if (translucent) {
+            // blended and without depth writes so translucent surfaces behind each other all show
+            RenderState::setBlend(true);
+            RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            RenderState::setDepthMask(false);
+        }
+
+        const Surface surface = first.textureArray
+                                    ? Surface::TextureArray
+                                    : first.texture != 0
+                                          ? Surface::Textured
+                                          : Surface::Untextured;
+        const auto index = static_cast<std::size_t>(surface);
+        if (!selected[index]) {
+            shaders[index] = shaderFor(surface);
+            selected[index] = true;
+        }
+        // a variant that failed to build skips its draws instead of drawing with the wrong program
+        if (!shaders[index]) {
+            runStart = runEnd;
+            continue;
+        }
+        shaders[index]->use(); // elided by RenderState while the program stays the same
+
+        if (first.textureArray) {
+            const GLuint textureArray = Locator::textureArrays().getTexture(static_cast<int>(first.texture));
+            RenderState::bindTexture(TextureArrayAllocator::TEXTURE_ARRAY_UNIT, GL_TEXTURE_2D_ARRAY, textureArray);
+        } else if (first.texture != 0) {
+            RenderState::bindTexture(0, GL_TEXTURE_2D, first.texture);
+        }
+
+        const auto count = static_cast<GLsizei>(runEnd - runStart);
+        first.geometry->bindInstanced(_instanceBuffer, static_cast<GLintptr>(runStart * sizeof(InstanceData)));
+        first.geometry->drawInstanced(count);
+
+        _instanceCount += count;
+        ++_drawCalls;
+        runStart = runEnd;
+    }
+
+    RenderState::setDepthMask(true);
+}
+
+std::uint64_t RenderQueue::makeKey(const bool translucent, const GLuint texture, const GLuint geometry,
+                                   const float depth) {
+    const std::uint64_t textureBits = texture & ID_MASK;
+    const std::uint64_t geometryBits = geometry & ID_MASK;
+    const std::uint64_t depthBits = quantizeDepth(depth);
+
+    if (!translucent) {
+        return textureBits << 40 | geometryBits << 24 | depthBits;
+    }
+    return TRANSLUCENT_BIT | (DEPTH_MASK - depthBits) << 32 | textureBits << 16 | geometryBits;
+}
+
+void RenderQueue::_sort() {
+    const std::size_t count = _items.size();
+    if (count < 2) {
+        return;
+    }
+
+    // all eight digit histograms in a single read of the keys
+    std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+    for (const auto &item: _items) {
+        for (int digit = 0; digit < 8; ++digit) {
+            ++histograms[digit][(item.key >> (digit * 8)) & 0xFF];
+        }
+    }
+
+    _scratch.resize(count);
+    SortItem *source = _items.data();
+    SortItem *target = _scratch.data();
+
+    for (int digit = 0; digit < 8; ++digit) {
+        const auto &histogram = histograms[digit];
+        const int shift = digit * 8;
+
+        // every key has the same value in this digit, so this pass would not reorder anything
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        std::array<std::uint32_t, 256> offsets{};
+        std::uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            offsets[bucket] = offset;
+            offset += histogram[bucket];
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            target[offsets[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    if (source != _items.data()) {
+        _items.swap(_scratch);
+    }
+}
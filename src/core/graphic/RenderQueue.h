@@ -0,0 +1,103 @@
+/**
+ * @file    RenderQueue.h
+ * @brief   Header file for the RenderQueue class.
+ * @details This file contains the definition of the RenderQueue class which collects compact draw packets,
+ *          sorts them by a packed 64-bit key with a radix sort and submits them in that order. Consecutive
+ *          packets sharing geometry and texture are merged into one instanced draw call.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "ShaderProgram.h"
+#include "../mesh/Geometry.h"
+
+// One queued draw; its sort key is kept separately, next to the packet index, so sorting moves 16 bytes
+struct DrawPacket {
+    const Geometry *geometry;
+    GLuint texture; // 0 means untextured; a TextureArrayAllocator bucket if textureArray is set
+    std::uint32_t transformIndex : 31; // index into the queue's instance data
+    std::uint32_t textureArray : 1; // texture is an array bucket, the layer comes per instance
+};
+
+class RenderQueue {
+public:
+    RenderQueue();
+
+    ~RenderQueue();
+
+    RenderQueue(const RenderQueue &) = delete;
+
+    RenderQueue &operator=(const RenderQueue &) = delete;
+
+    // Start a new frame; `view` is used to compute each packet's depth. Keeps all allocated storage.
+    void begin(const glm::mat4 &view);
+
+    // Queue one draw. A color alpha below 1 makes the packet translucent (blended, drawn back-to-front).
+    void submit(const Geometry &geometry, GLuint texture, const glm::mat4 &model, const glm::vec4 &color);
+
+    // Queue one draw sampling `layer` of a TextureArrayAllocator bucket. Packets sharing the bucket batch together
+    // whatever their layer, so differently textured meshes of the same size can still be one draw call. The
+    // bucket's GL texture is looked up at flush, since a bucket that grows during the frame gets a new one.
+    void submitLayer(const Geometry &geometry, int bucket, int layer, const glm::mat4 &model,
+                     const glm::vec4 &color);
+
+    // What a run of draws samples, which decides its shader variant
+    enum class Surface {
+        Untextured,
+        Textured,
+        TextureArray
+    };
+
+    // The program for one kind of surface, or null to skip those draws; its samplers must already be set
+    using ShaderSelector = std::function<const ShaderProgram *(Surface surface)>;
+
+    // Sort, upload all instance data once and draw every run of identical state with one instanced call. The
+    // selector is called at most once per kind of surface, only for the kinds that are drawn.
+    void flush(const ShaderSelector &shaderFor);
+
+    [[nodiscard]] int getDrawCalls() const { return _drawCalls; }
+    [[nodiscard]] int getInstanceCount() const { return _instanceCount; }
+
+    /**
+     * @brief   Build a sort key.
+     * @details Key layout, most significant bit first:
+     *          - opaque:      [63] 0 | [62..56] layer | [55..40] texture | [39..24] geometry | [23..0] depth
+     *          - translucent: [63] 1 | [62..56] layer | [55..32] inverted depth | [31..16] texture | [15..0] geometry
+     *          Opaque packets are grouped by state and then drawn front-to-back inside each group; translucent
+     *          packets come last, back-to-front. Texture and geometry are truncated GL names (or array buckets),
+     *          they only order packets and never decide what is bound. The layer bits are reserved and currently zero.
+     */
+    [[nodiscard]] static std::uint64_t makeKey(bool translucent, GLuint texture, GLuint geometry, float depth);
+
+private:
+    struct SortItem {
+        std::uint64_t key;
+        std::uint32_t packet;
+    };
+
+    std::vector<DrawPacket> _packets;
+    std::vector<InstanceData> _instances;
+    std::vector<SortItem> _items;
+    std::vector<SortItem> _scratch;
+    std::vector<InstanceData> _staging;
+
+    glm::mat4 _view{1.0f};
+
+    GLuint _instanceBuffer = 0;
+    GLsizeiptr _instanceBufferSize = 0;
+
+    int _drawCalls = 0;
+    int _instanceCount = 0;
+
+    // LSD radix sort of _items by key, 8 bits per pass; passes where every key has the same digit are skipped
+    void _sort();
+};
+
+
+#endif //RENDERQUEUE_H
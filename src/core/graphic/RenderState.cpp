@@ -0,0 +1,152 @@
+/**
+ * @file    RenderState.cpp
+ * @brief   Implementation file for the RenderState class.
+ * @details This file contains the implementation of the RenderState class which shadows the OpenGL binding state
+ *          (program, vertex array, textures, blend and depth) and skips calls that would not change anything.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "RenderState.h"
+
+GLuint RenderState::_program = UNKNOWN;
+GLuint RenderState::_vao = UNKNOWN;
+GLuint RenderState::_arrayBuffer = UNKNOWN;
+GLuint RenderState::_activeUnit = UNKNOWN;
+RenderState::TextureBinding RenderState::_textures[MAX_TEXTURE_UNITS];
+RenderState::Toggle RenderState::_blend = Toggle::Unknown;
+GLenum RenderState::_blendSource = 0;
+GLenum RenderState::_blendDestination = 0;
+RenderState::Toggle RenderState::_depthTest = Toggle::Unknown;
+GLenum RenderState::_depthFunc = 0;
+RenderState::Toggle RenderState::_depthMask = Toggle::Unknown;
+
+RenderState::Stats RenderState::_frame;
+RenderState::Stats RenderState::_lastFrame;
+
+void RenderState::beginFrame() {
+    _lastFrame = _frame;
+    _frame = {};
+    invalidate();
+}
+
+void RenderState::invalidate() {
+    _program = UNKNOWN;
+    _vao = UNKNOWN;
+    _arrayBuffer = UNKNOWN;
+    _activeUnit = UNKNOWN;
+    for (auto &binding: _textures) {
+        binding = {};
+    }
+    _blend = Toggle::Unknown;
+    _blendSource = 0;
+    _blendDestination = 0;
+    _depthTest = Toggle::Unknown;
+    _depthFunc = 0;
+    _depthMask = Toggle::Unknown;
+}
+
+void RenderState::useProgram(const GLuint program) {
+    if (_change(_program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void RenderState::bindVertexArray(const GLuint vao) {
+    if (_change(_vao, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void RenderState::bindArrayBuffer(const GLuint buffer) {
+    if (_change(_arrayBuffer, buffer)) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    }
+}
+
+void RenderState::bindTexture(const GLuint unit, const GLenum target, const GLuint texture) {
+    if (unit >= MAX_TEXTURE_UNITS) {
+        // not tracked, always forward
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        _activeUnit = unit;
+        _frame.issued += 2;
+        return;
+    }
+
+    // callers edit the texture through the active unit right after binding it (glTexSubImage, glGetTexImage, ...),
+    // so `unit` must end up active even when the binding itself is already in place
+    if (_change(_activeUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    TextureBinding &binding = _textures[unit];
+    if (binding.target == target && binding.texture == texture) {
+        ++_frame.elided;
+        return;
+    }
+
+    glBindTexture(target, texture);
+    binding = {target, texture};
+    ++_frame.issued;
+}
+
+void RenderState::setBlend(const bool enabled) {
+    _setToggle(_blend, GL_BLEND, enabled);
+}
+
+void RenderState::setBlendFunc(const GLenum source, const GLenum destination) {
+    if (_blendSource == source && _blendDestination == destination) {
+        ++_frame.elided;
+        return;
+    }
+    _blendSource = source;
+    _blendDestination = destination;
+    glBlendFunc(source, destination);
+    ++_frame.issued;
+}
+
+void RenderState::setDepthTest(const bool enabled) {
+    _setToggle(_depthTest, GL_DEPTH_TEST, enabled);
+}
+
+void RenderState::setDepthFunc(const GLenum func) {
+    if (_change(_depthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void RenderState::setDepthMask(const bool enabled) {
+    if (_change(_depthMask, enabled ? Toggle::On : Toggle::Off)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void RenderState::onProgramDeleted(const GLuint program) {
+    if (_program == program) _program = UNKNOWN;
+}
+
+void RenderState::onVertexArrayDeleted(const GLuint vao) {
+    if (_vao == vao) _vao = UNKNOWN;
+}
+
+void RenderState::onBufferDeleted(const GLuint buffer) {
+    if (_arrayBuffer == buffer) _arrayBuffer = UNKNOWN;
+}
+
+void RenderState::onTextureDeleted(const GLuint texture) {
+    for (auto &binding: _textures) {
+        if (binding.texture == texture) binding = {};
+    }
+}
+
+void RenderState::_setToggle(Toggle &cached, const GLenum capability, const bool enabled) {
+    if (!_change(cached, enabled ? Toggle::On : Toggle::Off)) {
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
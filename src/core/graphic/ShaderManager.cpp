@@ -7,13 +7,60 @@
  */
 
 #include "ShaderManager.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+    std::string normalise(const std::string &path) {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    // compilers report errors as "<source string>(<line>)" or "<source string>:<line>"
+    std::string describeFiles(const std::vector<std::string> &files) {
+        std::string description;
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            description += (i == 0 ? "" : ", ") + std::to_string(i) + ": " + files[i];
+        }
+        return description;
+    }
+
+    bool contains(const std::vector<std::string> &files, const std::string &path) {
+        return std::ranges::find(files, path) != files.end();
+    }
+
+    std::vector<std::string> mergeFiles(const ShaderSource &vertexShader, const ShaderSource &fragmentShader) {
+        std::vector<std::string> files = vertexShader.files;
+        for (const auto &file: fragmentShader.files) {
+            if (!contains(files, file)) {
+                files.push_back(file);
+            }
+        }
+        return files;
+    }
+}
 
 bool ShaderManager::loadFromFile(const std::string &name, const std::string &vertexShaderPath,
                                  const std::string &fragmentShaderPath) {
+    ShaderSource vertexShader;
+    ShaderSource fragmentShader;
+    if (!ShaderPreprocessor::process(vertexShaderPath, {}, vertexShader) ||
+        !ShaderPreprocessor::process(fragmentShaderPath, {}, fragmentShader))
+        return false;
+    return loadPreprocessed(name, vertexShader, fragmentShader);
+}
+
+bool ShaderManager::loadPreprocessed(const std::string &name, const ShaderSource &vertexShader,
+                                     const ShaderSource &fragmentShader) {
     const auto shader = std::make_shared<ShaderProgram>();
-    if (!shader->loadShader(vertexShaderPath, fragmentShaderPath))
+    if (!shader->loadFromSource(vertexShader.text, fragmentShader.text)) {
+        LOG_ERROR("Shader {} failed to build (vertex {}; fragment {})", name, describeFiles(vertexShader.files),
+                  describeFiles(fragmentShader.files));
         return false;
+    }
     _shaders[name] = shader;
+    _sourceFiles[name] = {
+        vertexShader.files.front(), fragmentShader.files.front(), mergeFiles(vertexShader, fragmentShader)
+    };
     return true;
 }
 
@@ -23,9 +70,98 @@ bool ShaderManager::loadFromSource(const std::string &name, const std::string &v
     if (!shader->loadFromSource(vertexShaderSource, fragmentShaderSource))
         return false;
     _shaders[name] = shader;
+    _sourceFiles.erase(name);
     return true;
 }
 
 std::shared_ptr<ShaderProgram> ShaderManager::get(const std::string &name) {
     return _shaders.at(name);
 }
+
+void ShaderManager::addVariants(const std::string &name, const std::string &vertexShaderPath,
+                                const std::string &fragmentShaderPath) {
+    _variantSources[name] = {normalise(vertexShaderPath), normalise(fragmentShaderPath), {}};
+    // built from the new files the next time they are asked for
+    std::erase_if(_variants, [&name](const auto &entry) { return entry.second.name == name; });
+}
+
+std::shared_ptr<ShaderProgram> ShaderManager::getVariant(const std::string &name, const ShaderDefines &defines) {
+    const std::string key = name + "|" + ShaderPreprocessor::makeKey(defines);
+    if (const auto it = _variants.find(key); it != _variants.end()) {
+        return it->second.program;
+    }
+
+    const auto sources = _variantSources.find(name);
+    if (sources == _variantSources.end()) {
+        LOG_ERROR("No shader variants registered as {}", name);
+        return nullptr;
+    }
+
+    Variant variant{name, defines, nullptr, {}};
+    variant.program = _build(sources->second, defines, variant.files);
+    if (variant.program) {
+        LOG_INFO("Compiled shader variant {} [{}]", name, ShaderPreprocessor::makeKey(defines));
+    } else {
+        LOG_ERROR("Shader variant {} [{}] failed to build ({})", name, ShaderPreprocessor::makeKey(defines),
+                  describeFiles(variant.files));
+    }
+    return _variants.emplace(key, std::move(variant)).first->second.program;
+}
+
+int ShaderManager::reloadFile(const std::string &path) {
+    const std::string changed = normalise(path);
+    int reloaded = 0;
+    for (auto &[name, sources]: _sourceFiles) {
+        if (!contains(sources.files, changed)) {
+            continue;
+        }
+        // compiled into a new program first, so a typo in the file doesn't take the old one down with it
+        std::vector<std::string> files;
+        const auto shader = _build(sources, {}, files);
+        if (!shader) {
+            LOG_ERROR("Shader {} failed to reload from {}, keeping the previous version ({})", name, changed,
+                      describeFiles(files));
+            continue;
+        }
+        _shaders[name] = shader;
+        sources.files = std::move(files); // includes may have been added or removed
+        LOG_INFO("Reloaded shader {}", name);
+        ++reloaded;
+    }
+
+    for (auto &[key, variant]: _variants) {
+        if (!contains(variant.files, changed)) {
+            continue;
+        }
+        std::vector<std::string> files;
+        const auto shader = _build(_variantSources.at(variant.name), variant.defines, files);
+        if (!shader) {
+            LOG_ERROR("Shader variant {} failed to reload from {}, keeping the previous version ({})", key, changed,
+                      describeFiles(files));
+            continue;
+        }
+        variant.program = shader;
+        variant.files = std::move(files);
+        LOG_INFO("Reloaded shader variant {}", key);
+        ++reloaded;
+    }
+    return reloaded;
+}
+
+std::shared_ptr<ShaderProgram> ShaderManager::_build(const SourceFiles &sources, const ShaderDefines &defines,
+                                                     std::vector<std::string> &files) {
+    ShaderSource vertexShader;
+    ShaderSource fragmentShader;
+    const bool read = ShaderPreprocessor::process(sources.vertexShaderPath, defines, vertexShader) &&
+                      ShaderPreprocessor::process(sources.fragmentShaderPath, defines, fragmentShader);
+    files = mergeFiles(vertexShader, fragmentShader);
+    if (!read) {
+        return nullptr;
+    }
+
+    const auto shader = std::make_shared<ShaderProgram>();
+    if (!shader->loadFromSource(vertexShader.text, fragmentShader.text)) {
+        return nullptr;
+    }
+    return shader;
+}
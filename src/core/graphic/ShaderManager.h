@@ -8,18 +8,28 @@
 
 #ifndef SHADERMANAGER_H
 #define SHADERMANAGER_H
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "ShaderPreprocessor.h"
 #include "ShaderProgram.h"
 
 class ShaderManager {
 public:
+    // Preprocessed (see ShaderPreprocessor) without defines, so the files may use #include
     bool loadFromFile(const std::string &name,
                       const std::string &vertexShaderPath,
                       const std::string &fragmentShaderPath
     );
 
+    /**
+     * Compiles stages that were already preprocessed, so the file reads can happen on a worker thread while the
+     * GL context is still being created. Every file they were built from is remembered for reloading.
+     */
+    bool loadPreprocessed(const std::string &name, const ShaderSource &vertexShader, const ShaderSource &fragmentShader);
+
     bool loadFromSource(const std::string &name,
                         const std::string &vertexShaderSource,
                         const std::string &fragmentShaderSource
@@ -27,8 +37,46 @@ public:
 
     std::shared_ptr<ShaderProgram> get(const std::string &name);
 
+    // Registers a source pair built into variants by getVariant(); nothing is compiled yet
+    void addVariants(const std::string &name, const std::string &vertexShaderPath,
+                     const std::string &fragmentShaderPath);
+
+    /**
+     * The program built from the sources registered as `name` with these defines. Each combination is compiled
+     * the first time it is asked for and kept; one that fails is logged once and returns null until one of its
+     * files changes.
+     */
+    std::shared_ptr<ShaderProgram> getVariant(const std::string &name, const ShaderDefines &defines);
+
+    [[nodiscard]] int getVariantCount() const { return static_cast<int>(_variants.size()); }
+
+    // Rebuild every program and variant built from `path`, including through #include. A program that no longer
+    // compiles keeps its previous version. Returns how many were replaced; holders of an old pointer keep the old
+    // program alive.
+    int reloadFile(const std::string &path);
+
 private:
+    struct SourceFiles {
+        std::string vertexShaderPath;
+        std::string fragmentShaderPath;
+        std::vector<std::string> files; // both stages and everything they include
+    };
+
+    struct Variant {
+        std::string name;
+        ShaderDefines defines;
+        std::shared_ptr<ShaderProgram> program; // null while it doesn't compile
+        std::vector<std::string> files;
+    };
+
     std::unordered_map<std::string, std::shared_ptr<ShaderProgram> > _shaders;
+    std::unordered_map<std::string, SourceFiles> _sourceFiles; // programs loaded from files, for reloading
+    std::unordered_map<std::string, SourceFiles> _variantSources; // registered with addVariants
+    std::unordered_map<std::string, Variant> _variants; // keyed by name and ShaderPreprocessor::makeKey
+
+    // Preprocesses and compiles both stages; `files` is filled even when that fails
+    static std::shared_ptr<ShaderProgram> _build(const SourceFiles &sources, const ShaderDefines &defines,
+                                                 std::vector<std::string> &files);
 };
 
 
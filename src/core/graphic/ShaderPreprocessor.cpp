@@ -0,0 +1,152 @@
+/**
+ * @file    ShaderPreprocessor.cpp
+ * @brief   ShaderPreprocessor class implementation file
+ * @details Line-based expansion of includes and injection of defines into GLSL sources.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "ShaderPreprocessor.h"
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include "../../utilities/AssetsManager.h"
+#include "../../utilities/Logger.h"
+
+namespace {
+    std::string normalise(const std::filesystem::path &path) {
+        return path.lexically_normal().generic_string();
+    }
+
+    std::string_view trimLeft(std::string_view line) {
+        const auto first = line.find_first_not_of(" \t");
+        return first == std::string_view::npos ? std::string_view{} : line.substr(first);
+    }
+
+    // "#name" followed by whitespace or a quote; "# name" is accepted too, as the C preprocessor does
+    bool isDirective(std::string_view line, const std::string_view name) {
+        line = trimLeft(line);
+        if (line.empty() || line.front() != '#') {
+            return false;
+        }
+        line = trimLeft(line.substr(1));
+        return line.starts_with(name) && (line.size() == name.size() || line[name.size()] == ' ' ||
+                                          line[name.size()] == '\t' || line[name.size()] == '"');
+    }
+
+    void appendLine(std::string &text, const std::size_t line, const std::size_t file) {
+        text += "#line " + std::to_string(line) + " " + std::to_string(file) + "\n";
+    }
+}
+
+bool ShaderPreprocessor::process(const std::string &path, const ShaderDefines &defines, ShaderSource &source) {
+    source.text.clear();
+    source.files.clear();
+    const bool succeeded = _expand(normalise(path), source);
+    if (!defines.empty()) {
+        _insertDefines(defines, source.text);
+    }
+    return succeeded;
+}
+
+std::string ShaderPreprocessor::makeKey(const ShaderDefines &defines) {
+    std::string key;
+    for (const auto &[name, value]: defines) {
+        if (!key.empty()) {
+            key += ';';
+        }
+        key += name;
+        if (!value.empty()) {
+            key += '=' + value;
+        }
+    }
+    return key;
+}
+
+bool ShaderPreprocessor::_expand(const std::string &path, ShaderSource &source) {
+    const std::size_t fileIndex = source.files.size();
+    source.files.push_back(path);
+
+    std::vector<unsigned char> bytes;
+    if (!AssetsManager::Get().readFile(path, bytes)) {
+        LOG_ERROR("Failed to open shader file: {}", path);
+        return false;
+    }
+    const std::string_view text(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+
+    bool succeeded = true;
+    std::size_t lineNumber = 0;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        auto end = text.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        const std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+        ++lineNumber;
+
+        // only the top file keeps its #version, it has to stay the first directive. Lines that are dropped
+        // still leave an empty one behind, so the lines after them keep their numbers.
+        if (fileIndex != 0 && isDirective(line, "version")) {
+            source.text += '\n';
+            continue;
+        }
+        if (!isDirective(line, "include")) {
+            source.text.append(line);
+            source.text += '\n';
+            continue;
+        }
+
+        const auto open = line.find('"');
+        const auto close = open == std::string_view::npos ? open : line.find('"', open + 1);
+        if (close == std::string_view::npos) {
+            LOG_ERROR("Malformed #include in {}({}): {}", path, lineNumber, line);
+            succeeded = false;
+            source.text += '\n';
+            continue;
+        }
+
+        const std::string included = normalise(std::filesystem::path(path).parent_path() /
+                                               std::string(line.substr(open + 1, close - open - 1)));
+        if (std::ranges::find(source.files, included) != source.files.end()) {
+            source.text += '\n';
+            continue;
+        }
+        appendLine(source.text, 1, source.files.size());
+        succeeded = _expand(included, source) && succeeded;
+        appendLine(source.text, lineNumber + 1, fileIndex);
+    }
+    return succeeded;
+}
+
+void ShaderPreprocessor::_insertDefines(const ShaderDefines &defines, std::string &text) {
+    std::string block;
+    for (const auto &[name, value]: defines) {
+        block += "#define " + name;
+        if (!value.empty()) {
+            block += ' ' + value;
+        }
+        block += '\n';
+    }
+
+    // right after #version; includes can't come before it, so its line number is still the top file's own
+    std::size_t lineNumber = 0;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        auto end = text.find('\n', position);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        ++lineNumber;
+        if (isDirective(std::string_view(text).substr(position, end - position), "version")) {
+            appendLine(block, lineNumber + 1, 0);
+            text.insert(std::min(end + 1, text.size()), block);
+            return;
+        }
+        position = end + 1;
+    }
+
+    appendLine(block, 1, 0);
+    text.insert(0, block);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file    ShaderPreprocessor.h
+ * @brief   ShaderPreprocessor class header file
+ * @details Expands `#include "file"` directives and injects `#define`s into GLSL before it is compiled, so one
+ *          source file can be built into several variants (textured or not, instanced or not, which lights are
+ *          evaluated) that only contain the code they need. `#line` directives keep compiler messages pointing at
+ *          the original files: source string N is ShaderSource::files[N].
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef SHADERPREPROCESSOR_H
+#define SHADERPREPROCESSOR_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Defines a variant is compiled with, e.g. {"TEXTURED", ""} or {"MAX_LIGHTS", "8"}; ordered, so equal sets give
+// equal keys whatever order they were written in
+using ShaderDefines = std::map<std::string, std::string>;
+
+// One shader stage after preprocessing
+struct ShaderSource {
+    std::string text;
+    std::vector<std::string> files; // the stage's file first, then everything it includes; normalised paths
+};
+
+class ShaderPreprocessor {
+public:
+    /**
+     * Reads `path` through AssetsManager and expands its includes, relative to the including file. Each file is
+     * included at most once, so include cycles and repeated includes are harmless. The defines go right after the
+     * `#version` line. Needs no GL context, so it may run on any thread.
+     * @return  False if a file could not be read; `source.files` still lists what was reached.
+     */
+    static bool process(const std::string &path, const ShaderDefines &defines, ShaderSource &source);
+
+    // "NAME;NAME=VALUE;..." in define order, empty for no defines
+    static std::string makeKey(const ShaderDefines &defines);
+
+private:
+    // Appends `path` with its includes expanded to source.text
+    static bool _expand(const std::string &path, ShaderSource &source);
+
+    static void _insertDefines(const ShaderDefines &defines, std::string &text);
+};
+
+
+#endif //SHADERPREPROCESSOR_H
@@ -8,10 +8,12 @@
  */
 
 #include "ShaderProgram.h"
+#include "RenderState.h"
+#include "ShaderPreprocessor.h"
+#include "UniformBuffer.h"
+#include "../locator/Locator.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <fstream>
-#include <sstream>
 #include <map>
 
 ShaderProgram::ShaderProgram() : _programID(0) {
@@ -19,43 +21,35 @@ ShaderProgram::ShaderProgram() : _programID(0) {
 
 ShaderProgram::~ShaderProgram() {
     if (_programID != 0) {
+        RenderState::onProgramDeleted(_programID);
         glDeleteProgram(_programID);
     }
 }
 
 bool ShaderProgram::loadShader(const std::string &vertexShaderPath, const std::string &fragmentShaderPath) {
-    std::string vertexShaderSource = _readFile(vertexShaderPath);
-    std::string fragmentShaderSource = _readFile(fragmentShaderPath);
-
-    if (vertexShaderSource.empty() || fragmentShaderSource.empty()) {
-        return false;
-    }
-
-    GLuint vertexShader, fragmentShader;
-
-    // Compile vertex shader
-    if (!_compileShader(vertexShaderSource, GL_VERTEX_SHADER, vertexShader)) {
-        return false;
-    }
-
-    // Compile fragment shader
-    if (!_compileShader(fragmentShaderSource, GL_FRAGMENT_SHADER, fragmentShader)) {
-        return false;
-    }
-
-    // Link shaders
-    if (!_linkProgram(vertexShader, fragmentShader)) {
+    ShaderSource vertexShader;
+    ShaderSource fragmentShader;
+    if (!ShaderPreprocessor::process(vertexShaderPath, {}, vertexShader) ||
+        !ShaderPreprocessor::process(fragmentShaderPath, {}, fragmentShader)) {
         return false;
     }
 
-    // Delete shaders
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return true;
+    // failed compiles are routine while shaders are hot reloaded, and loadFromSource cleans up after them
+    return loadFromSource(vertexShader.text, fragmentShader.text);
 }
 
 bool ShaderProgram::loadFromSource(const std::string &vertexShaderSource, const std::string &fragmentShaderSource) {
+    // a binary stored by an earlier run skips compiling and linking altogether
+    ProgramBinaryCache *cache = Locator::programBinaries();
+    const std::uint64_t cacheKey = cache ? cache->makeKey(vertexShaderSource, fragmentShaderSource) : 0;
+    if (cache) {
+        if (const GLuint program = cache->load(cacheKey); program != 0) {
+            _programID = program;
+            UniformBuffer::bindBlocks(_programID);
+            return true;
+        }
+    }
+
     GLuint vertexShader = 0, fragmentShader = 0;
 
     // Compile the vertex shader
@@ -82,12 +76,16 @@ bool ShaderProgram::loadFromSource(const std::string &vertexShaderSource, const
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    if (cache) {
+        cache->store(cacheKey, _programID);
+    }
+
     return true;
 }
 
 void ShaderProgram::use() const {
     if (_programID != 0) {
-        glUseProgram(_programID);
+        RenderState::useProgram(_programID);
     }
 }
 
@@ -95,19 +93,20 @@ GLuint ShaderProgram::getProgramID() const {
     return _programID;
 }
 
-void ShaderProgram::setMat4(const std::string &uniformName, const glm::mat4 &matrix) const {
-    // make sure the shader is in use
-    glUseProgram(_programID);
-
-    // get the location (you might cache this if you’re performance-sensitive)
-    GLint loc = glGetUniformLocation(_programID, uniformName.c_str());
-    if (loc == -1) {
-        // optionally, log a warning: uniform not found
-        return;
+bool ShaderProgram::hasUniform(const std::string &name) const {
+    const auto it = _uniformCache.find(name);
+    if (it != _uniformCache.end()) {
+        return it->second != -1;
     }
+    const GLint location = glGetUniformLocation(_programID, name.c_str());
+    _uniformCache[name] = location;
+    return location != -1;
+}
 
+void ShaderProgram::setMat4(const std::string &uniformName, const glm::mat4 &matrix) const {
+    use();
     // upload the matrix (column-major by default)
-    glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(matrix));
+    glUniformMatrix4fv(_getUniformLocation(uniformName), 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
 void ShaderProgram::setVec2(const std::string &name, const glm::vec2 &value) const {
@@ -194,6 +193,9 @@ void ShaderProgram::_checkCompileErrors(GLuint shader, std::string type) {
 
 bool ShaderProgram::_linkProgram(GLuint vertexShader, GLuint fragmentShader) {
     _programID = glCreateProgram();
+    if (ProgramBinaryCache *cache = Locator::programBinaries()) {
+        cache->prepare(_programID);
+    }
     glAttachShader(_programID, vertexShader);
     glAttachShader(_programID, fragmentShader);
     glLinkProgram(_programID);
@@ -202,22 +204,14 @@ bool ShaderProgram::_linkProgram(GLuint vertexShader, GLuint fragmentShader) {
     GLint success;
     glGetProgramiv(_programID, GL_LINK_STATUS, &success);
     if (!success) {
+        RenderState::onProgramDeleted(_programID);
         glDeleteProgram(_programID);
         _programID = 0;
         return false;
     }
 
-    return true;
-}
-
-std::string ShaderProgram::_readFile(const std::string &filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        LOG_ERROR("Failed to open file: {}", filePath);
-        return "";
-    }
+    // camera/lighting blocks live at fixed binding points shared by every program
+    UniformBuffer::bindBlocks(_programID);
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    return true;
 }
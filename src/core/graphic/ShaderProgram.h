@@ -20,6 +20,7 @@ public:
 
     ~ShaderProgram();
 
+    // Both files go through ShaderPreprocessor, so they may use #include
     bool loadShader(const std::string &vertexShaderPath, const std::string &fragmentShaderPath);
 
     /**
@@ -38,6 +39,9 @@ public:
 
     [[nodiscard]] GLuint getProgramID() const;
 
+    // Whether the linked program uses `name`; unlike the setters, a missing uniform isn't logged
+    [[nodiscard]] bool hasUniform(const std::string &name) const;
+
     void setMat4(const std::string &uniformName, const glm::mat4 &matrix) const;
 
     void setVec2(const std::string &name, const glm::vec2 &value) const;
@@ -63,8 +67,6 @@ private:
     bool _linkProgram(GLuint vertexShader, GLuint fragmentShader);
 
     static void _checkCompileErrors(GLuint shader, std::string type);
-
-    static std::string _readFile(const std::string &filePath);
 }; // class ShaderProgram
 
 #endif // CBIT_SHADERPROGRAM_H
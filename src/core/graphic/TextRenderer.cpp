@@ -7,130 +7,156 @@
  */
 
 #include "TextRenderer.h"
+#include "RenderState.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <SDL2/SDL.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include "../../utilities/Logger.h"
 
 #include "SDL2/SDL_ttf.h"
 
+// ImGui compiles its copy of stb_rect_pack as static, so this file gets its own
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../../imgui/imstb_rectpack.h"
+
+namespace {
+    constexpr int ATLAS_SIZE = 1024; // single channel, 1 MB
+    constexpr int GLYPH_PADDING = 1; // empty texels around each glyph so linear filtering doesn't pick up neighbours
+    constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    // Decodes the code point starting at text[position] and moves past it; malformed input decodes to U+FFFD
+    char32_t nextCodepoint(const std::string_view text, std::size_t &position) {
+        const auto lead = static_cast<unsigned char>(text[position++]);
+        if (lead < 0x80) {
+            return lead;
+        }
+
+        int length = 0;
+        char32_t codepoint = 0;
+        if ((lead & 0xE0) == 0xC0) {
+            length = 1;
+            codepoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 2;
+            codepoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 3;
+            codepoint = lead & 0x07;
+        } else {
+            return REPLACEMENT_CHARACTER;
+        }
+
+        for (int i = 0; i < length; ++i) {
+            if (position >= text.size() || (static_cast<unsigned char>(text[position]) & 0xC0) != 0x80) {
+                return REPLACEMENT_CHARACTER;
+            }
+            codepoint = codepoint << 6 | (static_cast<unsigned char>(text[position++]) & 0x3F);
+        }
+
+        // overlong encodings, UTF-16 surrogates and values past the last code point
+        constexpr char32_t smallest[] = {0, 0x80, 0x800, 0x10000};
+        if (codepoint < smallest[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            return REPLACEMENT_CHARACTER;
+        }
+        return codepoint;
+    }
+}
+
+struct TextRenderer::AtlasPacker {
+    stbrp_context context{};
+    std::vector<stbrp_node> nodes = std::vector<stbrp_node>(ATLAS_SIZE);
+};
+
 TextRenderer::TextRenderer(
     const unsigned int screenWidth,
     const unsigned int screenHeight): _vao(0),
                                       _vbo(0),
+                                      _atlas(0),
+                                      _packer(std::make_unique<AtlasPacker>()),
+                                      _projectionLocation(-1),
                                       _projection(1.0f) {
     // 1) Compile & configure shader
     _textShader.loadShader("resources/shaders/text.vert",
                            "resources/shaders/text.frag");
     _textShader.use();
+    _projectionLocation = glGetUniformLocation(_textShader.getProgramID(), "projection");
     _projection = glm::ortho(0.0f, static_cast<float>(screenWidth),
                              0.0f, static_cast<float>(screenHeight));
     // set it once
-    glUniformMatrix4fv(
-        glGetUniformLocation(_textShader.getProgramID(), "projection"),
-        1, GL_FALSE, &_projection[0][0]
-    );
+    glUniformMatrix4fv(_projectionLocation, 1, GL_FALSE, &_projection[0][0]);
     glUniform1i(
         glGetUniformLocation(_textShader.getProgramID(), "text"),
         0
     );
 
-    // 2) Configure _vao/_vbo for texture quads
+    // 2) Configure _vao/_vbo for the batched glyph quads; the store is allocated by flush()
     glGenVertexArrays(1, &_vao);
     glGenBuffers(1, &_vbo);
-    glBindVertexArray(_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    // 6 vertices × 4 floats (x,y, u,v)
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+    RenderState::bindVertexArray(_vao);
+    RenderState::bindArrayBuffer(_vbo);
+    // (x,y, u,v) then (r,g,b,a)
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(offsetof(Vertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(offsetof(Vertex, color)));
+
+    // 3) Empty glyph atlas, coverage only
+    const std::vector<unsigned char> empty(static_cast<std::size_t>(ATLAS_SIZE) * ATLAS_SIZE, 0);
+    glGenTextures(1, &_atlas);
+    RenderState::bindTexture(0, GL_TEXTURE_2D, _atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    _resetAtlas();
+
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 TextRenderer::~TextRenderer() {
-    // Delete glyph textures
-    for (auto &pair: _characters) {
-        glDeleteTextures(1, &pair.second.TextureID);
+    // TTF_Quit already released every open font
+    if (_font && TTF_WasInit()) {
+        TTF_CloseFont(_font);
     }
+    RenderState::onTextureDeleted(_atlas);
+    RenderState::onVertexArrayDeleted(_vao);
+    RenderState::onBufferDeleted(_vbo);
+    glDeleteTextures(1, &_atlas);
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
 }
 
 bool TextRenderer::loadFont(const std::string &fontPath,
                             const unsigned int fontSize) {
-    _font = TTF_OpenFont(fontPath.c_str(), static_cast<int>(fontSize));
-    if (!_font) return false;
-
-    // Record the line-skip (baseline-to-baseline) for this font
-    _lineSkip = TTF_FontLineSkip(_font);
+    TTF_Font *font = TTF_OpenFont(fontPath.c_str(), static_cast<int>(fontSize));
+    if (!font) return false;
 
-    // Load first 128 ASCII _characters
-    for (unsigned char c = 0; c < 128; ++c) {
-        // render glyph to SDL_Surface
-        constexpr SDL_Color white = {255, 255, 255, 255};
-        SDL_Surface *surf = TTF_RenderGlyph_Blended(_font, c, white);
-        if (!surf) continue;
-
-        // convert to RGBA8888
-        SDL_Surface *conv = SDL_ConvertSurfaceFormat(
-            surf, SDL_PIXELFORMAT_RGBA8888, 0
-        );
-        SDL_FreeSurface(surf);
-
-        // generate OpenGL texture
-        GLuint tex;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RGBA,
-            conv->w,
-            conv->h,
-            0,
-            GL_RGBA,
-            GL_UNSIGNED_BYTE,
-            conv->pixels
-        );
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
-                        GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
-                        GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-
-        // get metrics
-        int minx, maxx, miny, maxy, advance;
-        TTF_GlyphMetrics(_font, c,
-                         &minx, &maxx,
-                         &miny, &maxy,
-                         &advance);
-
-        // store character
-        Character chr = {
-            tex,
-            {conv->w, conv->h},
-            {minx, maxy},
-            static_cast<GLuint>(advance)
-        };
-        _characters.insert({static_cast<char>(c), chr});
-        SDL_FreeSurface(conv);
+    // queued text still points into the old font's glyphs
+    flush();
+    if (_font) {
+        TTF_CloseFont(_font);
     }
+    _font = font;
+    _resetAtlas();
 
-    TTF_CloseFont(_font);
+    // Record the line-skip (baseline-to-baseline) for this font
+    _lineSkip = TTF_FontLineSkip(_font);
     return true;
 }
 
-float TextRenderer::getTextWidth(const std::string &text, const float scale) const {
+float TextRenderer::getTextWidth(const std::string &text, const float scale) {
     float width = 0.0f;
-    for (auto c: text) {
-        if (auto it = _characters.find(c); it != _characters.end()) {
-            width += static_cast<float>(it->second.Advance) * scale;
-        }
+    for (std::size_t position = 0; position < text.size();) {
+        width += static_cast<float>(_getCharacter(nextCodepoint(text, position)).Advance) * scale;
     }
     return width;
 }
@@ -143,115 +169,54 @@ void TextRenderer::renderText(const std::string &text,
                               float x, const float y,
                               const float scale,
                               const glm::vec3 &color) {
+    for (std::size_t position = 0; position < text.size();) {
+        const Character &character = _getCharacter(nextCodepoint(text, position));
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    _textShader.use();
-    glUniform3f(
-        glGetUniformLocation(_textShader.getProgramID(), "textColor"),
-        color.x, color.y, color.z
-    );
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(_vao);
-
-    // iterate through _characters
-    for (auto c: text) {
-        auto &[TextureID, Size, Bearing, Advance] = _characters[c];
-
-        const float xpos = x + static_cast<float>(Bearing.x) * scale;
-        const float yPositon = y - static_cast<float>(Size.y - Bearing.y) * scale;
-        const float w = static_cast<float>(Size.x) * scale;
-        const float h = static_cast<float>(Size.y) * scale;
-
-        // update _vbo for each character
-        const float vertices[6][4] = {
-            {xpos, yPositon + h, 0.0f, 0.0f},
-            {xpos, yPositon, 0.0f, 1.0f},
-            {xpos + w, yPositon, 1.0f, 1.0f},
-
-            {xpos, yPositon + h, 0.0f, 0.0f},
-            {xpos + w, yPositon, 1.0f, 1.0f},
-            {xpos + w, yPositon + h, 1.0f, 0.0f}
-        };
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, TextureID);
-        // update content of _vbo memory
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0,
-                        sizeof(vertices),
-                        vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // draw quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        const float xpos = x + static_cast<float>(character.Bearing.x) * scale;
+        const float yPositon = y - static_cast<float>(character.Size.y - character.Bearing.y) * scale;
+        _appendQuad(character, xpos, yPositon, scale, glm::vec4(color, 1.0f));
 
         // advance cursors for next glyph
-        x += static_cast<float>(Advance) * scale;
+        x += static_cast<float>(character.Advance) * scale;
     }
-
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-// … your existing includes, ctor, loadFont …
-
 void TextRenderer::renderTextTopAligned(const std::string &text,
                                         float x, const float yTop,
                                         const float scale,
                                         const glm::vec3 &color) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    _textShader.use();
-    glUniform3f(glGetUniformLocation(_textShader.getProgramID(), "textColor"),
-                color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(_vao);
-
-    // 1) find the tallest bearing in this string
-    // float maxBearing = calcMaxBearing(text);
-
-    // 2) for each glyph, compute its quad so its top = yTop
-    for (auto c: text) {
-        auto &[TextureID, Size, Bearing, Advance] = _characters[c];
+    for (std::size_t position = 0; position < text.size();) {
+        const Character &character = _getCharacter(nextCodepoint(text, position));
 
         // xpos as usual: account for left-side bearing
-        const float xpos = x + static_cast<float>(Bearing.x) * scale;
-        // ypos: we want the glyph’s *top* (baseline + Bearing.y*scale) == yTop
-        // so baselineY = yTop - Bearing.y*scale,
-        // but our quad uses yPositon = baselineY - (Size.y - Bearing.y)*scale
-        // Instead derive quad top at ypos+h == yTop:
-        const float yPosition = yTop - static_cast<float>(Size.y) * scale;
-
-        const float w = static_cast<float>(Size.x) * scale;
-        const float h = static_cast<float>(Size.y) * scale;
-
-        // now build 6 vertices with (xpos,ypos) as *bottom‑left* of the quad:
-        const float vertices[6][4] = {
-            // x        y        u    v
-            {xpos, yPosition + h, 0.0f, 0.0f}, // top-left
-            {xpos, yPosition, 0.0f, 1.0f}, // bottom-left
-            {xpos + w, yPosition, 1.0f, 1.0f}, // bottom-right
-
-            {xpos, yPosition + h, 0.0f, 0.0f}, // top-left
-            {xpos + w, yPosition, 1.0f, 1.0f}, // bottom-right
-            {xpos + w, yPosition + h, 1.0f, 0.0f} // top-right
-        };
-
-        // render as before
-        glBindTexture(GL_TEXTURE_2D, TextureID);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        const float xpos = x + static_cast<float>(character.Bearing.x) * scale;
+        // the quad's top sits at yTop, so its bottom is one glyph height below
+        const float yPosition = yTop - static_cast<float>(character.Size.y) * scale;
+        _appendQuad(character, xpos, yPosition, scale, glm::vec4(color, 1.0f));
 
         // advance cursor horizontally
-        x += static_cast<float>(Advance) * scale;
+        x += static_cast<float>(character.Advance) * scale;
+    }
+}
+
+void TextRenderer::flush() {
+    if (_vertices.empty()) {
+        return;
     }
 
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    RenderState::setBlend(true);
+    RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    _textShader.use();
+    RenderState::bindVertexArray(_vao);
+    RenderState::bindArrayBuffer(_vbo);
+    RenderState::bindTexture(0, GL_TEXTURE_2D, _atlas);
+
+    // a fresh store every flush, so the driver never waits for the previous draw to finish reading the old one
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(_vertices.size() * sizeof(Vertex)), _vertices.data(),
+                 GL_STREAM_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(_vertices.size()));
+    _vertices.clear();
 }
 
 void TextRenderer::onResize(const unsigned int screenWidth, const unsigned int screenHeight) {
@@ -261,8 +226,111 @@ void TextRenderer::onResize(const unsigned int screenWidth, const unsigned int s
 
     // set the new projection matrix in the shader
     _textShader.use();
-    glUniformMatrix4fv(
-        glGetUniformLocation(_textShader.getProgramID(), "projection"),
-        1, GL_FALSE, &_projection[0][0]
-    );
+    glUniformMatrix4fv(_projectionLocation, 1, GL_FALSE, &_projection[0][0]);
+}
+
+const Character &TextRenderer::_getCharacter(const char32_t codepoint) {
+    if (const auto it = _characters.find(codepoint); it != _characters.end()) {
+        return it->second;
+    }
+
+    Character character{};
+    if (!_loadCharacter(codepoint, character)) {
+        // draw what was queued against the full atlas, then start over with only the glyphs still in use
+        LOG_WARN("Text atlas is full, clearing {} cached glyphs", _characters.size());
+        flush();
+        _resetAtlas();
+        if (!_loadCharacter(codepoint, character)) {
+            LOG_WARN("Glyph U+{:04X} does not fit in the text atlas", static_cast<std::uint32_t>(codepoint));
+        }
+    }
+    return _characters.emplace(codepoint, character).first->second;
+}
+
+bool TextRenderer::_loadCharacter(const char32_t codepoint, Character &character) {
+    character = {};
+    if (!_font) {
+        return true;
+    }
+
+    // render glyph to SDL_Surface; fonts without the glyph render their missing-glyph box
+    constexpr SDL_Color white = {255, 255, 255, 255};
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    SDL_Surface *surf = TTF_RenderGlyph32_Blended(_font, codepoint, white);
+    TTF_GlyphMetrics32(_font, codepoint, &minx, &maxx, &miny, &maxy, &advance);
+#else
+    const auto glyph = static_cast<Uint16>(codepoint > 0xFFFF ? REPLACEMENT_CHARACTER : codepoint);
+    SDL_Surface *surf = TTF_RenderGlyph_Blended(_font, glyph, white);
+    TTF_GlyphMetrics(_font, glyph, &minx, &maxx, &miny, &maxy, &advance);
+#endif
+    character.Bearing = {minx, maxy};
+    character.Advance = static_cast<GLuint>(std::max(advance, 0));
+    // control characters and the like have nothing to draw, only an advance
+    if (!surf) {
+        return true;
+    }
+
+    // RGBA32 is byte order R,G,B,A on every platform, the atlas keeps the alpha byte
+    SDL_Surface *conv = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surf);
+    if (!conv) {
+        return true;
+    }
+    if (conv->w == 0 || conv->h == 0) {
+        SDL_FreeSurface(conv);
+        return true;
+    }
+
+    stbrp_rect rect{};
+    rect.w = conv->w + GLYPH_PADDING * 2;
+    rect.h = conv->h + GLYPH_PADDING * 2;
+    if (!stbrp_pack_rects(&_packer->context, &rect, 1)) {
+        SDL_FreeSurface(conv);
+        return false;
+    }
+
+    // uploaded with its padding, so texels left over from glyphs dropped by a reset never bleed in
+    std::vector<unsigned char> coverage(static_cast<std::size_t>(rect.w) * rect.h, 0);
+    for (int row = 0; row < conv->h; ++row) {
+        const auto *source = static_cast<const unsigned char *>(conv->pixels) + row * conv->pitch;
+        unsigned char *target = coverage.data() + (row + GLYPH_PADDING) * rect.w + GLYPH_PADDING;
+        for (int column = 0; column < conv->w; ++column) {
+            target[column] = source[column * 4 + 3];
+        }
+    }
+    RenderState::bindTexture(0, GL_TEXTURE_2D, _atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, GL_RED, GL_UNSIGNED_BYTE, coverage.data());
+
+    character.Size = {conv->w, conv->h};
+    character.UvMin = glm::vec2(rect.x + GLYPH_PADDING, rect.y + GLYPH_PADDING) / static_cast<float>(ATLAS_SIZE);
+    character.UvMax = character.UvMin + glm::vec2(conv->w, conv->h) / static_cast<float>(ATLAS_SIZE);
+    SDL_FreeSurface(conv);
+    return true;
+}
+
+void TextRenderer::_resetAtlas() {
+    _characters.clear();
+    stbrp_init_target(&_packer->context, ATLAS_SIZE, ATLAS_SIZE, _packer->nodes.data(),
+                      static_cast<int>(_packer->nodes.size()));
+}
+
+void TextRenderer::_appendQuad(const Character &character, const float x, const float yBottom, const float scale,
+                               const glm::vec4 &color) {
+    if (character.Size.x == 0 || character.Size.y == 0) {
+        return;
+    }
+
+    const float w = static_cast<float>(character.Size.x) * scale;
+    const float h = static_cast<float>(character.Size.y) * scale;
+    const glm::vec2 &uvMin = character.UvMin;
+    const glm::vec2 &uvMax = character.UvMax;
+
+    // the atlas is stored top row first, so the top of the quad samples UvMin.y
+    const Vertex topLeft{{x, yBottom + h}, {uvMin.x, uvMin.y}, color};
+    const Vertex bottomLeft{{x, yBottom}, {uvMin.x, uvMax.y}, color};
+    const Vertex bottomRight{{x + w, yBottom}, {uvMax.x, uvMax.y}, color};
+    const Vertex topRight{{x + w, yBottom + h}, {uvMax.x, uvMin.y}, color};
+    _vertices.insert(_vertices.end(), {topLeft, bottomLeft, bottomRight, topLeft, bottomRight, topRight});
 }
@@ -1,7 +1,10 @@
 /**
  * @file    TextRenderer.h
- * @brief   Class for rendering text using FreeType and OpenGL.
- * @details This file contains the definition of the TextRenderer class which is responsible for rendering
+ * @brief   Class for rendering text using SDL_ttf and OpenGL.
+ * @details Glyphs are rasterized the first time they are used and packed into a single atlas texture, so any UTF-8
+ *          text can be drawn without loading whole character ranges up front. renderText() and
+ *          renderTextTopAligned() only append quads to a vertex batch; flush() uploads the batch and draws all of
+ *          it in one call.
  * @author  Nur Akmal bin Jalil
  * @date    2025-04-20
  */
@@ -9,8 +12,10 @@
 #ifndef TEXTRENDERER_H
 #define TEXTRENDERER_H
 
-#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "ShaderProgram.h"
 #include "glad/glad.h"
 #include "glm/glm.hpp"
@@ -18,7 +23,8 @@
 
 
 struct Character {
-    GLuint TextureID; // ID handle of the glyph texture
+    glm::vec2 UvMin; // top-left of the glyph in the atlas, 0..1
+    glm::vec2 UvMax; // bottom-right of the glyph in the atlas, 0..1
     glm::ivec2 Size; // Size of glyph
     glm::ivec2 Bearing; // Offset from baseline to left/top of glyph
     GLuint Advance; // Horizontal offset to advance to next glyph
@@ -34,15 +40,14 @@ public:
     // Load a font at given pixel-size. Returns false on failure.
     bool loadFont(const std::string &fontPath, unsigned int fontSize);
 
-    // Render text at (x,y) in pixel coords, scaled by 'scale', tinted by 'color' (0..1 floats).
+    // Queue UTF-8 text at (x,y) in pixel coords, scaled by 'scale', tinted by 'color' (0..1 floats).
     void renderText(const std::string &text,
                     float x, float y,
                     float scale,
                     const glm::vec3 &color);
 
-    // --- NEW API ---
-    // Returns total width of `text` at this scale, using each glyph’s Advance.
-    [[nodiscard]] float getTextWidth(const std::string &text, float scale) const;
+    // Returns total width of UTF-8 `text` at this scale, using each glyph’s Advance.
+    [[nodiscard]] float getTextWidth(const std::string &text, float scale);
 
     // Returns the font's line-skip (baseline-to-baseline distance) in pixels.
     [[nodiscard]] int getLineSkip() const;
@@ -52,28 +57,43 @@ public:
                               float scale,
                               const glm::vec3 &color);
 
+    // Draws everything queued since the last flush in one draw call; call once per frame after the text calls.
+    void flush();
+
     void onResize(unsigned int screenWidth, unsigned int screenHeight);
 
 private:
-    std::map<GLchar, Character> _characters;
+    struct Vertex {
+        glm::vec2 position;
+        glm::vec2 uv;
+        glm::vec4 color;
+    };
+
+    struct AtlasPacker; // stb_rect_pack state, kept out of the header
+
+    std::unordered_map<char32_t, Character> _characters;
+    std::vector<Vertex> _vertices;
     GLuint _vao, _vbo;
+    GLuint _atlas;
+    std::unique_ptr<AtlasPacker> _packer;
     ShaderProgram _textShader;
+    GLint _projectionLocation;
     glm::mat4 _projection;
 
-    // New members:
-    TTF_Font *_font = nullptr; // keep a pointer so we can query metrics
+    TTF_Font *_font = nullptr; // kept open, glyphs are rasterized on demand
     int _lineSkip = 0; // line-height in pixels
 
-    // Compute the maximum Bearing.y (the ascender) over the text.
-    [[nodiscard]] float calcMaxBearing(const std::string &text) const {
-        float mb = 0.0f;
-        for (auto c: text) {
-            if (auto it = _characters.find(c); it != _characters.end()) {
-                mb = std::max(mb, static_cast<float>(it->second.Bearing.y));
-            }
-        }
-        return mb;
-    }
+    // Returns the cached glyph, rasterizing it into the atlas the first time
+    const Character &_getCharacter(char32_t codepoint);
+
+    // Rasterizes a glyph into the atlas; false once the atlas is full
+    bool _loadCharacter(char32_t codepoint, Character &character);
+
+    // Forgets every glyph and starts packing from an empty atlas
+    void _resetAtlas();
+
+    // Appends the two triangles of one glyph, (x, yBottom) is the bottom-left corner of the quad
+    void _appendQuad(const Character &character, float x, float yBottom, float scale, const glm::vec4 &color);
 };
 
 
@@ -9,20 +9,60 @@
  */
 
 #include "Texture.h"
+#include "RenderState.h"
+#include <fstream>
+#include <iterator>
+#include <vector>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 Texture::Texture() : _textureID(0) {}
 
 Texture::~Texture() {
+    RenderState::onTextureDeleted(_textureID);
     glDeleteTextures(1, &_textureID);
 }
 
 bool Texture::loadTexture(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to load texture: {}", path);
+        return false;
+    }
+    const std::vector<unsigned char> bytes(std::istreambuf_iterator<char>(file), {});
+    return loadFromMemory(bytes.data(), bytes.size(), path);
+}
+
+bool Texture::loadFromMemory(const unsigned char *bytes, const std::size_t size, const std::string &name) {
+    int width, height, nrChannels;
+    unsigned char *data = decode(bytes, size, width, height, nrChannels);
+    if (!data) {
+        LOG_ERROR("Failed to load texture: {}", name);
+        return false;
+    }
+    upload(data, width, height, nrChannels);
+    stbi_image_free(data);
+    return true;
+}
+
+unsigned char *Texture::decode(const unsigned char *bytes, const std::size_t size, int &width, int &height,
+                               int &channels) {
+    unsigned char *pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &width, &height, &channels, 0);
+    if (pixels && channels != 3 && channels != 4) {
+        // grey or grey+alpha: decode again expanded to RGBA rather than teach upload() more formats
+        stbi_image_free(pixels);
+        pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &width, &height, &channels, 4);
+        channels = 4;
+    }
+    return pixels;
+}
+
+void Texture::upload(const unsigned char *pixels, const int width, const int height, const int channels) {
+    _shared.reset();
     if (_textureID == 0) {
         glGenTextures(1, &_textureID);
     }
-    glBindTexture(GL_TEXTURE_2D, _textureID);
+    RenderState::bindTexture(0, GL_TEXTURE_2D, _textureID);
 
     // Set the texture wrapping/filtering options
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -30,20 +70,47 @@ bool Texture::loadTexture(const std::string &path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-    if (data) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, nrChannels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE,
-                     data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
-        LOG_ERROR("Failed to load texture: {}", path);
-        return false;
+    // rows of RGB images are not 4-byte aligned unless the width happens to be a multiple of 4
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, channels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE,
+                 pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    _width = width;
+    _height = height;
+    _ready = true;
+}
+
+void Texture::createPlaceholder() {
+    // 2x2 grey checkerboard, tiled by the REPEAT wrap mode
+    constexpr unsigned char pixels[] = {
+        96, 96, 96, 160, 160, 160,
+        160, 160, 160, 96, 96, 96,
+    };
+    upload(pixels, 2, 2, 3);
+    _ready = false;
+}
+
+void Texture::share(ref<Texture> source) {
+    // always point at the texture that owns the image, never at another shared one
+    while (source->_shared) {
+        source = source->_shared;
     }
-    stbi_image_free(data);
-    return true;
+    if (source.get() == this) {
+        return;
+    }
+
+    if (_textureID != 0) {
+        RenderState::onTextureDeleted(_textureID);
+        glDeleteTextures(1, &_textureID);
+        _textureID = 0;
+    }
+    _width = 0;
+    _height = 0;
+    _ready = false;
+    _shared = std::move(source);
 }
 
-void Texture::bind() const {
-    glBindTexture(GL_TEXTURE_2D, _textureID);
+void Texture::bind(const GLuint unit) const {
+    RenderState::bindTexture(unit, GL_TEXTURE_2D, getID());
 }
\ No newline at end of file
@@ -12,9 +12,11 @@
 #define CBIT_TEXTURE_H
 
 #include <glad/glad.h>
+#include <cstddef>
 #include <string>
 
 #include "../../utilities/Logger.h"
+#include "../../utilities/SmartPointer.h"
 
 
 class Texture {
@@ -23,14 +25,56 @@ public:
 
     ~Texture();
 
+    // owns a GL name, so it can't be copied; share it through the TextureCache instead
+    Texture(const Texture &) = delete;
+
+    Texture &operator=(const Texture &) = delete;
+
     bool loadTexture(const std::string &path);
 
-    [[nodiscard]] GLuint getID() const { return _textureID; }
+    // Decode an encoded image (PNG, JPEG, ...) already in memory; `name` is only used for error messages
+    bool loadFromMemory(const unsigned char *bytes, std::size_t size, const std::string &name);
+
+    // Decode an encoded image into 8-bit RGB or RGBA pixels, expanding grey and grey+alpha images to RGBA so the
+    // result can always go to upload(). Returns nullptr on failure; free the pixels with stbi_image_free. Keeps no
+    // shared state, so it may run on any thread.
+    static unsigned char *decode(const unsigned char *bytes, std::size_t size, int &width, int &height, int &channels);
+
+    // Upload decoded 8-bit pixels with 3 or 4 channels and build the mipmaps. As with glTexImage2D, `pixels` is
+    // an offset into the buffer when a GL_PIXEL_UNPACK_BUFFER is bound.
+    void upload(const unsigned char *pixels, int width, int height, int channels);
+
+    // Fill the texture with a small checkerboard to draw until the real image has been uploaded
+    void createPlaceholder();
+
+    // Show the image of `source` instead of one of its own, for a file that turned out to be a copy of one already
+    // loaded. Frees this texture's own GL name; uploading into it again ends the sharing.
+    void share(ref<Texture> source);
+
+    // False while the texture still holds its placeholder (or nothing at all)
+    [[nodiscard]] bool isReady() const { return _shared ? _shared->isReady() : _ready; }
+
+    [[nodiscard]] GLuint getID() const { return _shared ? _shared->getID() : _textureID; }
+
+    [[nodiscard]] int getWidth() const { return _shared ? _shared->getWidth() : _width; }
+    [[nodiscard]] int getHeight() const { return _shared ? _shared->getHeight() : _height; }
+
+    // The texture whose image this one shows, or nullptr if it has its own
+    [[nodiscard]] const ref<Texture> &getShared() const { return _shared; }
+
+    // Approximate video memory used, including the mip chain; a shared texture owns none
+    [[nodiscard]] GLsizeiptr getByteSize() const {
+        return _shared ? 0 : static_cast<GLsizeiptr>(_width) * _height * 4 * 4 / 3;
+    }
 
-    void bind() const;
+    void bind(GLuint unit = 0) const;
 
 private:
     GLuint _textureID;
+    int _width = 0;
+    int _height = 0;
+    bool _ready = false;
+    ref<Texture> _shared;
 };
 
 
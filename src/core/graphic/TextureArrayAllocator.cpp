@@ -0,0 +1,195 @@
+/**
+ * @file    TextureArrayAllocator.cpp
+ * @brief   Implementation file for the TextureArrayAllocator class.
+ * @details This file contains the implementation of the TextureArrayAllocator class which packs textures of
+ *          the same size into the layers of one GL_TEXTURE_2D_ARRAY per size bucket.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "TextureArrayAllocator.h"
+#include <algorithm>
+#include "RenderState.h"
+
+TextureArrayAllocator::TextureArrayAllocator() = default;
+
+TextureArrayAllocator::~TextureArrayAllocator() {
+    for (const auto &bucket: _buckets) {
+        if (bucket.texture != 0) {
+            RenderState::onTextureDeleted(bucket.texture);
+            glDeleteTextures(1, &bucket.texture);
+        }
+    }
+    if (_copyFramebuffer != 0) {
+        glDeleteFramebuffers(1, &_copyFramebuffer);
+    }
+}
+
+ref<TextureArrayLayer> TextureArrayAllocator::allocate(const int width, const int height,
+                                                       const unsigned char *pixels) {
+    if (width <= 0 || height <= 0 || pixels == nullptr) {
+        return nullptr;
+    }
+
+    const int bucketIndex = _findBucket(width, height);
+    auto &bucket = _buckets[bucketIndex];
+
+    int layer;
+    if (!bucket.freeLayers.empty()) {
+        layer = bucket.freeLayers.back();
+        bucket.freeLayers.pop_back();
+    } else {
+        if (bucket.highWater == bucket.capacity && !_grow(bucket)) {
+            LOG_ERROR("Texture array {}x{} is full ({} layers)", width, height, bucket.capacity);
+            return nullptr;
+        }
+        layer = bucket.highWater++;
+    }
+
+    RenderState::bindTexture(TEXTURE_ARRAY_UNIT, GL_TEXTURE_2D_ARRAY, bucket.texture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    bucket.mipmapsDirty = true;
+
+    return ref<TextureArrayLayer>(new TextureArrayLayer{bucketIndex, layer}, [this](const TextureArrayLayer *slot) {
+        _release(slot->bucket, slot->layer);
+        delete slot;
+    });
+}
+
+ref<TextureArrayLayer> TextureArrayAllocator::allocate(const Texture &texture) {
+    if (texture.getID() == 0 || texture.getWidth() <= 0 || texture.getHeight() <= 0) {
+        return nullptr;
+    }
+
+    auto &slot = _byTexture[texture.getID()];
+    if (auto layer = slot.lock()) {
+        return layer;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(texture.getWidth()) * texture.getHeight() * 4);
+    RenderState::bindTexture(0, GL_TEXTURE_2D, texture.getID());
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    auto layer = allocate(texture.getWidth(), texture.getHeight(), pixels.data());
+    slot = layer;
+    return layer;
+}
+
+void TextureArrayAllocator::refresh(const Texture &texture) {
+    const auto slot = _byTexture.find(texture.getID());
+    if (slot == _byTexture.end()) {
+        return;
+    }
+    const auto layer = slot->second.lock();
+    if (!layer) {
+        _byTexture.erase(slot);
+        return;
+    }
+
+    auto &bucket = _buckets[layer->bucket];
+    if (bucket.width != texture.getWidth() || bucket.height != texture.getHeight()) {
+        LOG_WARN("Texture {} changed size, its texture array copy stays stale until it is loaded again",
+                 texture.getID());
+        _byTexture.erase(slot);
+        return;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(bucket.width) * bucket.height * 4);
+    RenderState::bindTexture(0, GL_TEXTURE_2D, texture.getID());
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    RenderState::bindTexture(TEXTURE_ARRAY_UNIT, GL_TEXTURE_2D_ARRAY, bucket.texture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer->layer, bucket.width, bucket.height, 1, GL_RGBA,
+                    GL_UNSIGNED_BYTE, pixels.data());
+    bucket.mipmapsDirty = true;
+}
+
+GLuint TextureArrayAllocator::getTexture(const int bucket) const {
+    return _buckets[bucket].texture;
+}
+
+void TextureArrayAllocator::update() {
+    for (auto &bucket: _buckets) {
+        if (bucket.mipmapsDirty) {
+            RenderState::bindTexture(TEXTURE_ARRAY_UNIT, GL_TEXTURE_2D_ARRAY, bucket.texture);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+            bucket.mipmapsDirty = false;
+        }
+    }
+}
+
+TextureArrayAllocator::Stats TextureArrayAllocator::getStats() const {
+    Stats stats;
+    stats.buckets = static_cast<int>(_buckets.size());
+    for (const auto &bucket: _buckets) {
+        stats.layers += bucket.highWater - static_cast<int>(bucket.freeLayers.size());
+        stats.capacity += bucket.capacity;
+        // RGBA8 plus roughly a third for the mip chain
+        const GLsizeiptr layerBytes = static_cast<GLsizeiptr>(bucket.width) * bucket.height * 4;
+        stats.gpuBytes += layerBytes * bucket.capacity * 4 / 3;
+    }
+    return stats;
+}
+
+int TextureArrayAllocator::_findBucket(const int width, const int height) {
+    for (int i = 0; i < static_cast<int>(_buckets.size()); ++i) {
+        if (_buckets[i].width == width && _buckets[i].height == height) {
+            return i;
+        }
+    }
+
+    Bucket bucket;
+    bucket.width = width;
+    bucket.height = height;
+    _buckets.push_back(std::move(bucket));
+    return static_cast<int>(_buckets.size()) - 1;
+}
+
+bool TextureArrayAllocator::_grow(Bucket &bucket) {
+    if (_maxLayers == 0) {
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &_maxLayers);
+    }
+    if (bucket.capacity >= _maxLayers) {
+        return false;
+    }
+    const int capacity = std::min(bucket.capacity == 0 ? INITIAL_LAYERS : bucket.capacity * 2, _maxLayers);
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    RenderState::bindTexture(TEXTURE_ARRAY_UNIT, GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, bucket.width, bucket.height, capacity, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    if (bucket.texture != 0) {
+        // GL 3.3 has no glCopyImageSubData: read each old layer through a framebuffer into the new array
+        if (_copyFramebuffer == 0) {
+            glGenFramebuffers(1, &_copyFramebuffer);
+        }
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _copyFramebuffer);
+
+        for (int layer = 0; layer < bucket.highWater; ++layer) {
+            glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, bucket.texture, 0, layer);
+            glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0, bucket.width, bucket.height);
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        RenderState::onTextureDeleted(bucket.texture);
+        glDeleteTextures(1, &bucket.texture);
+        bucket.mipmapsDirty = true;
+    }
+
+    LOG_INFO("Texture array {}x{} grown to {} layers", bucket.width, bucket.height, capacity);
+    bucket.texture = texture;
+    bucket.capacity = capacity;
+    return true;
+}
+
+void TextureArrayAllocator::_release(const int bucket, const int layer) {
+    _buckets[bucket].freeLayers.push_back(layer);
+}
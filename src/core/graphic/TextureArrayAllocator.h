@@ -0,0 +1,93 @@
+/**
+ * @file    TextureArrayAllocator.h
+ * @brief   Header file for the TextureArrayAllocator class.
+ * @details This file contains the definition of the TextureArrayAllocator class which packs textures of the
+ *          same size into the layers of one GL_TEXTURE_2D_ARRAY per size bucket. Instanced draws can then mix
+ *          textures within a batch by passing the layer index per instance.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef TEXTUREARRAYALLOCATOR_H
+#define TEXTUREARRAYALLOCATOR_H
+
+#include <glad/glad.h>
+#include <unordered_map>
+#include <vector>
+#include "Texture.h"
+#include "../../utilities/SmartPointer.h"
+
+// One allocated layer; the layer is freed when the last handle to it goes away
+struct TextureArrayLayer {
+    int bucket = -1;
+    int layer = -1;
+};
+
+class TextureArrayAllocator {
+public:
+    struct Stats {
+        int buckets = 0;
+        int layers = 0; // layers in use
+        int capacity = 0; // layers allocated on the GPU
+        GLsizeiptr gpuBytes = 0;
+    };
+
+    // Texture unit the arrays are bound to; kept apart from unit 0 because a sampler2D and a sampler2DArray
+    // must never read the same unit
+    static constexpr GLuint TEXTURE_ARRAY_UNIT = 4;
+
+    TextureArrayAllocator();
+
+    ~TextureArrayAllocator();
+
+    TextureArrayAllocator(const TextureArrayAllocator &) = delete;
+
+    TextureArrayAllocator &operator=(const TextureArrayAllocator &) = delete;
+
+    // Copy `pixels` (tightly packed RGBA8) into a free layer of the bucket for this size.
+    // Returns nullptr if the bucket is already at the driver's layer limit.
+    ref<TextureArrayLayer> allocate(int width, int height, const unsigned char *pixels);
+
+    // Copy an already loaded 2D texture into a layer (reads it back from the GPU once). While that layer is
+    // alive, further calls for the same texture return it instead of copying again.
+    ref<TextureArrayLayer> allocate(const Texture &texture);
+
+    // Copy `texture` again into the layer it already has, after its image changed. A texture whose size changed
+    // no longer fits that layer; it is forgotten instead, and its current holders keep the old copy.
+    void refresh(const Texture &texture);
+
+    // The GL_TEXTURE_2D_ARRAY currently backing `bucket`; the name changes when the bucket grows
+    [[nodiscard]] GLuint getTexture(int bucket) const;
+
+    // Rebuild the mipmaps of the arrays that received new layers; call once before drawing
+    void update();
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    struct Bucket {
+        int width = 0;
+        int height = 0;
+        GLuint texture = 0;
+        int capacity = 0;
+        int highWater = 0; // layers [0, highWater) have been handed out at least once
+        std::vector<int> freeLayers;
+        bool mipmapsDirty = false;
+    };
+
+    static constexpr int INITIAL_LAYERS = 16;
+
+    std::vector<Bucket> _buckets;
+    std::unordered_map<GLuint, std::weak_ptr<TextureArrayLayer> > _byTexture;
+    GLuint _copyFramebuffer = 0;
+    GLint _maxLayers = 0;
+
+    int _findBucket(int width, int height);
+
+    bool _grow(Bucket &bucket);
+
+    void _release(int bucket, int layer);
+};
+
+
+#endif //TEXTUREARRAYALLOCATOR_H
@@ -0,0 +1,182 @@
+/**
+ * @file    TextureCache.cpp
+ * @brief   Implementation file for the TextureCache class.
+ * @details This file contains the implementation of the TextureCache class which hands out shared,
+ *          reference-counted textures looked up by path and by content hash.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "TextureCache.h"
+#include <algorithm>
+#include <filesystem>
+#include <ranges>
+#include <stb_image.h>
+#include "../locator/Locator.h"
+#include "../../utilities/AssetsManager.h"
+#include "../../utilities/Hash.h"
+
+ref<Texture> TextureCache::acquire(const std::string &path) {
+    const std::string key = _normalise(path);
+
+    auto &pathSlot = _byPath[key];
+    if (auto texture = pathSlot.lock()) {
+        ++_pathHits;
+        return texture;
+    }
+
+    std::vector<unsigned char> bytes;
+    if (!AssetsManager::Get().readFile(key, bytes)) {
+        LOG_ERROR("Failed to open texture: {}", path);
+        return nullptr;
+    }
+
+    // the header alone gives the image size, so a hash match can be checked without decoding the file
+    const std::uint64_t contentHash = hashContent(bytes);
+    int width = 0, height = 0, channels = 0;
+    if (stbi_info_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels)) {
+        if (auto texture = _findContent(contentHash, bytes.size(), width, height)) {
+            ++_contentHits;
+            pathSlot = texture;
+            return texture;
+        }
+    }
+
+    auto texture = createRef<Texture>();
+    if (!texture->loadFromMemory(bytes.data(), bytes.size(), path)) {
+        return nullptr;
+    }
+    ++_misses;
+    pathSlot = texture;
+    _addContent(contentHash, bytes.size(), texture);
+
+    _pruneIfNeeded();
+    return texture;
+}
+
+ref<Texture> TextureCache::acquireAsync(const std::string &path) {
+    const std::string key = _normalise(path);
+
+    auto &pathSlot = _byPath[key];
+    if (auto texture = pathSlot.lock()) {
+        ++_pathHits;
+        return texture;
+    }
+
+    auto texture = createRef<Texture>();
+    texture->createPlaceholder();
+    pathSlot = texture;
+
+    const auto onLoaded = [this, key](const ref<Texture> &loaded, const AsyncTextureLoader::Result &result) {
+        if (!result.succeeded) {
+            // forget the placeholder so the next acquire tries the file again
+            if (const auto slot = _byPath.find(key); slot != _byPath.end() && slot->second.lock() == loaded) {
+                _byPath.erase(slot);
+            }
+            return;
+        }
+        _addContent(result.contentHash, result.fileSize, loaded);
+    };
+    const auto resolve = [this, key](const ref<Texture> &loading, const AsyncTextureLoader::Result &result) {
+        auto resident = _findContent(result.contentHash, result.fileSize, result.width, result.height);
+        if (!resident) {
+            ++_misses;
+            return resident;
+        }
+        ++_contentHits;
+        // later acquires of this path get the resident texture itself rather than the one sharing it
+        if (auto &slot = _byPath[key]; slot.lock() == loading) {
+            slot = resident;
+        }
+        return resident;
+    };
+    _loader.load(texture, key, onLoaded, resolve);
+
+    _pruneIfNeeded();
+    return texture;
+}
+
+bool TextureCache::reload(const std::string &path) {
+    const auto slot = _byPath.find(_normalise(path));
+    const auto texture = slot == _byPath.end() ? nullptr : slot->second.lock();
+    if (!texture) {
+        return false;
+    }
+    if (!AssetsManager::Get().exists(slot->first)) {
+        return false; // deleted: holders keep the image they have
+    }
+
+    // the old contents no longer describe this texture; a copy of the old file must load on its own
+    std::erase_if(_byContent, [&texture](const auto &entry) {
+        return entry.second.texture.lock() == texture;
+    });
+
+    _loader.load(texture, slot->first, [this](const ref<Texture> &loaded, const AsyncTextureLoader::Result &result) {
+        if (!result.succeeded) {
+            return; // keeps showing the previous image
+        }
+        _addContent(result.contentHash, result.fileSize, loaded);
+        Locator::textureArrays().refresh(*loaded);
+    });
+    LOG_INFO("Reloading texture {}", slot->first);
+    return true;
+}
+
+void TextureCache::update() {
+    _loader.update();
+}
+
+TextureCache::Stats TextureCache::getStats() const {
+    Stats stats;
+    stats.pathHits = _pathHits;
+    stats.contentHits = _contentHits;
+    stats.misses = _misses;
+    // every live texture has exactly one content entry, paths may alias
+    for (const auto &entry: _byContent | std::views::values) {
+        if (const auto texture = entry.texture.lock()) {
+            ++stats.liveTextures;
+            stats.gpuBytes += texture->getByteSize();
+        }
+    }
+    return stats;
+}
+
+std::uint64_t TextureCache::hashContent(const std::vector<unsigned char> &bytes) {
+    return Hash::fnv1a(bytes.data(), bytes.size()) ^ static_cast<std::uint64_t>(bytes.size()) * 0x9E3779B97F4A7C15ull;
+}
+
+std::string TextureCache::_normalise(const std::string &path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+ref<Texture> TextureCache::_findContent(const std::uint64_t contentHash, const std::size_t fileSize, const int width,
+                                        const int height) const {
+    const auto entry = _byContent.find(contentHash);
+    if (entry == _byContent.end() || entry->second.fileSize != fileSize) {
+        return nullptr;
+    }
+    auto texture = entry->second.texture.lock();
+    if (!texture || texture->getWidth() != width || texture->getHeight() != height) {
+        return nullptr; // gone, or a different image that happens to hash the same
+    }
+    return texture;
+}
+
+void TextureCache::_addContent(const std::uint64_t contentHash, const std::size_t fileSize,
+                               const ref<Texture> &texture) {
+    if (auto &entry = _byContent[contentHash]; entry.texture.expired()) {
+        entry = {texture, fileSize};
+    }
+}
+
+void TextureCache::_pruneIfNeeded() {
+    if (_byPath.size() + _byContent.size() >= _pruneThreshold) {
+        _prune();
+    }
+}
+
+void TextureCache::_prune() {
+    std::erase_if(_byPath, [](const auto &entry) { return entry.second.expired(); });
+    std::erase_if(_byContent, [](const auto &entry) { return entry.second.texture.expired(); });
+    _pruneThreshold = std::max<std::size_t>(64, (_byPath.size() + _byContent.size()) * 2);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file    TextureCache.h
+ * @brief   Header file for the TextureCache class.
+ * @details This file contains the definition of the TextureCache class which hands out shared, reference-counted
+ *          textures. Lookups go by path first and then by a hash of the file contents, so the same image is
+ *          decoded and uploaded once no matter how many entities or paths refer to it.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AsyncTextureLoader.h"
+#include "Texture.h"
+#include "../../utilities/SmartPointer.h"
+
+class TextureCache {
+public:
+    struct Stats {
+        int pathHits = 0; // served without touching the file
+        int contentHits = 0; // new path, but an identical file was already loaded
+        int misses = 0; // decoded and uploaded
+        int liveTextures = 0;
+        GLsizeiptr gpuBytes = 0;
+    };
+
+    // Returns the texture for `path`, loading it only if no live texture has the same path or the same
+    // contents. The GL texture is freed when the last handle goes away. Returns nullptr if loading fails.
+    ref<Texture> acquire(const std::string &path);
+
+    // Like acquire(), but a miss returns right away with a placeholder texture; the image is decoded on a worker
+    // thread and uploaded by a later update(). If the file turns out to hold an image already loaded under another
+    // path, the placeholder shares that texture instead of uploading a copy. If loading fails, the placeholder
+    // stays, but the path is forgotten so a later acquire tries again.
+    ref<Texture> acquireAsync(const std::string &path);
+
+    // Decode the file at `path` again into the live texture loaded from it, so every holder sees the new image.
+    // Other paths whose files had the same contents share that texture and change with it. Returns false if no
+    // live texture was loaded from `path`, or if the file is gone (holders keep the last image).
+    bool reload(const std::string &path);
+
+    // Main thread, once per frame: finish pending asynchronous uploads within the loader's budget
+    void update();
+
+    [[nodiscard]] AsyncTextureLoader::Stats getLoaderStats() const { return _loader.getStats(); }
+
+    AsyncTextureLoader &getLoader() { return _loader; }
+
+    [[nodiscard]] Stats getStats() const;
+
+    // Key of the content lookup: FNV-1a over the encoded file bytes, mixed with their size
+    static std::uint64_t hashContent(const std::vector<unsigned char> &bytes);
+
+private:
+    // A hash match alone is not trusted: the file and image sizes must match as well before a texture is reused
+    struct ContentEntry {
+        std::weak_ptr<Texture> texture;
+        std::size_t fileSize = 0;
+    };
+
+    std::unordered_map<std::string, std::weak_ptr<Texture> > _byPath;
+    std::unordered_map<std::uint64_t, ContentEntry> _byContent;
+    std::size_t _pruneThreshold = 64;
+    AsyncTextureLoader _loader;
+
+    int _pathHits = 0;
+    int _contentHits = 0;
+    int _misses = 0;
+
+    static std::string _normalise(const std::string &path);
+
+    // The live texture loaded from a file with this hash, file size and image size, or nullptr
+    ref<Texture> _findContent(std::uint64_t contentHash, std::size_t fileSize, int width, int height) const;
+
+    // Record `texture` as holding this content unless another live texture already does
+    void _addContent(std::uint64_t contentHash, std::size_t fileSize, const ref<Texture> &texture);
+
+    // Drop entries whose texture is gone; amortised by doubling the threshold
+    void _prune();
+
+    void _pruneIfNeeded();
+};
+
+
+#endif //TEXTURECACHE_H
@@ -0,0 +1,55 @@
+/**
+ * @file    UniformBuffer.cpp
+ * @brief   Implementation file for the UniformBuffer class.
+ * @details This file contains the implementation of the UniformBuffer class which wraps a std140 uniform buffer
+ *          object attached to a fixed binding point.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "UniformBuffer.h"
+#include <utility>
+#include "../../utilities/Logger.h"
+
+namespace {
+    constexpr std::pair<const char *, UniformBlockBinding> BLOCKS[] = {
+        {"Camera", UniformBlockBinding::Camera},
+        {"Lighting", UniformBlockBinding::Lighting},
+    };
+}
+
+UniformBuffer::UniformBuffer(const UniformBlockBinding binding, const GLsizeiptr size)
+    : _binding(binding), _size(size) {
+}
+
+UniformBuffer::~UniformBuffer() {
+    if (_buffer != 0) {
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+void UniformBuffer::update(const void *data, const GLsizeiptr size, const GLintptr offset) {
+    if (offset + size > _size) {
+        LOG_ERROR("Uniform buffer update out of range ({} + {} > {})", offset, size, _size);
+        return;
+    }
+
+    if (_buffer == 0) {
+        glGenBuffers(1, &_buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+        glBufferData(GL_UNIFORM_BUFFER, _size, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    // glBindBufferBase also binds the generic GL_UNIFORM_BUFFER target used by the upload below.
+    // Rebinding every update keeps the binding point correct when several scenes own their own buffers.
+    glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(_binding), _buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
+
+void UniformBuffer::bindBlocks(const GLuint program) {
+    for (const auto &[name, binding]: BLOCKS) {
+        if (const GLuint index = glGetUniformBlockIndex(program, name); index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program, index, static_cast<GLuint>(binding));
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file    UniformBuffer.h
+ * @brief   Header file for the UniformBuffer class.
+ * @details This file contains the definition of the UniformBuffer class which wraps a std140 uniform buffer object
+ *          attached to a fixed binding point. Per-frame data (camera, lighting) is uploaded once into such a buffer
+ *          and every shader that declares the matching uniform block reads it without further uniform calls.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef UNIFORMBUFFER_H
+#define UNIFORMBUFFER_H
+
+#include <glad/glad.h>
+
+// Fixed binding points of the engine's uniform blocks. A shader opts in by declaring
+// `layout(std140) uniform <Name> { ... };` with one of the block names below.
+enum class UniformBlockBinding : GLuint {
+    Camera = 0,
+    Lighting = 1,
+};
+
+class UniformBuffer {
+public:
+    UniformBuffer(UniformBlockBinding binding, GLsizeiptr size);
+
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer &) = delete;
+
+    UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+    // Upload `size` bytes at `offset` and attach the buffer to its binding point.
+    // The GL buffer is created on the first update, so this must run on the GL thread.
+    void update(const void *data, GLsizeiptr size, GLintptr offset = 0);
+
+    template<typename Block>
+    void update(const Block &block) {
+        update(&block, static_cast<GLsizeiptr>(sizeof(Block)));
+    }
+
+    // Connect every engine uniform block declared by `program` to its binding point (called after linking)
+    static void bindBlocks(GLuint program);
+
+private:
+    UniformBlockBinding _binding;
+    GLsizeiptr _size;
+    GLuint _buffer = 0;
+};
+
+
+#endif //UNIFORMBUFFER_H
@@ -7,12 +7,15 @@
  */
 
 #include "VertexArray.h"
+#include "RenderState.h"
 
 VertexArray::VertexArray() : _vao(0), _vbo(0), _initialized(false) {
 }
 
 
 VertexArray::~VertexArray() {
+    RenderState::onBufferDeleted(_vbo);
+    RenderState::onVertexArrayDeleted(_vao);
     glDeleteBuffers(1, &_vbo);
     glDeleteVertexArrays(1, &_vao);
 }
@@ -26,16 +29,16 @@ void VertexArray::initialize() {
 }
 
 void VertexArray::bind() const {
-    glBindVertexArray(_vao);
+    RenderState::bindVertexArray(_vao);
 }
 
 void VertexArray::unbind() const {
-    glBindVertexArray(0);
+    RenderState::bindVertexArray(0);
 }
 
 void VertexArray::addBuffer(GLfloat *vertices, GLsizeiptr size, const std::vector<GLuint> &attributeSizes) {
     bind();
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    RenderState::bindArrayBuffer(_vbo);
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 
     GLuint stride = 0;
@@ -51,6 +54,5 @@ void VertexArray::addBuffer(GLfloat *vertices, GLsizeiptr size, const std::vecto
         offset += attributeSize;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     unbind();
 }
@@ -9,4 +9,8 @@
 #include "Locator.h"
 
 ShaderManager *Locator::_shaderMgr = nullptr;
-Window *Locator::_window = nullptr;
\ No newline at end of file
+ProgramBinaryCache *Locator::_programBinaries = nullptr;
+Window *Locator::_window = nullptr;
+GeometryRegistry *Locator::_geometry = nullptr;
+TextureCache *Locator::_textures = nullptr;
+TextureArrayAllocator *Locator::_textureArrays = nullptr;
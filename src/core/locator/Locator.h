@@ -9,7 +9,11 @@
 #ifndef LOCATOR_H
 #define LOCATOR_H
 
+#include "../graphic/ProgramBinaryCache.h"
 #include "../graphic/ShaderManager.h"
+#include "../graphic/TextureArrayAllocator.h"
+#include "../graphic/TextureCache.h"
+#include "../mesh/GeometryRegistry.h"
 #include "../window/Window.h"
 
 class Locator {
@@ -17,13 +21,33 @@ public:
     static void provide(ShaderManager *mgr) { _shaderMgr = mgr; }
     static ShaderManager &shaders() { return *_shaderMgr; }
 
+    // linked programs kept on disk between runs; nullptr when nothing provided one
+    static void provideProgramBinaries(ProgramBinaryCache *cache) { _programBinaries = cache; }
+    static ProgramBinaryCache *programBinaries() { return _programBinaries; }
+
     // window
     static void provideWindow(Window *win) { _window = win; }
     static Window *window() { return _window; }
 
+    // shared GPU geometry
+    static void provideGeometry(GeometryRegistry *registry) { _geometry = registry; }
+    static GeometryRegistry &geometry() { return *_geometry; }
+
+    // shared textures, deduplicated by path and content
+    static void provideTextures(TextureCache *cache) { _textures = cache; }
+    static TextureCache &textures() { return *_textures; }
+
+    // texture array layers for the instanced path
+    static void provideTextureArrays(TextureArrayAllocator *allocator) { _textureArrays = allocator; }
+    static TextureArrayAllocator &textureArrays() { return *_textureArrays; }
+
 private:
     static ShaderManager *_shaderMgr;
+    static ProgramBinaryCache *_programBinaries;
     static Window *_window;
+    static GeometryRegistry *_geometry;
+    static TextureCache *_textures;
+    static TextureArrayAllocator *_textureArrays;
 };
 
 
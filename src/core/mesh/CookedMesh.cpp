@@ -0,0 +1,195 @@
+/**
+ * @file    CookedMesh.cpp
+ * @brief   Implementation file for the CookedMesh class.
+ * @details This file contains the implementation of the CookedMesh class which reads and writes the binary
+ *          `.cbmesh` format.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "CookedMesh.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include "../../utilities/Logger.h"
+
+namespace {
+    constexpr std::uint64_t alignTo16(const std::uint64_t value) {
+        return (value + 15u) & ~static_cast<std::uint64_t>(15u);
+    }
+}
+
+bool CookedMesh::open(const std::string &path) {
+    close();
+
+    if (!_file.open(path)) {
+        LOG_ERROR("Unable to map cooked mesh {}", path);
+        return false;
+    }
+
+    const unsigned char *data = _file.data();
+    const std::size_t size = _file.size();
+
+    if (size < sizeof(CookedMeshHeader)) {
+        LOG_ERROR("Cooked mesh {} is truncated", path);
+        _file.close();
+        return false;
+    }
+
+    // mappings are page aligned, so the header can be read in place
+    const auto *header = reinterpret_cast<const CookedMeshHeader *>(data);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        LOG_ERROR("{} is not a cooked mesh", path);
+        _file.close();
+        return false;
+    }
+
+    if (header->version != VERSION) {
+        LOG_WARN("Cooked mesh {} has version {}, expected {}", path, header->version, VERSION);
+        _file.close();
+        return false;
+    }
+
+    if (header->vertexFormat > static_cast<std::uint32_t>(VertexFormat::CompactHalfPositions) ||
+        header->vertexStride != static_cast<std::uint32_t>(
+            VertexLayout::get(static_cast<VertexFormat>(header->vertexFormat)).stride)) {
+        LOG_ERROR("Cooked mesh {} has an unsupported vertex format {} ({} bytes)", path, header->vertexFormat,
+                  header->vertexStride);
+        _file.close();
+        return false;
+    }
+
+    // written as `bytes > size - offset` so an offset near 2^64 can't wrap around and pass
+    const auto fits = [size](const std::uint64_t offset, const std::uint64_t bytes) {
+        return offset >= sizeof(CookedMeshHeader) && offset <= size && bytes <= size - offset;
+    };
+    const bool wideIndices = (header->flags & FLAG_32BIT_INDICES) != 0;
+    const std::uint64_t vertexBytes = static_cast<std::uint64_t>(header->vertexCount) * header->vertexStride;
+    const std::uint64_t indexBytes = static_cast<std::uint64_t>(header->indexCount) * (wideIndices ? 4u : 2u);
+    if (!fits(header->vertexOffset, vertexBytes) || !fits(header->indexOffset, indexBytes)) {
+        LOG_ERROR("Cooked mesh {} points outside of the file", path);
+        _file.close();
+        return false;
+    }
+
+    // an index past the last vertex would make the GPU read outside the vertex buffer
+    const unsigned char *indices = data + header->indexOffset;
+    for (std::uint32_t i = 0; i < header->indexCount; ++i) {
+        std::uint32_t index;
+        if (wideIndices) {
+            std::memcpy(&index, indices + std::size_t{i} * 4u, sizeof(index));
+        } else {
+            std::uint16_t narrow;
+            std::memcpy(&narrow, indices + std::size_t{i} * 2u, sizeof(narrow));
+            index = narrow;
+        }
+        if (index >= header->vertexCount) {
+            LOG_ERROR("Cooked mesh {} has index {} past its {} vertices", path, index, header->vertexCount);
+            _file.close();
+            return false;
+        }
+    }
+
+    _header = header;
+    _vertices = data + header->vertexOffset;
+    _indices = data + header->indexOffset;
+    return true;
+}
+
+void CookedMesh::close() {
+    _file.close();
+    _header = nullptr;
+    _vertices = nullptr;
+    _indices = nullptr;
+}
+
+std::size_t CookedMesh::getVertexBytes() const {
+    return static_cast<std::size_t>(_header->vertexCount) * _header->vertexStride;
+}
+
+std::size_t CookedMesh::getIndexBytes() const {
+    return static_cast<std::size_t>(_header->indexCount) * (uses32BitIndices() ? 4u : 2u);
+}
+
+bool CookedMesh::write(const std::string &path, const std::vector<float> &vertices,
+                       const std::vector<unsigned int> &indices, const VertexFormat format) {
+    constexpr std::size_t floatsPerVertex = 3 + 3 + 2;
+    const std::size_t vertexCount = vertices.size() / floatsPerVertex;
+    if (vertexCount == 0 || indices.empty() || vertexCount > std::numeric_limits<std::uint32_t>::max()) {
+        LOG_ERROR("Refusing to cook an empty or oversized mesh into {}", path);
+        return false;
+    }
+
+    CookedMeshHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.vertexFormat = static_cast<std::uint32_t>(format);
+    header.vertexStride = static_cast<std::uint32_t>(VertexLayout::get(format).stride);
+    header.vertexCount = static_cast<std::uint32_t>(vertexCount);
+    header.indexCount = static_cast<std::uint32_t>(indices.size());
+
+    // 16-bit indices halve the index buffer for every mesh below 65536 vertices
+    const bool wideIndices = vertexCount > std::numeric_limits<std::uint16_t>::max() + 1u;
+    header.flags = wideIndices ? FLAG_32BIT_INDICES : 0u;
+
+    // bounds: AABB plus a sphere around its center, same fit as Geometry computes at load time
+    float minimum[3] = {vertices[0], vertices[1], vertices[2]};
+    float maximum[3] = {vertices[0], vertices[1], vertices[2]};
+    for (std::size_t i = 0; i < vertexCount * floatsPerVertex; i += floatsPerVertex) {
+        for (int axis = 0; axis < 3; ++axis) {
+            minimum[axis] = std::min(minimum[axis], vertices[i + axis]);
+            maximum[axis] = std::max(maximum[axis], vertices[i + axis]);
+        }
+    }
+    float radiusSquared = 0.0f;
+    for (std::size_t i = 0; i < vertexCount * floatsPerVertex; i += floatsPerVertex) {
+        float distanceSquared = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float offset = vertices[i + axis] - (minimum[axis] + maximum[axis]) * 0.5f;
+            distanceSquared += offset * offset;
+        }
+        radiusSquared = std::max(radiusSquared, distanceSquared);
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        header.boundsMin[axis] = minimum[axis];
+        header.boundsMax[axis] = maximum[axis];
+        header.boundingSphere[axis] = (minimum[axis] + maximum[axis]) * 0.5f;
+    }
+    header.boundingSphere[3] = std::sqrt(radiusSquared);
+
+    const std::vector<unsigned char> packed = MeshOptimizer::quantize(vertices, format);
+    const std::uint64_t vertexBytes = packed.size();
+    header.vertexOffset = alignTo16(sizeof(CookedMeshHeader));
+    header.indexOffset = alignTo16(header.vertexOffset + vertexBytes);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("Unable to open {} for writing", path);
+        return false;
+    }
+
+    constexpr char padding[16] = {};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(padding, static_cast<std::streamsize>(header.vertexOffset - sizeof(header)));
+    out.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(vertexBytes));
+    out.write(padding, static_cast<std::streamsize>(header.indexOffset - header.vertexOffset - vertexBytes));
+
+    if (wideIndices) {
+        out.write(reinterpret_cast<const char *>(indices.data()),
+                  static_cast<std::streamsize>(indices.size() * sizeof(std::uint32_t)));
+    } else {
+        const std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+        out.write(reinterpret_cast<const char *>(narrow.data()),
+                  static_cast<std::streamsize>(narrow.size() * sizeof(std::uint16_t)));
+    }
+
+    if (!out) {
+        LOG_ERROR("Failed to write cooked mesh {}", path);
+        return false;
+    }
+
+    return true;
+}
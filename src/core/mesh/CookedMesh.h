@@ -0,0 +1,83 @@
+/**
+ * @file    CookedMesh.h
+ * @brief   Header file for the CookedMesh class.
+ * @details This file contains the definition of the CookedMesh class which reads and writes the binary `.cbmesh`
+ *          format: a versioned header followed by deduplicated interleaved vertices and a 16 or 32-bit index
+ *          buffer, both laid out exactly as the GPU wants them (in any VertexFormat). Loading maps the file and
+ *          validates the header; the vertex and index pointers point straight into the mapping and can be handed
+ *          to glBufferData.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef COOKEDMESH_H
+#define COOKEDMESH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "VertexLayout.h"
+#include "../../utilities/MappedFile.h"
+
+// On-disk header, little endian. Offsets are from the start of the file and 16-byte aligned.
+struct CookedMeshHeader {
+    char magic[4];              // "CBMS"
+    std::uint32_t version;      // CookedMesh::VERSION
+    std::uint32_t flags;        // CookedMesh::FLAG_*
+    std::uint32_t vertexFormat; // VertexFormat of the vertex data
+    std::uint32_t vertexStride; // bytes per vertex, as given by the VertexLayout of vertexFormat
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t reserved;
+    float boundsMin[3];
+    float boundsMax[3];
+    float boundingSphere[4];    // xyz: center, w: radius
+    std::uint64_t vertexOffset;
+    std::uint64_t indexOffset;
+};
+
+static_assert(sizeof(CookedMeshHeader) == 88, "CookedMeshHeader is read straight from disk");
+
+class CookedMesh {
+public:
+    static constexpr char MAGIC[4] = {'C', 'B', 'M', 'S'};
+    static constexpr std::uint32_t VERSION = 2;
+    static constexpr std::uint32_t FLAG_32BIT_INDICES = 1u << 0;
+
+    // Map `path` and validate it; no vertex is touched
+    bool open(const std::string &path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return _header != nullptr; }
+
+    [[nodiscard]] const CookedMeshHeader &getHeader() const { return *_header; }
+
+    [[nodiscard]] const void *getVertices() const { return _vertices; }
+
+    [[nodiscard]] std::size_t getVertexBytes() const;
+
+    [[nodiscard]] const void *getIndices() const { return _indices; }
+
+    [[nodiscard]] std::size_t getIndexBytes() const;
+
+    [[nodiscard]] bool uses32BitIndices() const { return (_header->flags & FLAG_32BIT_INDICES) != 0; }
+
+    [[nodiscard]] VertexFormat getVertexFormat() const { return static_cast<VertexFormat>(_header->vertexFormat); }
+
+    // Cook interleaved float vertices (already deduplicated and optimized) and their triangle indices into
+    // `path`, repacking the vertices into `format`. Indices are stored as 16-bit whenever every vertex is
+    // reachable with them.
+    static bool write(const std::string &path, const std::vector<float> &vertices,
+                      const std::vector<unsigned int> &indices, VertexFormat format = VertexFormat::Float32);
+
+private:
+    MappedFile _file;
+    const CookedMeshHeader *_header = nullptr;
+    const unsigned char *_vertices = nullptr;
+    const unsigned char *_indices = nullptr;
+};
+
+
+#endif //COOKEDMESH_H
@@ -16,9 +16,14 @@ public:
 
     ~CubeMesh() override;
 
+    // Unit cube centered at the origin, 4 unique vertices per face
+    [[nodiscard]] static GeometryData buildGeometry();
+
+    // The single cube geometry shared by every CubeMesh and the instanced renderer
+    [[nodiscard]] static ref<Geometry> sharedGeometry();
+
 protected:
-    void setupMesh() override;
-    bool _initialized = false;
+    [[nodiscard]] ref<Geometry> acquireGeometry() const override;
 };
 
 
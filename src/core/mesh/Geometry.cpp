@@ -0,0 +1,123 @@
+/**
+ * @file    Geometry.cpp
+ * @brief   Implementation file for the Geometry class.
+ * @details This file contains the implementation of the Geometry class which owns the GPU buffers (VAO, VBO, EBO)
+ *          of one piece of indexed mesh data. Geometry is shared between meshes through the GeometryRegistry.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "../graphic/RenderState.h"
+
+Geometry::Geometry(const GeometryData &data) : Geometry(_viewOf(data)) {
+}
+
+Geometry::Geometry(const GeometryView &view)
+    : _indexCount(view.indexCount),
+      _indexType(view.indexType),
+      _boundingSphere(view.boundingSphere) {
+    const auto indexBytes = static_cast<GLsizeiptr>(view.indexCount) *
+                            (view.indexType == GL_UNSIGNED_SHORT ? 2 : 4);
+    _byteSize = view.vertexBytes + indexBytes;
+
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+    glGenBuffers(1, &_ebo);
+
+    RenderState::bindVertexArray(_vao);
+
+    RenderState::bindArrayBuffer(_vbo);
+    glBufferData(GL_ARRAY_BUFFER, view.vertexBytes, view.vertices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, view.indices, GL_STATIC_DRAW);
+
+    VertexLayout::get(view.format).apply();
+}
+
+GeometryView Geometry::_viewOf(const GeometryData &data) {
+    GeometryView view;
+    view.vertices = data.vertices.data();
+    view.vertexBytes = static_cast<GLsizeiptr>(data.vertices.size() * sizeof(float));
+    view.indices = data.indices.data();
+    view.indexCount = static_cast<GLsizei>(data.indices.size());
+    view.indexType = GL_UNSIGNED_INT;
+
+    view.boundingSphere = computeBoundingSphere(data.vertices);
+    return view;
+}
+
+glm::vec4 Geometry::computeBoundingSphere(const std::vector<float> &vertices) {
+    constexpr std::size_t floatsPerVertex = 3 + 3 + 2;
+    if (vertices.size() < floatsPerVertex) {
+        return glm::vec4(0.0f);
+    }
+
+    glm::vec3 minimum(vertices[0], vertices[1], vertices[2]);
+    glm::vec3 maximum = minimum;
+    for (std::size_t i = 0; i + 2 < vertices.size(); i += floatsPerVertex) {
+        const glm::vec3 position(vertices[i], vertices[i + 1], vertices[i + 2]);
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+    }
+
+    const glm::vec3 center = (minimum + maximum) * 0.5f;
+    float radiusSquared = 0.0f;
+    for (std::size_t i = 0; i + 2 < vertices.size(); i += floatsPerVertex) {
+        const glm::vec3 offset = glm::vec3(vertices[i], vertices[i + 1], vertices[i + 2]) - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    return glm::vec4(center, std::sqrt(radiusSquared));
+}
+
+Geometry::~Geometry() {
+    RenderState::onVertexArrayDeleted(_vao);
+    RenderState::onBufferDeleted(_vbo);
+    glDeleteVertexArrays(1, &_vao);
+    glDeleteBuffers(1, &_vbo);
+    glDeleteBuffers(1, &_ebo);
+}
+
+void Geometry::bind() const {
+    RenderState::bindVertexArray(_vao);
+}
+
+void Geometry::draw() const {
+    glDrawElements(GL_TRIANGLES, _indexCount, _indexType, nullptr);
+}
+
+void Geometry::bindInstanced(const GLuint instanceBuffer, const GLintptr offset) const {
+    RenderState::bindVertexArray(_vao);
+    RenderState::bindArrayBuffer(instanceBuffer);
+
+    constexpr auto stride = static_cast<GLsizei>(sizeof(InstanceData));
+
+    // model matrix: one vec4 attribute per column
+    for (GLuint column = 0; column < 4; ++column) {
+        const GLuint location = 3 + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<void *>(offset + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+
+    // color
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(offset + offsetof(InstanceData, color)));
+    glVertexAttribDivisor(7, 1);
+
+    // texture array layer
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void *>(offset + offsetof(InstanceData, textureLayer)));
+    glVertexAttribDivisor(8, 1);
+}
+
+void Geometry::drawInstanced(const GLsizei instanceCount) const {
+    glDrawElementsInstanced(GL_TRIANGLES, _indexCount, _indexType, nullptr, instanceCount);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file    Geometry.h
+ * @brief   Header file for the Geometry class.
+ * @details This file contains the definition of the Geometry class which owns the GPU buffers (VAO, VBO, EBO)
+ *          of one piece of indexed mesh data. Geometry is shared between meshes through the GeometryRegistry.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "VertexLayout.h"
+
+// Per-instance vertex data consumed by the instanced mesh shaders
+// (attribute locations 3-6 hold the model matrix columns, 7 holds the color, 8 the texture array layer)
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+    float textureLayer = 0.0f; // only read when the run is drawn from a texture array
+};
+
+// CPU side mesh data, interleaved as position (vec3), normal (vec3), texcoord (vec2)
+struct GeometryData {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// Mesh data in any VertexFormat that is uploaded as is, e.g. straight out of a mapped file
+struct GeometryView {
+    const void *vertices = nullptr;
+    GLsizeiptr vertexBytes = 0;
+    VertexFormat format = VertexFormat::Float32;
+    const void *indices = nullptr;
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT; // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    glm::vec4 boundingSphere{0.0f};
+};
+
+class Geometry {
+public:
+    // Uploads the data right away, so this must run on the thread owning the GL context
+    explicit Geometry(const GeometryData &data);
+
+    // Same as above, for data whose bounds are known already; nothing is read on the CPU
+    explicit Geometry(const GeometryView &view);
+
+    ~Geometry();
+
+    Geometry(const Geometry &) = delete;
+
+    Geometry &operator=(const Geometry &) = delete;
+
+    void bind() const;
+
+    void draw() const;
+
+    // Bind the VAO and point the per-instance attributes at `instanceBuffer`, starting at `offset` bytes
+    void bindInstanced(GLuint instanceBuffer, GLintptr offset) const;
+
+    // Draw `instanceCount` instances; bindInstanced() must have been called first
+    void drawInstanced(GLsizei instanceCount) const;
+
+    [[nodiscard]] GLuint getVAO() const { return _vao; }
+    [[nodiscard]] GLsizei getIndexCount() const { return _indexCount; }
+    [[nodiscard]] GLsizeiptr getByteSize() const { return _byteSize; }
+
+    // Local space bounding sphere of the vertices (xyz: center, w: radius), used for frustum culling
+    [[nodiscard]] const glm::vec4 &getBoundingSphere() const { return _boundingSphere; }
+
+    // Sphere around the center of the AABB of interleaved float vertices; not the tightest fit, but cheap and stable
+    static glm::vec4 computeBoundingSphere(const std::vector<float> &vertices);
+
+private:
+    static GeometryView _viewOf(const GeometryData &data);
+
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    GLuint _ebo = 0;
+    GLsizei _indexCount = 0;
+    GLenum _indexType = GL_UNSIGNED_INT;
+    GLsizeiptr _byteSize = 0;
+    glm::vec4 _boundingSphere{0.0f};
+};
+
+
+#endif //GEOMETRY_H
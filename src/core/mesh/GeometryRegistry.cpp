@@ -0,0 +1,38 @@
+/**
+ * @file    GeometryRegistry.cpp
+ * @brief   Implementation file for the GeometryRegistry class.
+ * @details This file contains the implementation of the GeometryRegistry class which uploads each named piece of
+ *          geometry (e.g. the unit cube) once and hands out shared, reference-counted handles to it.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "GeometryRegistry.h"
+#include <ranges>
+
+ref<Geometry> GeometryRegistry::acquire(const std::string &name, const Builder build) {
+    auto &slot = _geometries[name];
+    if (auto geometry = slot.lock()) {
+        return geometry;
+    }
+
+    auto geometry = createRef<Geometry>(build());
+    slot = geometry;
+    return geometry;
+}
+
+int GeometryRegistry::getLiveCount() const {
+    int count = 0;
+    for (const auto &geometry: _geometries | std::views::values) {
+        if (!geometry.expired()) ++count;
+    }
+    return count;
+}
+
+GLsizeiptr GeometryRegistry::getGpuBytes() const {
+    GLsizeiptr bytes = 0;
+    for (const auto &slot: _geometries | std::views::values) {
+        if (const auto geometry = slot.lock()) bytes += geometry->getByteSize();
+    }
+    return bytes;
+}
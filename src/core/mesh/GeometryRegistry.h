@@ -0,0 +1,36 @@
+/**
+ * @file    GeometryRegistry.h
+ * @brief   Header file for the GeometryRegistry class.
+ * @details This file contains the definition of the GeometryRegistry class which uploads each named piece of
+ *          geometry (e.g. the unit cube) once and hands out shared, reference-counted handles to it.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef GEOMETRYREGISTRY_H
+#define GEOMETRYREGISTRY_H
+
+#include <string>
+#include <unordered_map>
+#include "Geometry.h"
+#include "../../utilities/SmartPointer.h"
+
+class GeometryRegistry {
+public:
+    using Builder = GeometryData (*)();
+
+    // Returns the live geometry registered under `name`, uploading `build()` first if nobody holds it.
+    // The GPU buffers are released as soon as the last handle goes away.
+    ref<Geometry> acquire(const std::string &name, Builder build);
+
+    // Number of geometries currently alive and the GPU bytes they hold
+    [[nodiscard]] int getLiveCount() const;
+
+    [[nodiscard]] GLsizeiptr getGpuBytes() const;
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<Geometry> > _geometries;
+};
+
+
+#endif //GEOMETRYREGISTRY_H
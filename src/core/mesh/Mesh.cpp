@@ -11,46 +11,51 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-Mesh::Mesh() : indexCount(0),
-               position(0.0f),
+Mesh::Mesh() : position(0.0f),
                scale(1.0f),
                rotationAxis(0.0f, 0.0f, 1.0f) {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
 }
 
-Mesh::~Mesh() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
+Mesh::~Mesh() = default;
+
+const Geometry &Mesh::geometry() const {
+    if (!_geometry) {
+        _geometry = acquireGeometry();
+    }
+    return *_geometry;
 }
 
 void Mesh::draw(const ShaderProgram &shader) const {
-    auto model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
-    // Apply rotation in XYZ order (pitch, yaw, roll)
-    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)); // pitch
-    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)); // yaw
-    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)); // roll
-    model = glm::scale(model, scale);
+    draw(shader, buildModelMatrix(position, rotation, scale));
+}
 
+void Mesh::draw(const ShaderProgram &shader, const glm::mat4 &model) const {
     shader.use();
     shader.setMat4("model", model);
     shader.setVec4("color", color);
-    shader.setBool("textured", hasTexture);
+    // mesh_lighting variants are compiled textured or not instead of branching on it
+    if (shader.hasUniform("textured")) {
+        shader.setBool("textured", hasTexture);
+    }
 
     if (hasTexture && texture) {
-        glActiveTexture(GL_TEXTURE0);
-        texture->bind(); // calls glBindTexture under the hood
+        texture->bind(0); // elided by RenderState when already bound
         shader.setInt("textureSampler", 0);
     }
 
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<int>(indexCount), GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
+    // no unbinding afterwards: the next draw rebinds whatever it needs and RenderState skips the rest
+    const Geometry &geo = geometry();
+    geo.bind();
+    geo.draw();
+}
 
-    if (hasTexture) {
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
+glm::mat4 Mesh::buildModelMatrix(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale) {
+    auto model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    // Apply rotation in XYZ order (pitch, yaw, roll)
+    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)); // pitch
+    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)); // yaw
+    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)); // roll
+    model = glm::scale(model, scale);
+    return model;
 }
@@ -9,8 +9,10 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include "Geometry.h"
 #include "../graphic/ShaderProgram.h"
 #include "../graphic/Texture.h"
+#include "../../utilities/SmartPointer.h"
 
 class Mesh {
 public:
@@ -47,17 +49,23 @@ public:
     // Draw the mesh (builds model matrix, sets "model" uniform, binds VAO)
     void draw(const ShaderProgram &shader) const;
 
-protected:
-    // Must be implemented by derived classes to upload vertex/index data
-    virtual void setupMesh() = 0;
+    // Draw the mesh with an already built model matrix, ignoring the local transform state
+    void draw(const ShaderProgram &shader, const glm::mat4 &model) const;
+
+    // Shared GPU geometry of this mesh, acquired from the GeometryRegistry on first use
+    [[nodiscard]] const Geometry &geometry() const;
 
-    // GPU handles
-    GLuint VAO = 0;
-    GLuint VBO = 0;
-    GLuint EBO = 0;
+    // Model matrix used by both the per-entity and the instanced path (XYZ rotation order, in degrees)
+    [[nodiscard]] static glm::mat4 buildModelMatrix(const glm::vec3 &position,
+                                                    const glm::vec3 &rotation,
+                                                    const glm::vec3 &scale);
+
+protected:
+    // Must be implemented by derived classes to return the (shared) geometry they draw
+    [[nodiscard]] virtual ref<Geometry> acquireGeometry() const = 0;
 
-    // Number of indices to draw
-    GLuint indexCount;
+    // Shared GPU geometry; empty until the first draw so creating a mesh never touches GL
+    mutable ref<Geometry> _geometry;
 
     // Local transform state
     glm::vec3 position = glm::vec3(0.0f);
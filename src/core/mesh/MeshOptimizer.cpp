@@ -0,0 +1,248 @@
+/**
+ * @file    MeshOptimizer.cpp
+ * @brief   Implementation file for the MeshOptimizer class.
+ * @details This file contains the implementation of the MeshOptimizer class. The vertex cache optimisation follows
+ *          Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" with his published scoring constants.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <glm/gtc/packing.hpp>
+
+namespace {
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    float vertexScore(const int cachePosition, const std::uint32_t remainingTriangles) {
+        if (remainingTriangles == 0) {
+            // no triangle needs this vertex any more
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // the triangle just emitted; fixed score so its own vertices aren't favoured too much
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scale = 1.0f / static_cast<float>(MeshOptimizer::CACHE_SIZE - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, CACHE_DECAY_POWER);
+            }
+        }
+
+        // boost vertices with few triangles left, so lone triangles are finished instead of left behind
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int> &indices, const std::size_t vertexCount) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+
+    // vertex -> triangles adjacency, packed; the first `remaining[v]` entries are the triangles not yet emitted
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+        ++remaining[indices[i]];
+    }
+    std::vector<std::uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+    }
+    std::vector<std::uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            for (int corner = 0; corner < 3; ++corner) {
+                adjacency[fill[indices[t * 3 + corner]]++] = static_cast<std::uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        score[v] = vertexScore(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+
+    // a little longer than CACHE_SIZE, the triangle being added pushes up to three vertices in
+    std::vector<std::uint32_t> cache, nextCache;
+    cache.reserve(CACHE_SIZE + 3);
+    nextCache.reserve(CACHE_SIZE + 3);
+
+    std::size_t scanCursor = 0;
+    std::int64_t best = -1;
+
+    for (std::size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (best < 0) {
+            // nothing in the cache touches a pending triangle; start over from the next one in file order
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            best = static_cast<std::int64_t>(scanCursor);
+        }
+
+        const auto triangle = static_cast<std::size_t>(best);
+        emitted[triangle] = true;
+
+        nextCache.clear();
+        for (int corner = 0; corner < 3; ++corner) {
+            const std::uint32_t v = indices[triangle * 3 + corner];
+            output.push_back(v);
+            nextCache.push_back(v);
+
+            // drop the triangle from the vertex's pending list
+            const std::uint32_t begin = adjacencyStart[v];
+            const std::uint32_t end = begin + remaining[v];
+            for (std::uint32_t i = begin; i < end; ++i) {
+                if (adjacency[i] == triangle) {
+                    std::swap(adjacency[i], adjacency[end - 1]);
+                    break;
+                }
+            }
+            --remaining[v];
+        }
+        for (const std::uint32_t v: cache) {
+            if (v != nextCache[0] && v != nextCache[1] && v != nextCache[2]) {
+                nextCache.push_back(v);
+            }
+        }
+
+        // rescore everything that was or is in the cache; the ones pushed out lose their cache bonus
+        for (std::size_t i = 0; i < nextCache.size(); ++i) {
+            cachePosition[nextCache[i]] = i < CACHE_SIZE ? static_cast<int>(i) : -1;
+        }
+        for (const std::uint32_t v: nextCache) {
+            const float updated = vertexScore(cachePosition[v], remaining[v]);
+            const float delta = updated - score[v];
+            score[v] = updated;
+
+            const std::uint32_t begin = adjacencyStart[v];
+            for (std::uint32_t i = begin; i < begin + remaining[v]; ++i) {
+                triangleScore[adjacency[i]] += delta;
+            }
+        }
+
+        // the next triangle is the best one touching the cache, once all of its corners are rescored
+        best = -1;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (const std::uint32_t v: nextCache) {
+            const std::uint32_t begin = adjacencyStart[v];
+            for (std::uint32_t i = begin; i < begin + remaining[v]; ++i) {
+                if (const std::uint32_t t = adjacency[i]; triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        if (nextCache.size() > CACHE_SIZE) {
+            nextCache.resize(CACHE_SIZE);
+        }
+        std::swap(cache, nextCache);
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(GeometryData &data) {
+    constexpr std::size_t floatsPerVertex = 3 + 3 + 2;
+    constexpr auto unused = std::numeric_limits<unsigned int>::max();
+
+    const std::size_t vertexCount = data.vertices.size() / floatsPerVertex;
+    std::vector<unsigned int> remap(vertexCount, unused);
+    std::vector<float> vertices;
+    vertices.reserve(data.vertices.size());
+
+    unsigned int next = 0;
+    for (unsigned int &index: data.indices) {
+        if (remap[index] == unused) {
+            remap[index] = next++;
+            const auto source = data.vertices.begin() + static_cast<std::ptrdiff_t>(index * floatsPerVertex);
+            vertices.insert(vertices.end(), source, source + floatsPerVertex);
+        }
+        index = remap[index];
+    }
+
+    data.vertices.swap(vertices);
+}
+
+void MeshOptimizer::optimize(GeometryData &data) {
+    optimizeVertexCache(data.indices, data.vertices.size() / (3 + 3 + 2));
+    optimizeVertexFetch(data);
+}
+
+float MeshOptimizer::getACMR(const std::vector<unsigned int> &indices, const std::size_t cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+
+    std::deque<unsigned int> fifo;
+    std::size_t misses = 0;
+    for (const unsigned int index: indices) {
+        if (std::find(fifo.begin(), fifo.end(), index) == fifo.end()) {
+            ++misses;
+            fifo.push_back(index);
+            if (fifo.size() > cacheSize) {
+                fifo.pop_front();
+            }
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+std::vector<unsigned char> MeshOptimizer::quantize(const std::vector<float> &vertices, const VertexFormat format) {
+    constexpr std::size_t floatsPerVertex = 3 + 3 + 2;
+    const std::size_t vertexCount = vertices.size() / floatsPerVertex;
+    const VertexLayout layout = VertexLayout::get(format);
+
+    std::vector<unsigned char> packed(vertexCount * layout.stride);
+    if (format == VertexFormat::Float32) {
+        std::memcpy(packed.data(), vertices.data(), packed.size());
+        return packed;
+    }
+
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const float *source = &vertices[v * floatsPerVertex];
+        unsigned char *target = &packed[v * layout.stride];
+
+        if (layout.position.type == GL_HALF_FLOAT) {
+            const std::uint16_t position[4] = {
+                glm::packHalf1x16(source[0]), glm::packHalf1x16(source[1]), glm::packHalf1x16(source[2]),
+                glm::packHalf1x16(1.0f)
+            };
+            std::memcpy(target + layout.position.offset, position, sizeof(position));
+        } else {
+            std::memcpy(target + layout.position.offset, source, 3 * sizeof(float));
+        }
+
+        // x in the low bits, matching GL_INT_2_10_10_10_REV
+        const std::uint32_t normal = glm::packSnorm3x10_1x2(glm::vec4(source[3], source[4], source[5], 0.0f));
+        std::memcpy(target + layout.normal.offset, &normal, sizeof(normal));
+
+        const std::uint16_t texCoords[2] = {glm::packHalf1x16(source[6]), glm::packHalf1x16(source[7])};
+        std::memcpy(target + layout.texCoords.offset, texCoords, sizeof(texCoords));
+    }
+
+    return packed;
+}
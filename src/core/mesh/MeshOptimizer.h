@@ -0,0 +1,43 @@
+/**
+ * @file    MeshOptimizer.h
+ * @brief   Header file for the MeshOptimizer class.
+ * @details This file contains the definition of the MeshOptimizer class which prepares indexed meshes for the GPU:
+ *          triangles are reordered for the post-transform vertex cache (Forsyth's linear-speed algorithm),
+ *          vertices are renumbered in first-use order for fetch locality, and float vertices can be repacked into
+ *          one of the compact VertexFormats.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+#include "Geometry.h"
+#include "VertexLayout.h"
+
+class MeshOptimizer {
+public:
+    // Size of the simulated LRU cache the triangle order is scored against
+    static constexpr std::size_t CACHE_SIZE = 32;
+
+    // Reorder triangles in place so neighbouring triangles reuse transformed vertices
+    static void optimizeVertexCache(std::vector<unsigned int> &indices, std::size_t vertexCount);
+
+    // Renumber vertices in the order the indices first use them; unreferenced vertices are dropped
+    static void optimizeVertexFetch(GeometryData &data);
+
+    // optimizeVertexCache() followed by optimizeVertexFetch()
+    static void optimize(GeometryData &data);
+
+    // Average cache miss ratio: vertex shader runs per triangle with a FIFO cache of `cacheSize` entries.
+    // 3.0 means no reuse at all, ~0.6 is about as good as real meshes get.
+    static float getACMR(const std::vector<unsigned int> &indices, std::size_t cacheSize = 16);
+
+    // Repack interleaved float vertices (position, normal, texcoord) into `format`
+    static std::vector<unsigned char> quantize(const std::vector<float> &vertices, VertexFormat format);
+};
+
+
+#endif //MESHOPTIMIZER_H
@@ -18,8 +18,14 @@ public:
 
     ~MeshQuad() override;
 
+    // Unit quad in the XY plane facing +Z
+    [[nodiscard]] static GeometryData buildGeometry();
+
+    // The single quad geometry shared by every MeshQuad and the instanced renderer
+    [[nodiscard]] static ref<Geometry> sharedGeometry();
+
 protected:
-    void setupMesh() override;
+    [[nodiscard]] ref<Geometry> acquireGeometry() const override;
 };
 
 
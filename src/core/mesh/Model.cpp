@@ -8,151 +8,116 @@
  */
 
 #include "Model.h"
+#include "MeshOptimizer.h"
+#include "ObjParser.h"
+#include "../graphic/RenderState.h"
 #include <rapidjson/document.h>
-#include <sstream>
-#include <fstream>
+#include <filesystem>
 
-// split
-//
-// Params:  s - string to split
-//		    t - string to split (ie. delimiter)
-//
-//Result:  Splits string according to some substring and returns it as a vector.
-std::vector<std::string> split(std::string s, std::string t) {
-    std::vector<std::string> res;
-    while (true) {
-        const int pos = s.find(t);
-        if (pos == -1) {
-            res.push_back(s);
-            break;
+Model::Model() : _loaded(false) {
+}
+
+Model::~Model() = default;
+
+bool Model::loadOBJ(const std::string &filename, const VertexFormat format) {
+    const std::string cookedFilename = getCookedPath(filename);
+
+    // a cooked mesh at least as new as its source skips the text parse entirely
+    std::error_code error;
+    const auto sourceTime = std::filesystem::last_write_time(filename, error);
+    if (!error) {
+        const auto cookedTime = std::filesystem::last_write_time(cookedFilename, error);
+        CookedMesh cooked;
+        if (!error && cookedTime >= sourceTime && cooked.open(cookedFilename) && cooked.getVertexFormat() == format) {
+            _upload(cooked, cookedFilename);
+            return (_loaded = true);
         }
-        res.push_back(s.substr(0, pos));
-        s = s.substr(pos + 1, s.size() - pos - 1);
     }
-    return res;
-}
 
-Model::Model() : _VAO(0), _VBO(0), _EBO(0) {
-    glGenVertexArrays(1, &_VAO);
-    glGenBuffers(1, &_VBO);
-    glGenBuffers(1, &_EBO);
+    GeometryData data;
+    if (!parseOBJ(filename, data)) {
+        return false;
+    }
+
+    MeshOptimizer::optimize(data);
+    _upload(data, format);
+
+    // best effort: the next run picks this up, this one already has its mesh
+    if (!CookedMesh::write(cookedFilename, data.vertices, data.indices, format)) {
+        LOG_WARN("Could not cook {} into {}", filename, cookedFilename);
+    }
+
+    return (_loaded = true);
 }
 
-Model::~Model() {
-    glDeleteVertexArrays(1, &_VAO);
-    glDeleteBuffers(1, &_VBO);
-    glDeleteBuffers(1, &_EBO);
+bool Model::loadCooked(const std::string &filename) {
+    CookedMesh cooked;
+    if (!cooked.open(filename)) {
+        return false;
+    }
+
+    _upload(cooked, filename);
+    return (_loaded = true);
 }
 
-bool Model::loadOBJ(const std::string &filename) {
-    std::vector<unsigned int> vertexIndices, uvIndices, normalIndices;
-    std::vector<glm::vec3> tempVertices;
-    std::vector<glm::vec2> tempUVs;
-    std::vector<glm::vec3> tempNormals;
-
-    if (filename.find(".obj") != std::string::npos) {
-        std::ifstream fin(filename, std::ios::in);
-        if (!fin) {
-            LOG_ERROR("Unable to open file {}", filename);
-            return false;
-        }
+bool Model::parseOBJ(const std::string &filename, GeometryData &data) {
+    if (filename.find(".obj") == std::string::npos) {
+        return false;
+    }
+    return ObjParser::parse(filename, data);
+}
 
-        LOG_INFO("Loading OBJ file {}...", filename);
-
-        std::string lineBuffer;
-
-        while (std::getline(fin, lineBuffer)) {
-            std::stringstream ss(lineBuffer);
-            std::string cmd;
-            ss >> cmd;
-
-            if (cmd == "v") {
-                glm::vec3 vertex;
-                int dim = 0;
-                while (dim < 3 && ss >> vertex[dim]) {
-                    dim++;
-                }
-                tempVertices.push_back(vertex);
-            } else if (cmd == "vt") {
-                glm::vec2 uv;
-                int dim = 0;
-                while (dim < 2 && ss >> uv[dim])
-                    dim++;
-
-                tempUVs.push_back(uv);
-            } else if (cmd == "vn") {
-                glm::vec3 normal;
-                int dim = 0;
-                while (dim < 3 && ss >> normal[dim])
-                    dim++;
-                normal = glm::normalize(normal);
-                tempNormals.push_back(normal);
-            } else if (cmd == "f") {
-                std::string faceData;
-                int vertexIndex, uvIndex, normalIndex;
-
-                while (ss >> faceData) {
-                    std::vector<std::string> data = split(faceData, "/");
-
-                    if (data[0].size() > 0) {
-                        sscanf(data[0].c_str(), "%d", &vertexIndex);
-                        vertexIndices.push_back(vertexIndex);
-                    }
-
-                    if (data.size() >= 1) {
-                        // Is face format v//vn?  If data[1] is empty string then
-                        // this vertex has no texture coordinate
-                        if (data[1].size() > 0) {
-                            sscanf(data[1].c_str(), "%d", &uvIndex);
-                            uvIndices.push_back(uvIndex);
-                        }
-                    }
-
-                    if (data.size() >= 2) {
-                        // Does this vertex have a normal?
-                        if (data[2].size() > 0) {
-                            sscanf(data[2].c_str(), "%d", &normalIndex);
-                            normalIndices.push_back(normalIndex);
-                        }
-                    }
-                }
-            }
-        }
+bool Model::cook(const std::string &objFilename, const std::string &cookedFilename, const VertexFormat format) {
+    GeometryData data;
+    if (!parseOBJ(objFilename, data)) {
+        return false;
+    }
 
-        // close file
-        fin.close();
+    const float acmr = MeshOptimizer::getACMR(data.indices);
+    MeshOptimizer::optimize(data);
+    LOG_INFO("Optimized {}: ACMR {:.3f} -> {:.3f}, {} bytes per vertex", objFilename, acmr,
+             MeshOptimizer::getACMR(data.indices), VertexLayout::get(format).stride);
 
-        // For each vertex of each triangle
-        for (unsigned int i = 0; i < vertexIndices.size(); i++) {
-            Vertex ModelVertex;
+    return CookedMesh::write(cookedFilename, data.vertices, data.indices, format);
+}
 
-            // Get the attributes using the indices
+void Model::_upload(const GeometryData &data, const VertexFormat format) {
+    const std::vector<unsigned char> vertices = MeshOptimizer::quantize(data.vertices, format);
 
-            if (tempVertices.size() > 0) {
-                glm::vec3 vertex = tempVertices[vertexIndices[i] - 1];
-                ModelVertex.position = vertex;
-            }
+    GeometryView view;
+    view.vertices = vertices.data();
+    view.vertexBytes = static_cast<GLsizeiptr>(vertices.size());
+    view.format = format;
+    view.indices = data.indices.data();
+    view.indexCount = static_cast<GLsizei>(data.indices.size());
+    view.indexType = GL_UNSIGNED_INT;
+    view.boundingSphere = Geometry::computeBoundingSphere(data.vertices);
 
-            if (tempNormals.size() > 0) {
-                glm::vec3 normal = tempNormals[normalIndices[i] - 1];
-                ModelVertex.normal = normal;
-            }
+    _geometry = createScope<Geometry>(view);
+}
 
-            if (tempUVs.size() > 0) {
-                glm::vec2 uv = tempUVs[uvIndices[i] - 1];
-                ModelVertex.texCoords = uv;
-            }
+void Model::_upload(const CookedMesh &cooked, const std::string &filename) {
+    const CookedMeshHeader &header = cooked.getHeader();
 
-            _vertices.push_back(ModelVertex);
-        }
+    GeometryView view;
+    view.vertices = cooked.getVertices();
+    view.vertexBytes = static_cast<GLsizeiptr>(cooked.getVertexBytes());
+    view.format = cooked.getVertexFormat();
+    view.indices = cooked.getIndices();
+    view.indexCount = static_cast<GLsizei>(header.indexCount);
+    view.indexType = cooked.uses32BitIndices() ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    view.boundingSphere = glm::vec4(header.boundingSphere[0], header.boundingSphere[1], header.boundingSphere[2],
+                                    header.boundingSphere[3]);
 
-        // Create and initailize the buffers
-        _setupModel();
+    // glBufferData copies out of the mapping, it can be closed right after
+    _geometry = createScope<Geometry>(view);
 
-        return (_loaded = true);
-    }
+    LOG_INFO("Loaded cooked mesh {} ({} vertices, {} indices, {} bytes per vertex)", filename, header.vertexCount,
+             header.indexCount, header.vertexStride);
+}
 
-    return false;
+std::string Model::getCookedPath(const std::string &objFilename) {
+    return std::filesystem::path(objFilename).replace_extension(".cbmesh").string();
 }
 
 void Model::loadJSON(const std::string& jsonString) {
@@ -195,39 +160,19 @@ void Model::loadJSON(const std::string& jsonString) {
 }
 
 void Model::bind() const {
-    glBindVertexArray(_VAO);
+    if (_geometry) {
+        _geometry->bind();
+    }
 }
 
 void Model::unbind() const {
-    glBindVertexArray(0);
+    RenderState::bindVertexArray(0);
 }
 
 void Model::draw() const {
-    bind();
-    glDrawArrays(GL_TRIANGLES, 0, _vertices.size());
-    unbind();
-}
-
-void Model::_setupModel() {
-    glGenVertexArrays(1, &_VAO);
-    glGenBuffers(1, &_VBO);
-
-    glBindVertexArray(_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-    glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
-
-    // Vertex Positions
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-
-    // Normals attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-
-    // Vertex Texture Coords
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(6 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
-
-    // unbind to make sure other code does not change it somewhere else
-    glBindVertexArray(0);
+    if (!_geometry) {
+        return;
+    }
+    _geometry->bind();
+    _geometry->draw();
 }
@@ -3,6 +3,7 @@
  * @brief   This file contains the declaration of the Model class which is responsible for managing 3D models.
  * @details This file contains the declaration of the Model class which is responsible for managing 3D models.
  *          The Model class provides functionality for loading, binding, and rendering 3D models.
+ *          OBJ files are cooked into a `.cbmesh` next to them on first load and mapped from there afterwards.
 @author  Nur Akmal bin Jalil
 @date    2024-08-03
  */
@@ -14,13 +15,10 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
+#include "CookedMesh.h"
+#include "Geometry.h"
 #include "../../utilities/Logger.h"
-
-struct Vertex {
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 texCoords;
-};
+#include "../../utilities/SmartPointer.h"
 
 class Model {
 public:
@@ -28,7 +26,12 @@ public:
 
     ~Model();
 
-    bool loadOBJ(const std::string &filename);
+    // Load `filename`, going through its cooked `.cbmesh` when that is at least as new as the OBJ and was cooked
+    // in `format`. Freshly parsed meshes are cache and fetch optimized before upload.
+    bool loadOBJ(const std::string &filename, VertexFormat format = VertexFormat::Compact);
+
+    // Map a `.cbmesh` and upload it straight from the mapping
+    bool loadCooked(const std::string &filename);
 
     void loadJSON(const std::string &jsonString);
 
@@ -38,16 +41,25 @@ public:
 
     void draw() const;
 
+    // Parse an OBJ into indexed, deduplicated vertices (one vertex per distinct v/vt/vn triple)
+    static bool parseOBJ(const std::string &filename, GeometryData &data);
+
+    // Convert an OBJ into an optimized mesh in the cooked binary format
+    static bool cook(const std::string &objFilename, const std::string &cookedFilename,
+                     VertexFormat format = VertexFormat::Compact);
+
+    // `path/name.obj` -> `path/name.cbmesh`
+    static std::string getCookedPath(const std::string &objFilename);
+
 private:
-    void _setupModel();
+    // Upload optimized float vertices in `format`
+    void _upload(const GeometryData &data, VertexFormat format);
 
-    bool _loaded;
-    std::vector<Vertex> _vertices;
-    std::vector<glm::vec2> _texCoords;
-    std::vector<glm::vec3> _normals;
-    std::vector<GLuint> _indices;
+    // Upload straight from the mapping of a cooked mesh, `filename` is only for the log
+    void _upload(const CookedMesh &cooked, const std::string &filename);
 
-    GLuint _VAO, _VBO, _EBO;
+    bool _loaded;
+    scope<Geometry> _geometry;
 };
 
 
@@ -0,0 +1,371 @@
+/**
+ * @file    ObjParser.cpp
+ * @brief   Implementation file for the ObjParser class.
+ * @details This file contains the implementation of the ObjParser class which turns Wavefront OBJ text into
+ *          indexed GeometryData using parallel, memory-mapped parsing and hashed vertex deduplication.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "ObjParser.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "../../utilities/Logger.h"
+#include "../../utilities/MappedFile.h"
+
+namespace {
+    enum Attribute { POSITION = 0, TEXCOORD = 1, NORMAL = 2 };
+
+    // One polygon corner as written in the file. 0 means "not given" (OBJ indices start at 1).
+    // Negative indices can't be resolved while the chunk is parsed, so they are stored relative to the chunk
+    // (0-based, possibly negative when they reach into an earlier chunk) and flagged in `relative`.
+    struct Corner {
+        std::int32_t index[3] = {0, 0, 0};
+        std::uint8_t relative = 0;
+    };
+
+    struct Chunk {
+        std::vector<float> positions; // xyz
+        std::vector<float> texcoords; // uv
+        std::vector<float> normals;   // xyz
+        std::vector<Corner> corners;
+        std::vector<std::uint32_t> faceSizes;
+        std::size_t base[3] = {0, 0, 0}; // attributes defined by earlier chunks
+        std::size_t errorLine = 0;       // 1-based line within the chunk, 0 if it parsed cleanly
+    };
+
+    bool isSpace(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char *skipSpaces(const char *p, const char *end) {
+        while (p < end && isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    const char *parseFloat(const char *p, const char *end, float &value) {
+        p = skipSpaces(p, end);
+        // from_chars rejects an explicit plus sign
+        if (p < end && *p == '+') {
+            ++p;
+        }
+        const auto [next, error] = std::from_chars(p, end, value);
+        return error == std::errc() ? next : nullptr;
+    }
+
+    const char *parseIndex(const char *p, const char *end, std::int32_t &value) {
+        const auto [next, error] = std::from_chars(p, end, value);
+        return error == std::errc() ? next : nullptr;
+    }
+
+    // Read up to `count` floats, missing trailing components stay 0 (e.g. `vt u` without v)
+    const char *parseFloats(const char *p, const char *end, float *values, const int count) {
+        for (int i = 0; i < count; ++i) {
+            values[i] = 0.0f;
+        }
+        for (int i = 0; i < count; ++i) {
+            const char *next = parseFloat(p, end, values[i]);
+            if (!next) {
+                // at least one component is required
+                return i == 0 ? nullptr : p;
+            }
+            p = next;
+        }
+        return p;
+    }
+
+    // Parse `v`, `v/vt`, `v//vn` or `v/vt/vn`
+    const char *parseCorner(const char *p, const char *end, const std::size_t (&counts)[3], Corner &corner) {
+        for (int attribute = POSITION; attribute <= NORMAL; ++attribute) {
+            if (attribute != POSITION) {
+                if (p >= end || *p != '/') {
+                    break;
+                }
+                ++p;
+                // empty slot, as in `v//vn`
+                if (p < end && *p == '/') {
+                    continue;
+                }
+                if (p >= end || isSpace(*p) || *p == '\n') {
+                    break;
+                }
+            }
+
+            std::int32_t value = 0;
+            p = parseIndex(p, end, value);
+            if (!p || value == 0) {
+                return nullptr;
+            }
+
+            if (value < 0) {
+                const auto local = static_cast<std::int64_t>(counts[attribute]) + value;
+                corner.index[attribute] = static_cast<std::int32_t>(local);
+                corner.relative |= static_cast<std::uint8_t>(1u << attribute);
+            } else {
+                corner.index[attribute] = value;
+            }
+        }
+        return p;
+    }
+
+    void parseChunk(const char *p, const char *end, Chunk &chunk) {
+        std::size_t counts[3] = {0, 0, 0};
+        std::size_t line = 0;
+
+        while (p < end) {
+            ++line;
+            const char *lineEnd = std::find(p, end, '\n');
+            const char *cursor = skipSpaces(p, lineEnd);
+            p = lineEnd < end ? lineEnd + 1 : end;
+
+            if (cursor + 1 >= lineEnd) {
+                continue;
+            }
+
+            bool ok = true;
+            if (cursor[0] == 'v' && isSpace(cursor[1])) {
+                float position[3];
+                ok = parseFloats(cursor + 2, lineEnd, position, 3) != nullptr;
+                chunk.positions.insert(chunk.positions.end(), position, position + 3);
+                ++counts[POSITION];
+            } else if (cursor[0] == 'v' && cursor[1] == 't' && cursor + 2 < lineEnd && isSpace(cursor[2])) {
+                float uv[2];
+                ok = parseFloats(cursor + 3, lineEnd, uv, 2) != nullptr;
+                chunk.texcoords.insert(chunk.texcoords.end(), uv, uv + 2);
+                ++counts[TEXCOORD];
+            } else if (cursor[0] == 'v' && cursor[1] == 'n' && cursor + 2 < lineEnd && isSpace(cursor[2])) {
+                float normal[3];
+                ok = parseFloats(cursor + 3, lineEnd, normal, 3) != nullptr;
+                if (const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                                                   normal[2] * normal[2]); length > 0.0f) {
+                    normal[0] /= length;
+                    normal[1] /= length;
+                    normal[2] /= length;
+                }
+                chunk.normals.insert(chunk.normals.end(), normal, normal + 3);
+                ++counts[NORMAL];
+            } else if (cursor[0] == 'f' && isSpace(cursor[1])) {
+                std::uint32_t size = 0;
+                cursor = skipSpaces(cursor + 2, lineEnd);
+                while (ok && cursor < lineEnd) {
+                    Corner corner;
+                    cursor = parseCorner(cursor, lineEnd, counts, corner);
+                    if (!cursor) {
+                        ok = false;
+                        break;
+                    }
+                    chunk.corners.push_back(corner);
+                    ++size;
+                    cursor = skipSpaces(cursor, lineEnd);
+                }
+                // anything below a triangle is a point or line element, which we don't draw
+                if (ok && size < 3) {
+                    chunk.corners.resize(chunk.corners.size() - size);
+                } else if (ok) {
+                    chunk.faceSizes.push_back(size);
+                }
+            }
+            // comments, groups, objects, materials and smoothing groups are ignored
+
+            if (!ok) {
+                chunk.errorLine = line;
+                return;
+            }
+        }
+    }
+
+    // Open addressing table from a resolved v/vt/vn triple to its output vertex
+    class VertexTable {
+    public:
+        explicit VertexTable(const std::size_t expected)
+            : _slots(std::bit_ceil(std::max<std::size_t>(expected * 2, 16)), EMPTY),
+              _mask(_slots.size() - 1) {
+            _keys.reserve(expected);
+        }
+
+        // Returns the vertex for `key` and whether it was just added
+        std::pair<std::uint32_t, bool> insert(const std::array<std::uint32_t, 3> &key) {
+            std::size_t slot = _hash(key) & _mask;
+            while (_slots[slot] != EMPTY) {
+                if (_keys[_slots[slot]] == key) {
+                    return {_slots[slot], false};
+                }
+                slot = (slot + 1) & _mask;
+            }
+            const auto vertex = static_cast<std::uint32_t>(_keys.size());
+            _slots[slot] = vertex;
+            _keys.push_back(key);
+            return {vertex, true};
+        }
+
+    private:
+        static constexpr std::uint32_t EMPTY = std::numeric_limits<std::uint32_t>::max();
+
+        static std::size_t _hash(const std::array<std::uint32_t, 3> &key) {
+            std::uint64_t h = key[0] * 0x9E3779B97F4A7C15ull;
+            h ^= (key[1] + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+            h ^= (key[2] + 0x165667B19E3779F9ull) * 0x85EBCA77C2B2AE63ull;
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+
+        std::vector<std::uint32_t> _slots;
+        std::size_t _mask;
+        std::vector<std::array<std::uint32_t, 3> > _keys;
+    };
+}
+
+bool ObjParser::parse(const std::string &filename, GeometryData &data) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG_ERROR("Unable to open file {}", filename);
+        return false;
+    }
+
+    LOG_INFO("Loading OBJ file {}...", filename);
+    return parse(reinterpret_cast<const char *>(file.data()), file.size(), data, filename);
+}
+
+bool ObjParser::parse(const char *text, const std::size_t size, GeometryData &data, const std::string &name) {
+    const char *end = text + size;
+
+    // split into line-aligned chunks, one per worker
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunkCount = std::clamp<std::size_t>(size / MIN_CHUNK_BYTES, 1, hardware);
+
+    std::vector<const char *> starts{text};
+    for (std::size_t i = 1; i < chunkCount; ++i) {
+        const char *start = std::max(starts.back(), text + size * i / chunkCount);
+        start = std::find(start, end, '\n');
+        if (start == end) {
+            break;
+        }
+        starts.push_back(start + 1);
+    }
+    starts.push_back(end);
+
+    std::vector<Chunk> chunks(starts.size() - 1);
+    {
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < chunks.size(); ++i) {
+            workers.emplace_back(parseChunk, starts[i], starts[i + 1], std::ref(chunks[i]));
+        }
+        parseChunk(starts[0], starts[1], chunks[0]);
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    // attribute bases per chunk, so relative indices can be made absolute
+    std::size_t totals[3] = {0, 0, 0};
+    std::size_t cornerCount = 0;
+    std::size_t lineBase = 0;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        Chunk &chunk = chunks[i];
+        if (chunk.errorLine != 0) {
+            lineBase += static_cast<std::size_t>(std::count(starts[0], starts[i], '\n'));
+            LOG_ERROR("Malformed OBJ data in {} at line {}", name, lineBase + chunk.errorLine);
+            return false;
+        }
+        std::copy(std::begin(totals), std::end(totals), std::begin(chunk.base));
+        totals[POSITION] += chunk.positions.size() / 3;
+        totals[TEXCOORD] += chunk.texcoords.size() / 2;
+        totals[NORMAL] += chunk.normals.size() / 3;
+        cornerCount += chunk.corners.size();
+    }
+
+    if (cornerCount == 0) {
+        LOG_ERROR("OBJ file {} has no faces", name);
+        return false;
+    }
+
+    // gather the attribute streams back into file order
+    std::vector<float> positions, texcoords, normals;
+    positions.reserve(totals[POSITION] * 3);
+    texcoords.reserve(totals[TEXCOORD] * 2);
+    normals.reserve(totals[NORMAL] * 3);
+    for (const Chunk &chunk: chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+    }
+
+    // resolve, deduplicate and fan triangulate; sequential so vertex order is the same on every run
+    VertexTable table(cornerCount);
+    constexpr std::uint32_t missing = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> polygon;
+
+    data.vertices.clear();
+    data.indices.clear();
+    data.vertices.reserve(cornerCount * 8);
+    data.indices.reserve(cornerCount * 3);
+
+    for (const Chunk &chunk: chunks) {
+        std::size_t next = 0;
+        for (const std::uint32_t faceSize: chunk.faceSizes) {
+            polygon.clear();
+            for (std::uint32_t c = 0; c < faceSize; ++c) {
+                const Corner &corner = chunk.corners[next++];
+                std::array<std::uint32_t, 3> key{};
+                for (int attribute = POSITION; attribute <= NORMAL; ++attribute) {
+                    const std::int64_t raw = corner.index[attribute];
+                    if (raw == 0 && !(corner.relative & (1u << attribute))) {
+                        key[attribute] = missing;
+                        continue;
+                    }
+                    const std::int64_t absolute = (corner.relative & (1u << attribute))
+                                                      ? static_cast<std::int64_t>(chunk.base[attribute]) + raw
+                                                      : raw - 1;
+                    if (absolute < 0 || absolute >= static_cast<std::int64_t>(totals[attribute])) {
+                        LOG_ERROR("OBJ file {} references a missing {} ({})", name,
+                                  attribute == POSITION ? "vertex" : attribute == TEXCOORD ? "texcoord" : "normal",
+                                  corner.index[attribute]);
+                        return false;
+                    }
+                    key[attribute] = static_cast<std::uint32_t>(absolute);
+                }
+                if (key[POSITION] == missing) {
+                    LOG_ERROR("OBJ file {} has a face corner without a vertex", name);
+                    return false;
+                }
+
+                const auto [vertex, inserted] = table.insert(key);
+                if (inserted) {
+                    const float *position = &positions[key[POSITION] * 3];
+                    data.vertices.insert(data.vertices.end(), position, position + 3);
+                    if (key[NORMAL] != missing) {
+                        const float *normal = &normals[key[NORMAL] * 3];
+                        data.vertices.insert(data.vertices.end(), normal, normal + 3);
+                    } else {
+                        data.vertices.insert(data.vertices.end(), {0.0f, 0.0f, 0.0f});
+                    }
+                    if (key[TEXCOORD] != missing) {
+                        const float *uv = &texcoords[key[TEXCOORD] * 2];
+                        data.vertices.insert(data.vertices.end(), uv, uv + 2);
+                    } else {
+                        data.vertices.insert(data.vertices.end(), {0.0f, 0.0f});
+                    }
+                }
+                polygon.push_back(vertex);
+            }
+
+            // fan around the first corner; exact for convex polygons, which is what exporters write
+            for (std::size_t i = 1; i + 1 < polygon.size(); ++i) {
+                data.indices.insert(data.indices.end(), {polygon[0], polygon[i], polygon[i + 1]});
+            }
+        }
+    }
+
+    LOG_INFO("Parsed {}: {} unique vertices for {} indices ({} chunks)", name, data.vertices.size() / 8,
+             data.indices.size(), chunks.size());
+    return true;
+}
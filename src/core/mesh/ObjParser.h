@@ -0,0 +1,33 @@
+/**
+ * @file    ObjParser.h
+ * @brief   Header file for the ObjParser class.
+ * @details This file contains the definition of the ObjParser class which turns Wavefront OBJ text into indexed
+ *          GeometryData. The file is memory mapped and split into line-aligned chunks that are parsed on worker
+ *          threads with std::from_chars; relative (negative) indices are resolved once every chunk knows how many
+ *          positions, texcoords and normals came before it. Polygons are fan triangulated and every distinct
+ *          v/vt/vn triple becomes one vertex through a hashed deduplication pass.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef OBJPARSER_H
+#define OBJPARSER_H
+
+#include <cstddef>
+#include <string>
+#include "Geometry.h"
+
+class ObjParser {
+public:
+    // Files smaller than this are parsed on the calling thread only
+    static constexpr std::size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+    // Parse the OBJ at `filename`; `data` receives interleaved position/normal/texcoord vertices and triangles
+    static bool parse(const std::string &filename, GeometryData &data);
+
+    // Parse OBJ text already in memory; `name` only appears in log messages
+    static bool parse(const char *text, std::size_t size, GeometryData &data, const std::string &name = "<memory>");
+};
+
+
+#endif //OBJPARSER_H
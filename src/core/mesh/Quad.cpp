@@ -70,5 +70,4 @@ void Quad::_updateBuffer() {
 void Quad::draw() const {
     _vao.bind();
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    _vao.unbind();
 }
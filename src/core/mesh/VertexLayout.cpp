@@ -0,0 +1,50 @@
+/**
+ * @file    VertexLayout.cpp
+ * @brief   Implementation file for the VertexLayout struct.
+ * @details This file contains the attribute tables of every VertexFormat.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "VertexLayout.h"
+
+VertexLayout VertexLayout::get(const VertexFormat format) {
+    switch (format) {
+        case VertexFormat::Compact:
+            return {
+                {3, GL_FLOAT, GL_FALSE, 0},
+                {4, GL_INT_2_10_10_10_REV, GL_TRUE, 12},
+                {2, GL_HALF_FLOAT, GL_FALSE, 16},
+                20
+            };
+        case VertexFormat::CompactHalfPositions:
+            return {
+                {3, GL_HALF_FLOAT, GL_FALSE, 0},
+                {4, GL_INT_2_10_10_10_REV, GL_TRUE, 8},
+                {2, GL_HALF_FLOAT, GL_FALSE, 12},
+                16
+            };
+        case VertexFormat::Float32:
+        default:
+            return {
+                {3, GL_FLOAT, GL_FALSE, 0},
+                {3, GL_FLOAT, GL_FALSE, 12},
+                {2, GL_FLOAT, GL_FALSE, 24},
+                32
+            };
+    }
+}
+
+void VertexLayout::apply() const {
+    // vertex layout:
+    //   0: position (vec3)
+    //   1: normal   (vec3, packed formats carry an unused w)
+    //   2: texcoord (vec2)
+    const VertexAttribute *attributes[] = {&position, &normal, &texCoords};
+    for (GLuint location = 0; location < 3; ++location) {
+        const VertexAttribute &attribute = *attributes[location];
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, attribute.components, attribute.type, attribute.normalized, stride,
+                              reinterpret_cast<void *>(static_cast<std::uintptr_t>(attribute.offset)));
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * @file    VertexLayout.h
+ * @brief   Header file for the VertexLayout struct.
+ * @details This file contains the definition of the VertexFormat enum and the VertexLayout struct which describe
+ *          how the position, normal and texcoord attributes (locations 0-2) are stored in a vertex buffer, and
+ *          set up the matching glVertexAttribPointer calls. Every format decodes to the same shader inputs.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef VERTEXLAYOUT_H
+#define VERTEXLAYOUT_H
+
+#include <glad/glad.h>
+#include <cstdint>
+
+enum class VertexFormat : std::uint32_t {
+    // position float3, normal float3, texcoord float2 (32 bytes)
+    Float32 = 0,
+    // position float3, normal 10:10:10:2 snorm, texcoord half2 (20 bytes)
+    Compact = 1,
+    // position half4 (w = 1), normal 10:10:10:2 snorm, texcoord half2 (16 bytes); for meshes near the origin
+    CompactHalfPositions = 2,
+};
+
+struct VertexAttribute {
+    GLint components;
+    GLenum type;
+    GLboolean normalized;
+    GLuint offset;
+};
+
+struct VertexLayout {
+    VertexAttribute position;
+    VertexAttribute normal;
+    VertexAttribute texCoords;
+    GLsizei stride;
+
+    static VertexLayout get(VertexFormat format);
+
+    // Point locations 0-2 at the bound GL_ARRAY_BUFFER; the VAO must be bound
+    void apply() const;
+};
+
+
+#endif //VERTEXLAYOUT_H
@@ -9,10 +9,48 @@
  */
 
 #include "AssetManager.h"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <ranges>
 #include <SDL2/SDL_image.h>
+#include "../../Config.h"
+#include "../../utilities/AssetsManager.h"
 #include "../../utilities/Logger.h"
 
+namespace {
+    constexpr std::array IMAGE_EXTENSIONS{".png", ".jpg", ".jpeg"};
+    constexpr std::array AUDIO_EXTENSIONS{".wav", ".mp3", ".ogg"};
+    constexpr std::array FONT_EXTENSIONS{".ttf"};
+
+    std::size_t textureBytes(SDL_Texture *texture) {
+        Uint32 format = 0;
+        int width = 0;
+        int height = 0;
+        SDL_QueryTexture(texture, &format, nullptr, &width, &height);
+        return static_cast<std::size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+    }
+
+    // freeing a chunk halts the channels playing it, so those are never evicted
+    bool isPlaying(const Mix_Chunk *chunk) {
+        const int channels = Mix_AllocateChannels(-1);
+        for (int channel = 0; channel < channels; ++channel) {
+            if (Mix_Playing(channel) && Mix_GetChunk(channel) == chunk) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
 void AssetManager::init(SDL_Renderer *renderer) {
+    _renderer = renderer;
+
+    // a shipped pack already holds everything, and nothing is loaded until it is asked for
+    if (AssetsManager::Get().isPacked()) {
+        return;
+    }
+
     // check if the resources folder exists
     if (!std::filesystem::exists("resources")) {
         LOG_WARN("Resources folder not found, resources folder will be created.");
@@ -39,134 +77,270 @@ void AssetManager::init(SDL_Renderer *renderer) {
         // create the fonts folder
         std::filesystem::create_directory("resources/fonts");
     }
+}
 
-    // iterate through the images folder and load all the image files
-    for (const auto &entry: std::filesystem::directory_iterator("resources/images")) {
-        if (entry.is_regular_file()) {
-            // check if the extension is .png, .jpg, or .jpeg
-            if (std::string extension = entry.path().extension().string(); extension != ".png" && extension != ".jpg" &&
-                                                                           extension != ".jpeg") {
-                LOG_WARN("Unsupported image file format: %s", extension);
-                continue;
-            }
+AssetManager &AssetManager::getInstance() {
+    static AssetManager instance;
+    return instance;
+}
 
-            std::string filePath = entry.path().string();
-            std::string relativePath = std::filesystem::relative(entry.path(), "resources/images").string();
-            std::string fileName = relativePath.substr(0, relativePath.find_last_of('.'));
-            // Get relative path without extension
-            SDL_Surface *surface = IMG_Load(filePath.c_str());
-            if (surface == nullptr) {
-                LOG_ERROR("Failed to load image: %s", IMG_GetError());
-            }
-            SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-            if (texture == nullptr) {
-                LOG_ERROR("Failed to create texture: %s", SDL_GetError());
-            }
-            _textures[fileName] = texture;
-            SDL_FreeSurface(surface);
-        }
+AssetManager::~AssetManager() = default;
+
+void AssetManager::cleanup() {
+    LOG_INFO("Freeing {} resident assets ({} bytes)", _resident.size(), _residentBytes);
+    for (auto &resident: _resident | std::views::values) {
+        _free(resident);
     }
+    _resident.clear();
+    _lru.clear();
+    _evicted.clear();
+    _residentBytes = 0;
 
-    // iterate through the audio folder and load all the audio files
-    for (const auto &entry: std::filesystem::directory_iterator("resources/audio")) {
-        if (entry.is_regular_file()) {
-            // check if the extension is .wav, .mp3, or .ogg
-            if (std::string extension = entry.path().extension().string(); extension != ".wav" && extension != ".mp3" &&
-                                                                           extension != ".ogg") {
-                LOG_WARN("Unsupported audio file format: %s", extension);
-                continue;
-            }
+    // fonts opened from these must have been closed by their owners already
+    _buffers.clear();
+}
 
-            std::string filePath = entry.path().string();
-            std::string relativePath = std::filesystem::relative(entry.path(), "resources/audio").string();
-            std::string fileName = relativePath.substr(0, relativePath.find_last_of(
-                                                           '.')); // Get relative path without extension
-            Mix_Music *audio = Mix_LoadMUS(filePath.c_str());
-            Mix_Chunk *sound = Mix_LoadWAV(filePath.c_str());
-            if (audio == nullptr) {
-                LOG_ERROR("Failed to load audio: %s", Mix_GetError());
-            }
-            _audio[fileName] = audio;
-            _sounds[fileName] = sound;
-        }
+void AssetManager::setBudget(const std::size_t bytes) {
+    _budgetBytes = bytes;
+    _evictToBudget();
+}
+
+void AssetManager::pin(const Kind kind, const std::string &filename) {
+    ++_pins[_key(kind, filename)];
+}
+
+void AssetManager::unpin(const Kind kind, const std::string &filename) {
+    if (const auto it = _pins.find(_key(kind, filename)); it != _pins.end() && --it->second <= 0) {
+        _pins.erase(it);
     }
+}
 
-    // iterate through the fonts folder and load all the font files
-    for (const auto &entry: std::filesystem::directory_iterator("resources/fonts")) {
-        if (entry.is_regular_file()) {
-            // check if the extension is .ttf
-            if (std::string extension = entry.path().extension().string(); extension != ".ttf") {
-                LOG_WARN("Unsupported font file format: %s", extension);
-                continue;
-            }
+AssetManager::Stats AssetManager::getStats() const {
+    Stats stats;
+    stats.resident = static_cast<int>(_resident.size());
+    stats.residentBytes = _residentBytes;
+    stats.budgetBytes = _budgetBytes;
+    stats.pinned = static_cast<int>(std::ranges::count_if(_pins | std::views::keys, [this](const std::string &key) {
+        return _resident.contains(key);
+    }));
+    stats.hits = _hits;
+    stats.loads = _loads;
+    stats.reloads = _reloads;
+    stats.evictions = _evictions;
+    return stats;
+}
+
+std::string AssetManager::_key(const Kind kind, const std::string &filename) {
+    // music and sounds share their file names, so the kind is part of the key
+    return std::to_string(static_cast<int>(kind)) + ':' + filename;
+}
+
+AssetManager::Resident *AssetManager::_touch(const std::string &key) {
+    const auto it = _resident.find(key);
+    if (it == _resident.end()) {
+        return nullptr;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lru);
+    ++_hits;
+    return &it->second;
+}
+
+void AssetManager::_insert(const std::string &key, const Handle handle, const std::size_t bytes,
+                           const std::string &path) {
+    _lru.push_front(key);
+    _resident[key] = Resident{handle, bytes, path, _lru.begin()};
+    _residentBytes += bytes;
+
+    ++_loads;
+    if (_evicted.erase(key) > 0) {
+        ++_reloads;
+    }
 
-            std::string filePath = entry.path().string();
-            std::string relativePath = std::filesystem::relative(entry.path(), "resources/fonts").string();
-            std::string fileName = relativePath.substr(0, relativePath.find_last_of(
-                                                           '.')); // Get relative path without extension
+    _evictToBudget();
+}
 
-            _fonts[fileName] = filePath;
+void AssetManager::_evictToBudget() {
+    // the most recently used asset stays even when it alone is over budget, its caller is about to use it
+    auto it = _lru.end();
+    while (_residentBytes > _budgetBytes && it != _lru.begin() && std::prev(it) != _lru.begin()) {
+        --it;
+        const auto resident = _resident.find(*it);
+        if (_pins.contains(*it)) {
+            continue;
+        }
+        if (const auto *chunk = std::get_if<Mix_Chunk *>(&resident->second.handle); chunk && isPlaying(*chunk)) {
+            continue;
+        }
+        // freeing music halts it, same as a chunk
+        if (const auto *music = std::get_if<Mix_Music *>(&resident->second.handle);
+            music && *music == _music && Mix_PlayingMusic()) {
+            continue;
         }
+
+        LOG_INFO("Evicting asset {} ({} bytes)", resident->second.path, resident->second.bytes);
+        _free(resident->second);
+        _residentBytes -= resident->second.bytes;
+        _evicted.insert(*it);
+        _resident.erase(resident);
+        it = _lru.erase(it);
+        ++_evictions;
     }
 }
 
-AssetManager &AssetManager::getInstance() {
-    static AssetManager instance;
-    return instance;
+void AssetManager::_free(Resident &resident) {
+    std::visit([]<typename T>(T *handle) {
+        if constexpr (std::is_same_v<T, SDL_Texture>) {
+            SDL_DestroyTexture(handle);
+        } else if constexpr (std::is_same_v<T, Mix_Music>) {
+            Mix_FreeMusic(handle);
+        } else {
+            Mix_FreeChunk(handle);
+        }
+    }, resident.handle);
+    if (const auto *music = std::get_if<Mix_Music *>(&resident.handle)) {
+        if (*music == _music) {
+            _music = nullptr;
+        }
+        // the compressed pack entry that was decompressed for it to stream from
+        _buffers.erase(resident.path);
+    }
 }
 
-AssetManager::~AssetManager() = default;
+std::string AssetManager::_resolve(const std::string &folder, const std::string &name,
+                                   const std::span<const char *const> extensions) {
+    for (const char *extension: extensions) {
+        if (std::string path = "resources/" + folder + "/" + name + extension; AssetsManager::Get().exists(path)) {
+            return path;
+        }
+    }
+    return {};
+}
 
-void AssetManager::cleanup() {
-    LOG_INFO(_textures.size());
-    for (auto &texture: _textures) {
-        SDL_DestroyTexture(texture.second);
+SDL_RWops *AssetManager::_open(const std::string &path, std::vector<unsigned char> &buffer) {
+    const AssetsManager &assets = AssetsManager::Get();
+
+    // stored pack entries are read straight from the mapping, which stays mounted for the whole run
+    if (const auto bytes = assets.view(path); !bytes.empty()) {
+        return SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size()));
     }
-    _textures.clear();
 
-    for (auto &audio: _audio) {
-        Mix_FreeMusic(audio.second);
+    if (!assets.isPacked()) {
+        return SDL_RWFromFile(path.c_str(), "rb");
     }
-    _audio.clear();
+
+    // a stream may still be reading a filled buffer, it must not be read into again
+    if (buffer.empty() && !assets.readFile(path, buffer)) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(buffer.data(), static_cast<int>(buffer.size()));
 }
 
 Mix_Music *AssetManager::loadAudio(const std::string &filename) {
-    if (!_audio.contains(filename)) {
-        LOG_WARN("Audio file not found: %s", filename);
+    const std::string key = _key(Kind::Music, filename);
+    if (const Resident *resident = _touch(key)) {
+        return std::get<Mix_Music *>(resident->handle);
+    }
+
+    const std::string path = _resolve("audio", filename, AUDIO_EXTENSIONS);
+    if (path.empty()) {
+        LOG_WARN("Audio file not found: {}", filename);
         return nullptr;
     }
-    return _audio[filename];
+
+    SDL_RWops *stream = _open(path, _buffers[path]);
+    // music is decoded while it plays, what it holds on to is its encoded data
+    const Sint64 bytes = stream ? SDL_RWsize(stream) : 0;
+    Mix_Music *audio = stream ? Mix_LoadMUS_RW(stream, 1) : nullptr;
+    if (audio == nullptr) {
+        LOG_ERROR("Failed to load audio {}: {}", path, Mix_GetError());
+        _buffers.erase(path);
+        return nullptr;
+    }
+    _insert(key, audio, static_cast<std::size_t>(std::max<Sint64>(bytes, 0)), path);
+    return audio;
+}
+
+Mix_Music *AssetManager::playMusic(const std::string &filename, const int loops) {
+    Mix_Music *music = loadAudio(filename);
+    if (music == nullptr) {
+        return nullptr;
+    }
+    if (Mix_PlayMusic(music, loops) != 0) {
+        LOG_ERROR("Failed to play audio {}: {}", filename, Mix_GetError());
+        return nullptr;
+    }
+    _music = music;
+    return music;
 }
 
 SDL_Texture *AssetManager::loadTexture(const std::string &filename) {
-    if (!_textures.contains(filename)) {
-        LOG_WARN("Texture file not found: %s", filename);
+    const std::string key = _key(Kind::Texture, filename);
+    if (const Resident *resident = _touch(key)) {
+        return std::get<SDL_Texture *>(resident->handle);
+    }
+
+    const std::string path = _resolve("images", filename, IMAGE_EXTENSIONS);
+    if (path.empty()) {
+        LOG_WARN("Texture file not found: {}", filename);
         return nullptr;
     }
-    return _textures[filename];
+
+    std::vector<unsigned char> buffer;
+    SDL_RWops *stream = _open(path, buffer);
+    SDL_Surface *surface = stream ? IMG_Load_RW(stream, 1) : nullptr;
+    if (surface == nullptr) {
+        LOG_ERROR("Failed to load image {}: {}", path, IMG_GetError());
+        return nullptr;
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(_renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture == nullptr) {
+        LOG_ERROR("Failed to create texture: {}", SDL_GetError());
+        return nullptr;
+    }
+    _insert(key, texture, textureBytes(texture), path);
+    return texture;
 }
 
 TTF_Font *AssetManager::loadFont(const std::string &filename, int size) {
-    if (!_fonts.contains(filename)) {
-        LOG_WARN("Font file not found: %s", filename);
+    const std::string path = _resolve("fonts", filename, FONT_EXTENSIONS);
+    if (path.empty()) {
+        LOG_WARN("Font file not found: {}", filename);
         return nullptr;
     }
-    TTF_Font *font = TTF_OpenFont(_fonts[filename].c_str(), size);
+
+    SDL_RWops *stream = _open(path, _buffers[path]);
+    TTF_Font *font = stream ? TTF_OpenFontRW(stream, 1, size) : nullptr;
     if (font == nullptr) {
-        LOG_ERROR("Failed to load font: %s", TTF_GetError());
+        LOG_ERROR("Failed to load font: {}", TTF_GetError());
     }
     return font;
 }
 
 
-AssetManager::AssetManager() {
+AssetManager::AssetManager(): _budgetBytes(ASSET_MEMORY_BUDGET_BYTES) {
     LOG_INFO("AssetManager initialized");
 }
 
 Mix_Chunk *AssetManager::loadSound(const std::string &filename) {
-    if (!_sounds.contains(filename)) {
-        LOG_WARN("Sound file not found: %s", filename);
+    const std::string key = _key(Kind::Sound, filename);
+    if (const Resident *resident = _touch(key)) {
+        return std::get<Mix_Chunk *>(resident->handle);
+    }
+
+    const std::string path = _resolve("audio", filename, AUDIO_EXTENSIONS);
+    if (path.empty()) {
+        LOG_WARN("Sound file not found: {}", filename);
+        return nullptr;
+    }
+
+    std::vector<unsigned char> buffer;
+    SDL_RWops *stream = _open(path, buffer);
+    Mix_Chunk *sound = stream ? Mix_LoadWAV_RW(stream, 1) : nullptr;
+    if (sound == nullptr) {
+        LOG_ERROR("Failed to load sound {}: {}", path, Mix_GetError());
         return nullptr;
     }
-    return _sounds[filename];
+    _insert(key, sound, sound->alen, path);
+    return sound;
 }
@@ -3,7 +3,11 @@
  * @brief   Header file for the AssetManager class.
  * @details This file contains the definition of the AssetManager class which is responsible
  *          for managing the assets in the game. The AssetManager class is responsible for
- *          loading, storing, and unloading the assets in the game.
+ *          loading, storing, and unloading the assets in the game. Assets are looked up by name the first
+ *          time they are asked for, from the mounted asset pack when there is one and from disk otherwise.
+ *          Textures, music and sounds then stay resident under a memory budget: when it is exceeded the least
+ *          recently used ones are freed, except pinned assets and sounds and music that are still playing. A pointer
+ *          returned by a load call is only guaranteed until the next load unless the asset is pinned.
  * @author  Nur Akmal bin Jalil
  * @date    2024-07-24
  */
@@ -15,12 +19,30 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
+#include <cstddef>
+#include <list>
+#include <span>
 #include <unordered_map>
-#include <filesystem>
+#include <unordered_set>
+#include <variant>
+#include <vector>
 
 class AssetManager
 {
 public:
+    enum class Kind { Texture, Music, Sound };
+
+    struct Stats {
+        int resident = 0;
+        std::size_t residentBytes = 0;
+        std::size_t budgetBytes = 0;
+        int pinned = 0;
+        int hits = 0;
+        int loads = 0;
+        int reloads = 0; // loads of an asset that had been evicted before
+        int evictions = 0;
+    };
+
     static AssetManager& getInstance();
 
     void init(SDL_Renderer* renderer);
@@ -29,21 +51,72 @@ public:
 
     Mix_Music* loadAudio(const std::string& filename);
 
+    // Loads and starts the music; unlike music played straight through SDL_mixer it is not evicted while it plays
+    Mix_Music* playMusic(const std::string& filename, int loops = -1);
+
     Mix_Chunk* loadSound(const std::string& filename);
 
     TTF_Font* loadFont(const std::string& filename, int size);
 
+    // Frees least recently used assets right away if the new budget is already exceeded
+    void setBudget(std::size_t bytes);
+
+    // Pins nest, and may be taken before the asset is loaded; pinned assets are never evicted
+    void pin(Kind kind, const std::string& filename);
+
+    void unpin(Kind kind, const std::string& filename);
+
+    [[nodiscard]] Stats getStats() const;
+
     void cleanup();
 
     ~AssetManager();
 
 private:
+    using Handle = std::variant<SDL_Texture*, Mix_Music*, Mix_Chunk*>;
+
+    struct Resident {
+        Handle handle;
+        std::size_t bytes = 0;
+        std::string path;
+        std::list<std::string>::iterator lru;
+    };
+
     AssetManager();
 
-    std::unordered_map<std::string, SDL_Texture*> _textures;
-    std::unordered_map<std::string, Mix_Music*> _audio;
-    std::unordered_map<std::string, Mix_Chunk*> _sounds;
-    std::unordered_map<std::string, std::string> _fonts;
+    static std::string _key(Kind kind, const std::string& filename);
+
+    // the resident asset moved to the front of the LRU list, or nullptr
+    Resident* _touch(const std::string& key);
+
+    void _insert(const std::string& key, Handle handle, std::size_t bytes, const std::string& path);
+
+    void _evictToBudget();
+
+    void _free(Resident& resident);
+
+    // "resources/<folder>/<name><extension>" for the first extension that exists, empty if none does
+    static std::string _resolve(const std::string& folder, const std::string& name,
+                                std::span<const char* const> extensions);
+
+    // `buffer` receives compressed pack entries. Music and fonts keep reading from the stream after they are
+    // opened, so theirs must outlive them; images and sounds are decoded at once and can use a temporary.
+    SDL_RWops* _open(const std::string& path, std::vector<unsigned char>& buffer);
+
+    SDL_Renderer* _renderer = nullptr;
+    std::unordered_map<std::string, Resident> _resident;
+    std::list<std::string> _lru; // most recently used first
+    std::unordered_map<std::string, int> _pins;
+    std::unordered_set<std::string> _evicted;
+    std::size_t _budgetBytes;
+    std::size_t _residentBytes = 0;
+    int _hits = 0;
+    int _loads = 0;
+    int _reloads = 0;
+    int _evictions = 0;
+    Mix_Music* _music = nullptr; // last started by playMusic(), SDL_mixer can't tell which music is playing
+    // compressed pack entries decompressed for music and fonts, by path
+    std::unordered_map<std::string, std::vector<unsigned char>> _buffers;
 };
 
 #endif //CBIT_ASSETMANAGER_H
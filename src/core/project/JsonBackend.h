@@ -0,0 +1,27 @@
+/**
+ * @file    JsonBackend.h
+ * @brief   JsonBackend enum and JsonSettings class header file
+ * @details Selects the parser that loads scene files and project.json at runtime. The simdjson on-demand path
+ *          streams values straight into the registry without building a DOM; the rapidjson path is kept for
+ *          comparison. Documents are always written with rapidjson.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef JSONBACKEND_H
+#define JSONBACKEND_H
+
+enum class JsonBackend { RapidJson, Simdjson };
+
+class JsonSettings {
+public:
+    static void setLoadBackend(const JsonBackend backend) { _loadBackend = backend; }
+
+    [[nodiscard]] static JsonBackend getLoadBackend() { return _loadBackend; }
+
+private:
+    static inline JsonBackend _loadBackend = JsonBackend::Simdjson;
+};
+
+
+#endif //JSONBACKEND_H
@@ -13,6 +13,9 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <filesystem>
+#include <simdjson.h>
+#include <utility>
+#include "JsonBackend.h"
 #include "utilities/DateTime.h"
 #include "utilities/Logger.h"
 #include "utilities/UUIDGenerator.h"
@@ -117,6 +120,11 @@ std::string Project::getRecentProjectPath() {
 
 bool Project::load(const std::string& filePath)
 {
+    if (JsonSettings::getLoadBackend() == JsonBackend::Simdjson)
+    {
+        return _loadWithSimdjson(filePath);
+    }
+
     std::ifstream ifs(filePath);
     if (!ifs.is_open()) return false;
 
@@ -131,6 +139,58 @@ bool Project::load(const std::string& filePath)
     return true;
 }
 
+bool Project::_loadWithSimdjson(const std::string& filePath)
+{
+    simdjson::padded_string json;
+    if (simdjson::padded_string::load(filePath).get(json)) return false;
+
+    // parse into a copy, so a file that fails halfway leaves this project as it was
+    Project loaded = *this;
+    try
+    {
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document doc = parser.iterate(json);
+
+        // fields come in file order; anything not listed here is skipped
+        for (auto field : doc.get_object())
+        {
+            const std::string_view key = field.unescaped_key();
+            if (key == "sceneFiles")
+            {
+                loaded.sceneFiles.clear();
+                for (auto scene : field.value().get_array())
+                {
+                    loaded.sceneFiles.emplace_back(std::string_view(scene.get_string()));
+                }
+                continue;
+            }
+
+            std::string* member = nullptr;
+            if (key == "name") member = &loaded.name;
+            else if (key == "id") member = &loaded.id;
+            else if (key == "author") member = &loaded.author;
+            else if (key == "version") member = &loaded.version;
+            else if (key == "createdDate") member = &loaded.createdDate;
+            else if (key == "modifiedDate") member = &loaded.modifiedDate;
+            else if (key == "path") member = &loaded.path;
+            else if (key == "currentScene") member = &loaded.currentScene;
+
+            if (member)
+            {
+                *member = std::string_view(field.value().get_string());
+            }
+        }
+    }
+    catch (const simdjson::simdjson_error& e)
+    {
+        LOG_ERROR("Could not parse project file '{}': {}", filePath, e.what());
+        return false;
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
 void Project::toJson(rapidjson::Document& doc) const
 {
     auto& alloc = doc.GetAllocator();
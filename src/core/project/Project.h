@@ -44,6 +44,9 @@ public:
     void fromJson(const rapidjson::Document &doc);
 
     bool createScene(const std::string &name);
+
+private:
+    bool _loadWithSimdjson(const std::string &filePath);
 };
 
 
@@ -10,6 +10,7 @@
 
 #include "Scene.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include "SceneSerializer.h"
@@ -48,6 +49,22 @@ void Scene::render(const CameraManager &cameraManager) {
 
 void Scene::cleanup() {
     _world.cleanup();
+    releaseAssets();
+}
+
+void Scene::releaseAssets() {
+    for (const auto &[kind, name]: _pinnedAssets) {
+        AssetManager::getInstance().unpin(kind, name);
+    }
+    _pinnedAssets.clear();
+}
+
+void Scene::pinAsset(const AssetManager::Kind kind, const std::string &name) {
+    if (std::ranges::find(_pinnedAssets, std::pair{kind, name}) != _pinnedAssets.end()) {
+        return;
+    }
+    AssetManager::getInstance().pin(kind, name);
+    _pinnedAssets.emplace_back(kind, name);
 }
 
 bool Scene::switchScene() const {
@@ -85,8 +102,9 @@ void Scene::toggleDebug() {
 }
 
 void Scene::playBGM(const std::string &name) {
-    _bgm = AssetManager::getInstance().loadAudio(name);
-    Mix_PlayMusic(_bgm, -1);
+    // freeing music that is playing would stop it
+    pinAsset(AssetManager::Kind::Music, name);
+    _bgm = AssetManager::getInstance().playMusic(name);
 }
 
 void Scene::stopBGM() {
@@ -94,6 +112,7 @@ void Scene::stopBGM() {
 }
 
 void Scene::playSFX(const std::string &name) {
+    pinAsset(AssetManager::Kind::Sound, name);
     Mix_Chunk *sfx = AssetManager::getInstance().loadSound(name);
     Mix_PlayChannel(-1, sfx, 0);
 }
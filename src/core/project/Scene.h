@@ -14,6 +14,8 @@
 #include "AssetManager.h"
 #include "../input/Input.h"
 #include "../ecs/EntityComponentSystem.h"
+#include <utility>
+#include <vector>
 
 class Scene {
 public:
@@ -32,6 +34,9 @@ public:
 
     void cleanup();
 
+    // unpin the assets this scene pinned, so they can be evicted once it is no longer active
+    void releaseAssets();
+
     // handle scenes management (use by SceneManager)
     [[nodiscard]] bool switchScene() const;
 
@@ -66,7 +71,13 @@ protected:
 
     static void stopBGM();
 
-    static void playSFX(const std::string &name);
+    void playSFX(const std::string &name);
+
+    // keep an asset resident while this scene is active; pinning the same asset again is a no-op
+    void pinAsset(AssetManager::Kind kind, const std::string &name);
+
+private:
+    std::vector<std::pair<AssetManager::Kind, std::string> > _pinnedAssets;
 };
 
 
@@ -0,0 +1,121 @@
+/**
+ * @file    SceneJournal.cpp
+ * @brief   SceneJournal class implementation file
+ * @details Tracks changed and destroyed entities through entt storage signals and appends them to the scene's
+ *          journal through SceneSerializer.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "SceneJournal.h"
+#include <filesystem>
+#include <fstream>
+#include "Scene.h"
+#include "SceneSerializer.h"
+#include "../ecs/Components.h"
+#include "../../utilities/Logger.h"
+
+SceneJournal::SceneJournal(Scene &scene) : _scene(scene) {
+    auto &registry = _scene.getEntityComponentSystem().getRegistry();
+
+    // the components SceneSerializer writes; edits have to go through patch() to be seen
+    _track<TagComponent>(registry);
+    _track<TransformComponent>(registry);
+    _track<CameraComponent>(registry);
+    _track<DirectionalLightComponent>(registry);
+    _track<PointLightComponent>(registry);
+    _track<SpotLightComponent>(registry);
+    _track<QuadComponent>(registry);
+    _track<CubeComponent>(registry);
+    _track<TextureComponent>(registry);
+
+    // every saved entity has an IdComponent, losing it means the entity is gone
+    _connections.emplace_back(registry.on_construct<IdComponent>().connect<&SceneJournal::_onChanged>(*this));
+    _connections.emplace_back(registry.on_update<IdComponent>().connect<&SceneJournal::_onChanged>(*this));
+    _connections.emplace_back(registry.on_destroy<IdComponent>().connect<&SceneJournal::_onDestroyed>(*this));
+}
+
+template<typename Component>
+void SceneJournal::_track(entt::registry &registry) {
+    _connections.emplace_back(registry.on_construct<Component>().template connect<&SceneJournal::_onChanged>(*this));
+    _connections.emplace_back(registry.on_update<Component>().template connect<&SceneJournal::_onChanged>(*this));
+    // removing a component changes the entity too; if the whole entity goes, append() skips it
+    _connections.emplace_back(registry.on_destroy<Component>().template connect<&SceneJournal::_onChanged>(*this));
+}
+
+void SceneJournal::_onChanged(entt::registry &, const entt::entity entity) {
+    _changed.insert(entity);
+}
+
+void SceneJournal::_onDestroyed(entt::registry &registry, const entt::entity entity) {
+    // still attached while its destroy signal runs
+    _removed.push_back(registry.get<IdComponent>(entity).uuid);
+    _changed.erase(entity);
+}
+
+bool SceneJournal::hasChanges() const {
+    return !_changed.empty() || !_removed.empty();
+}
+
+bool SceneJournal::append(const std::string &journalPath) {
+    if (!hasChanges()) {
+        return true;
+    }
+
+    const std::vector<entt::entity> changed(_changed.begin(), _changed.end());
+    if (!SceneSerializer(_scene).appendToJournal(journalPath, changed, _removed)) {
+        // keep them for the next attempt
+        return false;
+    }
+    clearChanges();
+    return true;
+}
+
+void SceneJournal::clearChanges() {
+    _changed.clear();
+    _removed.clear();
+}
+
+std::string SceneJournal::getJournalPath(const std::string &jsonPath) {
+    return std::filesystem::path(jsonPath).replace_extension(".journal").string();
+}
+
+std::string SceneJournal::getSavingJournalPath(const std::string &jsonPath) {
+    return std::filesystem::path(jsonPath).replace_extension(".saving.journal").string();
+}
+
+bool SceneJournal::setAside(const std::string &jsonPath) {
+    const std::string journalPath = getJournalPath(jsonPath);
+    const std::string savingPath = getSavingJournalPath(jsonPath);
+    std::error_code error;
+    if (!std::filesystem::exists(journalPath, error)) {
+        return true;
+    }
+
+    if (!std::filesystem::exists(savingPath, error)) {
+        std::filesystem::rename(journalPath, savingPath, error);
+        if (error) {
+            LOG_ERROR("Could not set scene journal '{}' aside: {}", journalPath, error.message());
+            return false;
+        }
+        return true;
+    }
+
+    const auto bytes = std::filesystem::file_size(journalPath, error);
+    if (error) {
+        LOG_ERROR("Could not read scene journal '{}': {}", journalPath, error.message());
+        return false;
+    }
+    // streaming an empty file would flag the output as failed
+    if (bytes > 0) {
+        std::ifstream input(journalPath, std::ios::binary);
+        std::ofstream output(savingPath, std::ios::binary | std::ios::app);
+        output << input.rdbuf();
+        if (!input || !output) {
+            LOG_ERROR("Could not add scene journal '{}' to '{}'", journalPath, savingPath);
+            return false;
+        }
+    }
+    std::filesystem::remove(journalPath, error);
+    return true;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file    SceneJournal.h
+ * @brief   SceneJournal class header file
+ * @details SceneJournal listens to the registry signals of every component the scene serializer writes and
+ *          remembers which entities changed or were destroyed. append() writes only those entities to a
+ *          JSON-lines journal next to the scene file, so saving a small edit costs the same in a huge scene as in
+ *          a tiny one. Loading replays the journal on top of the base file, and a full save folds it back in.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef SCENEJOURNAL_H
+#define SCENEJOURNAL_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <entt/entt.hpp>
+
+class Scene;
+
+class SceneJournal {
+public:
+    // Starts tracking right away, so create it after the scene has been loaded
+    explicit SceneJournal(Scene &scene);
+
+    SceneJournal(const SceneJournal &) = delete;
+
+    SceneJournal &operator=(const SceneJournal &) = delete;
+
+    [[nodiscard]] bool hasChanges() const;
+
+    // Appends the changes since the last append or clear, then forgets them
+    bool append(const std::string &journalPath);
+
+    // The scene is about to be written in full, which covers everything tracked so far
+    void clearChanges();
+
+    // scenes/level.json -> scenes/level.journal
+    static std::string getJournalPath(const std::string &jsonPath);
+
+    // scenes/level.json -> scenes/level.saving.journal, the journal a running full save is folding in
+    static std::string getSavingJournalPath(const std::string &jsonPath);
+
+    /**
+     * Called on the main thread right before a full save of the scene starts: moves the journal aside, so the
+     * appends made while the save runs go to a new one that the save doesn't remove. A journal left aside by a
+     * save that failed is kept and the current one is added to its end.
+     */
+    static bool setAside(const std::string &jsonPath);
+
+private:
+    Scene &_scene;
+    std::unordered_set<entt::entity> _changed;
+    std::vector<std::string> _removed;
+    std::vector<entt::scoped_connection> _connections;
+
+    template<typename Component>
+    void _track(entt::registry &registry);
+
+    void _onChanged(entt::registry &registry, entt::entity entity);
+
+    void _onDestroyed(entt::registry &registry, entt::entity entity);
+};
+
+
+#endif //SCENEJOURNAL_H
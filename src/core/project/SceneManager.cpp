@@ -10,11 +10,18 @@
 
 
 #include "SceneManager.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <utility>
 
+#include "JsonBackend.h"
+#include "SceneJournal.h"
 #include "SceneSerializer.h"
+#include "SceneSnapshot.h"
 #include "../splash/SplashScreen.h"
 #include "../../utilities/Logger.h"
+#include "../../utilities/TaskGraph.h"
 
 SceneManager::SceneManager() : _currentScene(nullptr) {
 }
@@ -23,10 +30,13 @@ SceneManager::~SceneManager() {
     cleanup();
 }
 
-void SceneManager::update(const float deltaTime, Input &input) const {
+void SceneManager::update(const float deltaTime, Input &input) {
     if (_currentScene) {
         _currentScene->update(deltaTime, input);
     }
+    // running saves don't hold autosave up, they only remove the journal they set aside
+    _reapSaves();
+    _autosave(deltaTime);
 }
 
 void SceneManager::render() {
@@ -49,7 +59,10 @@ void SceneManager::render(const CameraManager &cameraManager) {
     _currentScene->render(cameraManager);
 }
 
-void SceneManager::cleanup() const {
+void SceneManager::cleanup() {
+    waitForSaves();
+    // clearing the registries is not an edit
+    _journals.clear();
     if (_currentScene) {
         _currentScene->cleanup();
     }
@@ -57,28 +70,224 @@ void SceneManager::cleanup() const {
 
 void SceneManager::loadScenesFromProject(const std::vector<std::string> &sceneFiles, const std::string &currentScene,
                                          const std::string &projectPath) {
+    waitForSaves();
+    _journals.clear();
     _scenes.clear(); // remove old scenes
-    for (const auto &sceneFile: sceneFiles) {
-        std::string sceneName = std::filesystem::path(sceneFile).stem().string();
-        auto scene = std::make_shared<Scene>();
-        scene->setName(sceneName);
+    _projectPath = projectPath;
 
-        // Actually load scene data from the file
-        SceneSerializer serializer(*scene);
-        serializer.loadFromFile(projectPath + "/" + sceneFile);
+    // JSON scenes are parsed on worker threads; entities, and the meshes and textures of their components, are
+    // only created here, each scene as soon as its file is parsed
+    const bool parseAhead = JsonSettings::getLoadBackend() == JsonBackend::Simdjson;
+    std::vector<std::vector<SceneSerializer::EntityRecord> > parsed(sceneFiles.size());
+    TaskGraph graph;
 
-        addScene(sceneName, scene);
+    for (std::size_t i = 0; i < sceneFiles.size(); ++i) {
+        std::string sceneName = std::filesystem::path(sceneFiles[i]).stem().string();
+
+        // the binary snapshot is used while it is newer than the JSON
+        std::string jsonPath = projectPath + "/" + sceneFiles[i];
+        std::string snapshotPath = SceneSnapshot::getSnapshotPath(jsonPath);
+        bool snapshotFresh = false;
+        std::error_code error;
+        if (const auto jsonTime = std::filesystem::last_write_time(jsonPath, error); !error) {
+            const auto snapshotTime = std::filesystem::last_write_time(snapshotPath, error);
+            snapshotFresh = !error && snapshotTime >= jsonTime;
+        }
+
+        std::vector<TaskGraph::TaskId> dependencies;
+        const bool parsedAhead = parseAhead && !snapshotFresh;
+        if (parsedAhead) {
+            // a file that doesn't parse is reported and loads as an empty scene, as before
+            dependencies.push_back(graph.add("parse " + sceneName, TaskGraph::Affinity::Worker,
+                                             [&parsed, i, jsonPath] {
+                                                 SceneSerializer::parseFile(jsonPath, parsed[i]);
+                                                 return true;
+                                             }));
+        }
+
+        graph.add("load " + sceneName, TaskGraph::Affinity::Main,
+                  [this, &parsed, i, sceneName, jsonPath, snapshotPath, snapshotFresh, parsedAhead] {
+                      auto scene = std::make_shared<Scene>();
+                      scene->setName(sceneName);
+
+                      if (!snapshotFresh || !SceneSnapshot(*scene).loadFromFile(snapshotPath)) {
+                          if (parsedAhead) {
+                              SceneSerializer(*scene).instantiate(parsed[i]);
+                              LOG_INFO("Loading scene from '{}'", jsonPath);
+                          } else {
+                              SceneSerializer(*scene).loadFromFile(jsonPath);
+                          }
+                      }
+                      parsed[i].clear();
+
+                      // edits autosaved since the last full save
+                      _replayJournals(*scene, jsonPath);
+                      _journals[sceneName] = createScope<SceneJournal>(*scene);
+
+                      addScene(sceneName, scene);
+                      return true;
+                  }, dependencies);
     }
+
+    graph.run();
+    const auto &stats = graph.getStats();
+    LOG_INFO("Loaded {} scenes in {:.1f} ms, {:.1f} ms of parsing on worker threads", sceneFiles.size(),
+             stats.elapsedMs, stats.workerMs);
+
     setActiveScene(std::filesystem::path(currentScene).stem().string());
 }
 
 void SceneManager::saveScenesToProject(const std::string &projectPath) {
+    // a scene file must not be written by two saves at once
+    waitForSaves();
+    _projectPath = projectPath;
+
     for (const auto &[name, scene]: _scenes) {
-        SceneSerializer serializer(*scene);
-        if (!serializer.saveToFile(projectPath + "/scenes/" + name + ".json")) {
-            LOG_ERROR("Failed to save scene: {}", name);
+        _pendingSaves.push_back(_saveScene(name, scene, false));
+    }
+}
+
+void SceneManager::setAutosaveInterval(const float seconds) {
+    _autosaveInterval = seconds;
+    _autosaveTimer = 0.0f;
+}
+
+std::future<SceneManager::SaveResult> SceneManager::_saveScene(const std::string &name,
+                                                                const std::shared_ptr<Scene> &scene,
+                                                                const bool compaction) {
+    // the full file covers every change made so far, the journal only has to hold what comes after it
+    const std::string jsonPath = _projectPath + "/scenes/" + name + ".json";
+    if (const auto journal = _journals.find(name); journal != _journals.end()) {
+        journal->second->clearChanges();
+    }
+    SceneJournal::setAside(jsonPath);
+
+    // rendering and editing keep changing the registry, so the workers only get a copy of its entities
+    std::vector<SceneSerializer::EntityRecord> entities;
+    SceneSerializer(*scene).capture(entities);
+
+    // one worker per scene
+    auto save = [name, sceneName = scene->getName(), entities = std::move(entities), jsonPath, compaction] {
+        SaveResult result{name};
+        result.compaction = compaction;
+        result.json = SceneSerializer::saveRecords(jsonPath, sceneName, entities);
+        // written after the JSON so it counts as up to date on the next load
+        result.snapshot = result.json &&
+                          SceneSnapshot::saveRecords(SceneSnapshot::getSnapshotPath(jsonPath), sceneName, entities);
+        // folded into the file just written; if this never runs, the next load sees the file is newer
+        if (result.json) {
+            std::error_code error;
+            std::filesystem::remove(SceneJournal::getSavingJournalPath(jsonPath), error);
+        }
+        return result;
+    };
+    return std::async(std::launch::async, std::move(save));
+}
+
+void SceneManager::_autosave(const float deltaTime) {
+    if (_autosaveInterval <= 0.0f || _projectPath.empty()) {
+        return;
+    }
+    _autosaveTimer += deltaTime;
+    if (_autosaveTimer < _autosaveInterval) {
+        return;
+    }
+    _autosaveTimer = 0.0f;
+
+    for (const auto &[name, journal]: _journals) {
+        if (!journal->hasChanges()) {
+            continue;
+        }
+
+        const std::string jsonPath = _projectPath + "/scenes/" + name + ".json";
+        const std::string journalPath = SceneJournal::getJournalPath(jsonPath);
+        if (!journal->append(journalPath)) {
+            continue;
+        }
+
+        std::error_code error;
+        const auto journalBytes = std::filesystem::file_size(journalPath, error);
+        if (error) {
+            continue;
+        }
+        // loading replays the whole journal, so fold it in before it costs about as much as the scene file;
+        // one save of a scene at a time, they share its files
+        const auto sceneBytes = std::filesystem::file_size(jsonPath, error);
+        if (journalBytes > std::max(MIN_COMPACTION_BYTES, error ? 0 : sceneBytes / 2) &&
+            _pendingSaves.empty() && !_compacting.contains(name)) {
+            LOG_INFO("Compacting scene journal: {}", name);
+            _compacting.insert(name);
+            _pendingCompactions.push_back(_saveScene(name, _scenes.at(name), true));
+        }
+    }
+}
+
+bool SceneManager::isSaving() {
+    _reapSaves();
+    return !_pendingSaves.empty();
+}
+
+void SceneManager::waitForSaves() {
+    for (auto *saves: {&_pendingSaves, &_pendingCompactions}) {
+        for (auto &save: *saves) {
+            _finishSave(save);
+        }
+        saves->clear();
+    }
+}
+
+void SceneManager::_reapSaves() {
+    for (auto *saves: {&_pendingSaves, &_pendingCompactions}) {
+        std::erase_if(*saves, [this](std::future<SaveResult> &save) {
+            if (save.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+            _finishSave(save);
+            return true;
+        });
+    }
+}
+
+void SceneManager::_finishSave(std::future<SaveResult> &save) {
+    const SaveResult result = save.get();
+    if (result.compaction) {
+        _compacting.erase(result.name);
+    }
+    _reportSave(result);
+}
+
+void SceneManager::_replayJournals(Scene &scene, const std::string &jsonPath) {
+    std::error_code error;
+    if (const std::string savingPath = SceneJournal::getSavingJournalPath(jsonPath);
+        std::filesystem::exists(savingPath, error)) {
+        // left behind by a save; if the scene file was written after it, that save got far enough to cover it
+        const auto savingTime = std::filesystem::last_write_time(savingPath, error);
+        std::error_code jsonError;
+        const auto jsonTime = std::filesystem::last_write_time(jsonPath, jsonError);
+        if (!error && !jsonError && jsonTime > savingTime) {
+            std::filesystem::remove(savingPath, error);
+        } else {
+            SceneSerializer(scene).replayJournal(savingPath);
         }
     }
+
+    if (const std::string journalPath = SceneJournal::getJournalPath(jsonPath);
+        std::filesystem::exists(journalPath, error)) {
+        SceneSerializer(scene).replayJournal(journalPath);
+    }
+}
+
+void SceneManager::_reportSave(const SaveResult &result) {
+    const char *what = result.compaction ? "compact scene journal" : "save scene";
+    if (!result.json) {
+        LOG_ERROR("Failed to {}: {}", what, result.name);
+    } else if (!result.snapshot) {
+        LOG_WARN("Failed to save scene snapshot: {}", result.name);
+    } else if (result.compaction) {
+        LOG_INFO("Compacted scene journal: {}", result.name);
+    } else {
+        LOG_INFO("Saved scene: {}", result.name);
+    }
 }
 
 void SceneManager::createScene(std::string &name) {
@@ -88,6 +297,9 @@ void SceneManager::createScene(std::string &name) {
         LOG_INFO("Creating scene with name {}", name);
         const auto newScene = std::make_shared<Scene>();
         newScene->setName(name);
+        if (!_projectPath.empty()) {
+            _journals[name] = createScope<SceneJournal>(*newScene);
+        }
         addScene(name, newScene);
         _showSplashScreen = false;
         setActiveScene(name);
@@ -95,6 +307,7 @@ void SceneManager::createScene(std::string &name) {
 }
 
 void SceneManager::removeScene(const std::string &name) {
+    _journals.erase(name);
     // check if the scene exists
     if (_scenes.contains(name)) {
         // check if the scene is the current scene
@@ -122,6 +335,9 @@ void SceneManager::setActiveScene(const std::string &name) {
         return;
     }
     if (_scenes.contains(name)) {
+        if (_currentScene && _currentScene != _scenes[name]) {
+            _currentScene->releaseAssets();
+        }
         _currentScene = _scenes[name];
         _currentScene->setup();
     } else {
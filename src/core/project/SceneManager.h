@@ -11,10 +11,16 @@
 #define CBIT_SCENEMANAGER_H
 
 #include "Scene.h"
+#include "SceneJournal.h"
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <vector>
 #include "../input/Input.h"
+#include "../../utilities/SmartPointer.h"
 
 class SceneManager {
 public:
@@ -22,19 +28,36 @@ public:
 
     ~SceneManager();
 
-    void update(float deltaTime, Input &input) const;
+    void update(float deltaTime, Input &input);
 
     void render();
 
     void render(const CameraManager &cameraManager);
 
-    void cleanup() const;
+    void cleanup();
 
     void loadScenesFromProject(const std::vector<std::string> &sceneFiles, const std::string &currentScene,
                                const std::string &projectPath);
 
+    /**
+     * Copies every scene's entities, then writes them to the project's scenes folder on worker threads and
+     * returns right away. The scenes can be rendered and edited while the files are written.
+     */
     void saveScenesToProject(const std::string &projectPath);
 
+    // True while saves started by saveScenesToProject() run; also reports the saves that finished since the last call
+    bool isSaving();
+
+    // Waits for journal compactions too
+    void waitForSaves();
+
+    /**
+     * Every interval, the entities changed since the last save are appended to each scene's journal. A journal
+     * that grows past half its scene file is folded back in by a full save in the background; that doesn't count
+     * as saving and autosave keeps appending meanwhile. 0 turns it off.
+     */
+    void setAutosaveInterval(float seconds);
+
     void createScene(std::string &name);
 
     void removeScene(const std::string &name);
@@ -52,9 +75,39 @@ public:
     const std::unordered_map<std::string, std::shared_ptr<Scene> > &getScenes() const { return _scenes; }
 
 private:
+    static constexpr std::uintmax_t MIN_COMPACTION_BYTES = 1024 * 1024;
+
+    struct SaveResult {
+        std::string name;
+        bool json = false;
+        bool snapshot = false;
+        bool compaction = false;
+    };
+
     std::unordered_map<std::string, std::shared_ptr<Scene> > _scenes;
     std::shared_ptr<Scene> _currentScene;
     bool _showSplashScreen = false;
+    std::vector<std::future<SaveResult> > _pendingSaves;
+    std::vector<std::future<SaveResult> > _pendingCompactions;
+    std::unordered_set<std::string> _compacting;
+    std::unordered_map<std::string, scope<SceneJournal> > _journals;
+    std::string _projectPath;
+    float _autosaveInterval = 0.0f;
+    float _autosaveTimer = 0.0f;
+
+    std::future<SaveResult> _saveScene(const std::string &name, const std::shared_ptr<Scene> &scene, bool compaction);
+
+    void _autosave(float deltaTime);
+
+    // Reports the saves and compactions that finished, without waiting for the others
+    void _reapSaves();
+
+    void _finishSave(std::future<SaveResult> &save);
+
+    // The journal set aside by an unfinished save, then the current one
+    static void _replayJournals(Scene &scene, const std::string &jsonPath);
+
+    static void _reportSave(const SaveResult &result);
 };
 
 
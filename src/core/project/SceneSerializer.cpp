@@ -9,41 +9,472 @@
 #include "SceneSerializer.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <rapidjson/filewritestream.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <simdjson.h>
 #include "../ecs/GameObject.h"
 
+namespace {
+    using simdjson::ondemand::value;
+
+    float readFloat(value element) {
+        return static_cast<float>(element.get_double().value());
+    }
+
+    // missing trailing components keep their defaults, extra ones are consumed and dropped
+    template<glm::length_t Size>
+    void readVector(value element, glm::vec<Size, float> &vector) {
+        glm::length_t i = 0;
+        for (const double component: element.get_array()) {
+            if (i < Size) {
+                vector[i] = static_cast<float>(component);
+            }
+            ++i;
+        }
+    }
+
+    // older scenes stored spotlight cut-offs as cosines
+    float toCutOffDegrees(const float cutOff) {
+        if (cutOff <= 1.0f) {
+            return std::acos(std::clamp(cutOff, -1.0f, 1.0f)) * (180.0f / 3.14159265f);
+        }
+        return cutOff;
+    }
+
+    CameraComponentType toCameraType(const std::string_view type) {
+        if (type == "editor") {
+            return CameraComponentType::Editor;
+        }
+        if (type == "game") {
+            return CameraComponentType::Game;
+        }
+        if (type == "ui") {
+            return CameraComponentType::UI;
+        }
+        LOG_WARN("Unknown camera type '{}', defaulting to 'game'", type);
+        return CameraComponentType::Game;
+    }
+
+    using EntityRecord = SceneSerializer::EntityRecord;
+
+    TransformComponent readTransform(simdjson::ondemand::object object) {
+        TransformComponent transform;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "position") {
+                readVector(field.value(), transform.position);
+            } else if (key == "rotation") {
+                readVector(field.value(), transform.rotation);
+            } else if (key == "scale") {
+                readVector(field.value(), transform.scale);
+            }
+        }
+        return transform;
+    }
+
+    CameraComponent readCamera(simdjson::ondemand::object object) {
+        CameraComponent camera;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "type") {
+                camera.type = toCameraType(field.value().get_string());
+            } else if (key == "isPrimary") {
+                camera.isPrimary = field.value().get_bool();
+            } else if (key == "fov") {
+                camera.fov = readFloat(field.value());
+            } else if (key == "nearClip") {
+                camera.nearClip = readFloat(field.value());
+            } else if (key == "farClip") {
+                camera.farClip = readFloat(field.value());
+            } else if (key == "target") {
+                readVector(field.value(), camera.target);
+            } else if (key == "distance") {
+                camera.distance = readFloat(field.value());
+            } else if (key == "yaw") {
+                camera.yaw = readFloat(field.value());
+            } else if (key == "pitch") {
+                camera.pitch = readFloat(field.value());
+            }
+        }
+        return camera;
+    }
+
+    DirectionalLightComponent readDirectionalLight(simdjson::ondemand::object object) {
+        DirectionalLightComponent light;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "direction") {
+                readVector(field.value(), light.direction);
+            } else if (key == "color") {
+                readVector(field.value(), light.color);
+            } else if (key == "ambient") {
+                readVector(field.value(), light.ambient);
+            }
+        }
+        return light;
+    }
+
+    PointLightComponent readPointLight(simdjson::ondemand::object object) {
+        PointLightComponent light;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "position") {
+                readVector(field.value(), light.position);
+            } else if (key == "color") {
+                readVector(field.value(), light.color);
+            } else if (key == "constant") {
+                light.constant = readFloat(field.value());
+            } else if (key == "linear") {
+                light.linear = readFloat(field.value());
+            } else if (key == "quadratic") {
+                light.quadratic = readFloat(field.value());
+            }
+        }
+        return light;
+    }
+
+    SpotLightComponent readSpotLight(simdjson::ondemand::object object) {
+        SpotLightComponent light;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "position") {
+                readVector(field.value(), light.position);
+            } else if (key == "direction") {
+                readVector(field.value(), light.direction);
+            } else if (key == "color") {
+                readVector(field.value(), light.color);
+            } else if (key == "cutOff") {
+                light.cutOff = toCutOffDegrees(readFloat(field.value()));
+            } else if (key == "outerCutOff") {
+                light.outerCutOff = toCutOffDegrees(readFloat(field.value()));
+            } else if (key == "range") {
+                light.range = readFloat(field.value());
+            }
+        }
+        return light;
+    }
+
+    glm::vec4 readMeshColor(simdjson::ondemand::object object) {
+        auto color = glm::vec4(1.0f);
+        for (auto field: object) {
+            if (field.unescaped_key().value() == "color") {
+                readVector(field.value(), color);
+            }
+        }
+        return color;
+    }
+
+    std::optional<std::string> readTexturePath(simdjson::ondemand::object object) {
+        for (auto field: object) {
+            if (field.unescaped_key().value() == "path") {
+                return std::string(field.value().get_string().value());
+            }
+        }
+        return std::nullopt;
+    }
+
+    constexpr std::size_t WRITE_BUFFER_BYTES = 64 * 1024;
+
+    template<typename Writer>
+    void writeKey(Writer &writer, const std::string_view key) {
+        writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+    }
+
+    template<typename Writer>
+    void writeString(Writer &writer, const std::string_view key, const std::string_view value) {
+        writeKey(writer, key);
+        writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+    }
+
+    template<typename Writer>
+    void writeFloat(Writer &writer, const std::string_view key, const float value) {
+        writeKey(writer, key);
+        writer.Double(value);
+    }
+
+    template<typename Writer, glm::length_t Size>
+    void writeVector(Writer &writer, const std::string_view key, const glm::vec<Size, float> &vector) {
+        writeKey(writer, key);
+        writer.StartArray();
+        for (glm::length_t i = 0; i < Size; ++i) {
+            writer.Double(vector[i]);
+        }
+        writer.EndArray();
+    }
+
+    template<typename Writer>
+    void writeMeshColor(Writer &writer, const std::string_view key, const glm::vec4 &color) {
+        writeKey(writer, key);
+        writer.StartObject();
+        writeVector(writer, "color", color);
+        writer.EndObject();
+    }
+
+    const char *toCameraTypeName(const CameraComponentType type) {
+        switch (type) {
+            case CameraComponentType::Editor: return "editor";
+            case CameraComponentType::Game: return "game";
+            case CameraComponentType::UI: return "ui";
+        }
+        return "unknown";
+    }
+
+    EntityRecord captureEntity(const entt::registry &registry, const entt::entity entity) {
+        EntityRecord record;
+        record.tag = registry.get<TagComponent>(entity).tag;
+        record.uuid = registry.get<IdComponent>(entity).uuid;
+        if (const auto *transform = registry.try_get<TransformComponent>(entity)) {
+            record.transform = *transform;
+        }
+        if (const auto *camera = registry.try_get<CameraComponent>(entity)) {
+            record.camera = *camera;
+        }
+        if (const auto *directionalLight = registry.try_get<DirectionalLightComponent>(entity)) {
+            record.directionalLight = *directionalLight;
+        }
+        if (const auto *pointLight = registry.try_get<PointLightComponent>(entity)) {
+            record.pointLight = *pointLight;
+        }
+        if (const auto *spotLight = registry.try_get<SpotLightComponent>(entity)) {
+            record.spotLight = *spotLight;
+        }
+        if (const auto *quad = registry.try_get<QuadComponent>(entity)) {
+            record.quadColor = quad->mesh.color;
+        }
+        if (const auto *cube = registry.try_get<CubeComponent>(entity)) {
+            record.cubeColor = cube->mesh.color;
+        }
+        if (const auto *texture = registry.try_get<TextureComponent>(entity)) {
+            record.texturePath = texture->path;
+        }
+        return record;
+    }
+
+    template<typename Writer>
+    void writeEntity(const EntityRecord &record, Writer &writer) {
+        writer.StartObject();
+        writeString(writer, "tag", record.tag);
+        writeString(writer, "uuid", record.uuid);
+
+        if (const auto &transform = record.transform) {
+            writeKey(writer, "transform");
+            writer.StartObject();
+            writeVector(writer, "position", transform->position);
+            writeVector(writer, "rotation", transform->rotation);
+            writeVector(writer, "scale", transform->scale);
+            writer.EndObject();
+        }
+
+        if (const auto &camera = record.camera) {
+            writeKey(writer, "camera");
+            writer.StartObject();
+            writeString(writer, "type", toCameraTypeName(camera->type));
+            writeKey(writer, "isPrimary");
+            writer.Bool(camera->isPrimary);
+            writeFloat(writer, "fov", camera->fov);
+            writeFloat(writer, "nearClip", camera->nearClip);
+            writeFloat(writer, "farClip", camera->farClip);
+            writeVector(writer, "target", camera->target);
+            writeFloat(writer, "distance", camera->distance);
+            writeFloat(writer, "yaw", camera->yaw);
+            writeFloat(writer, "pitch", camera->pitch);
+            writer.EndObject();
+        }
+
+        if (const auto &directionalLight = record.directionalLight) {
+            writeKey(writer, "directionalLight");
+            writer.StartObject();
+            writeVector(writer, "direction", directionalLight->direction);
+            writeVector(writer, "color", directionalLight->color);
+            writeVector(writer, "ambient", directionalLight->ambient);
+            writer.EndObject();
+        }
+
+        if (const auto &pointLight = record.pointLight) {
+            writeKey(writer, "pointLight");
+            writer.StartObject();
+            writeVector(writer, "position", pointLight->position);
+            writeVector(writer, "color", pointLight->color);
+            writeFloat(writer, "constant", pointLight->constant);
+            writeFloat(writer, "linear", pointLight->linear);
+            writeFloat(writer, "quadratic", pointLight->quadratic);
+            writer.EndObject();
+        }
+
+        if (const auto &spotLight = record.spotLight) {
+            writeKey(writer, "spotLight");
+            writer.StartObject();
+            writeVector(writer, "position", spotLight->position);
+            writeVector(writer, "direction", spotLight->direction);
+            writeVector(writer, "color", spotLight->color);
+            writeFloat(writer, "cutOff", spotLight->cutOff);
+            writeFloat(writer, "outerCutOff", spotLight->outerCutOff);
+            writeFloat(writer, "range", spotLight->range);
+            writer.EndObject();
+        }
+
+        if (record.quadColor) {
+            writeMeshColor(writer, "quad", *record.quadColor);
+        }
+
+        if (record.cubeColor) {
+            writeMeshColor(writer, "cube", *record.cubeColor);
+        }
+
+        if (record.texturePath) {
+            writeKey(writer, "texture");
+            writer.StartObject();
+            writeString(writer, "path", *record.texturePath);
+            writer.EndObject();
+        }
+
+        writer.EndObject();
+    }
+
+    // Emits a captured scene as SAX events
+    template<typename Writer>
+    void writeScene(const std::string &sceneName, const std::vector<EntityRecord> &entities, Writer &writer) {
+        writer.StartObject();
+        writeString(writer, "name", sceneName);
+        writeString(writer, "type", "scene");
+
+        writeKey(writer, "entities");
+        writer.StartArray();
+        for (const EntityRecord &entity: entities) {
+            writeEntity(entity, writer);
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+    EntityRecord readEntity(simdjson::ondemand::object object) {
+        EntityRecord record;
+        for (auto field: object) {
+            const std::string_view key = field.unescaped_key();
+            if (key == "tag") {
+                record.tag = std::string_view(field.value().get_string());
+            } else if (key == "uuid") {
+                record.uuid = std::string_view(field.value().get_string());
+            } else if (key == "transform") {
+                record.transform = readTransform(field.value().get_object());
+            } else if (key == "camera") {
+                record.camera = readCamera(field.value().get_object());
+            } else if (key == "directionalLight") {
+                record.directionalLight = readDirectionalLight(field.value().get_object());
+            } else if (key == "pointLight") {
+                record.pointLight = readPointLight(field.value().get_object());
+            } else if (key == "spotLight") {
+                record.spotLight = readSpotLight(field.value().get_object());
+            } else if (key == "quad") {
+                record.quadColor = readMeshColor(field.value().get_object());
+            } else if (key == "cube") {
+                record.cubeColor = readMeshColor(field.value().get_object());
+            } else if (key == "texture") {
+                record.texturePath = readTexturePath(field.value().get_object());
+            }
+        }
+        return record;
+    }
+
+    entt::entity createEntity(EntityComponentSystem &ecs, const EntityRecord &record) {
+        GameObject gameObject = ecs.createGameObject(record.tag, record.uuid);
+
+        if (const auto &transform = record.transform) {
+            gameObject.addComponent<TransformComponent>(transform->position, transform->rotation,
+                                                        transform->scale);
+        }
+        if (record.camera) {
+            gameObject.addComponent<CameraComponent>(*record.camera);
+        }
+        if (record.directionalLight) {
+            gameObject.addComponent<DirectionalLightComponent>(*record.directionalLight);
+        }
+        if (record.pointLight) {
+            gameObject.addComponent<PointLightComponent>(*record.pointLight);
+        }
+        if (record.spotLight) {
+            gameObject.addComponent<SpotLightComponent>(*record.spotLight);
+        }
+        if (record.quadColor) {
+            gameObject.addComponent<QuadComponent>().mesh.color = *record.quadColor;
+        }
+        if (record.cubeColor) {
+            gameObject.addComponent<CubeComponent>().mesh.color = *record.cubeColor;
+        }
+        if (record.texturePath) {
+            gameObject.addComponent<TextureComponent>(*record.texturePath);
+        }
+        return gameObject.getEntity();
+    }
+}
+
 
 SceneSerializer::SceneSerializer(Scene &scene): _scene(scene) {
     // Constructor implementation
 }
 
 bool SceneSerializer::saveToFile(const std::string &filePath) const {
-    // Serialize the scene to a JSON file
-    rapidjson::Document document;
-    document.SetObject();
+    std::vector<EntityRecord> entities;
+    capture(entities);
+    return saveRecords(filePath, _scene.getName(), entities);
+}
 
-    toJson(document);
+void SceneSerializer::capture(std::vector<EntityRecord> &entities) const {
+    const entt::registry &registry = _scene.getEntityComponentSystem().getRegistry();
+    entities.clear();
+    for (const auto entity: registry.view<TagComponent, IdComponent>()) {
+        entities.push_back(captureEntity(registry, entity));
+    }
+}
 
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer writer(buffer);
-    document.Accept(writer);
+bool SceneSerializer::saveRecords(const std::string &filePath, const std::string &sceneName,
+                                  const std::vector<EntityRecord> &entities) {
+    // written next to the target and renamed over it, so a failed save never leaves a truncated scene behind
+    const std::string tempPath = filePath + ".tmp";
+    FILE *file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Could not create file for writing: {}", tempPath);
+        return false;
+    }
 
-    std::ofstream ofs(filePath);
-    if (!ofs.is_open()) {
-        ofs.open(filePath, std::ofstream::out | std::ofstream::trunc);
-        if (!ofs.is_open()) {
-            LOG_ERROR("Could not create file for writing: {}", filePath);
-            return false;
-        }
+    // the JSON goes straight from the records into the file buffer, no document or string copy in between
+    std::vector<char> buffer(WRITE_BUFFER_BYTES);
+    rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+    rapidjson::Writer writer(stream);
+    writeScene(sceneName, entities, writer);
+    stream.Flush();
+
+    const bool written = writer.IsComplete() && std::ferror(file) == 0;
+    std::error_code error;
+    if (std::fclose(file) != 0 || !written) {
+        LOG_ERROR("Could not write scene file: {}", tempPath);
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        LOG_ERROR("Could not replace scene file '{}': {}", filePath, error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
     }
-    ofs << buffer.GetString();
     return true;
 }
 
-
 bool SceneSerializer::loadFromFile(const std::string &filePath) const {
+    return loadFromFile(filePath, JsonSettings::getLoadBackend());
+}
+
+bool SceneSerializer::loadFromFile(const std::string &filePath, const JsonBackend backend) const {
     // Clear out any existing entities
     _scene.getEntityComponentSystem().cleanup();
 
@@ -52,6 +483,13 @@ bool SceneSerializer::loadFromFile(const std::string &filePath) const {
         return false;
     }
 
+    if (backend == JsonBackend::Simdjson) {
+        return _loadWithSimdjson(filePath);
+    }
+    return _loadWithRapidJson(filePath);
+}
+
+bool SceneSerializer::_loadWithRapidJson(const std::string &filePath) const {
     // Read the file into a string
     std::ifstream ifs(filePath);
     if (!ifs.is_open()) {
@@ -83,193 +521,13 @@ bool SceneSerializer::loadFromFile(const std::string &filePath) const {
 }
 
 void SceneSerializer::toJson(rapidjson::Document &document) const {
-    auto &allocator = document.GetAllocator();
-
-    // Add scene metadata
-    document.AddMember("name", rapidjson::Value(_scene.getName().c_str(), allocator), allocator);
-    document.AddMember("type", rapidjson::Value("scene", allocator), allocator);
-
-    rapidjson::Value entities(rapidjson::kArrayType);
-
-    // Iterate once over all entities with Tag and Id
-    for (auto view = _scene.getEntityComponentSystem().getAllGameObjects<TagComponent, IdComponent>(); auto entity:
-         view) {
-        rapidjson::Value entityObject(rapidjson::kObjectType);
-        auto &[tag] = view.get<TagComponent>(entity);
-        auto &[uuid] = view.get<IdComponent>(entity);
-
-        entityObject.AddMember("tag", rapidjson::Value(tag.c_str(), allocator), allocator);
-        entityObject.AddMember("uuid", rapidjson::Value(uuid.c_str(), allocator), allocator);
-
-        // Transform
-        if (_scene.getEntityComponentSystem().hasComponent<TransformComponent>(entity)) {
-            auto &transform = _scene.getEntityComponentSystem().getComponent<TransformComponent>(entity);
-            rapidjson::Value transformObject(rapidjson::kObjectType);
-
-            rapidjson::Value position(rapidjson::kArrayType);
-            position.PushBack(transform.position.x, allocator)
-                    .PushBack(transform.position.y, allocator)
-                    .PushBack(transform.position.z, allocator);
-            transformObject.AddMember("position", position, allocator);
-
-            rapidjson::Value rotation(rapidjson::kArrayType);
-            rotation.PushBack(transform.rotation.x, allocator)
-                    .PushBack(transform.rotation.y, allocator)
-                    .PushBack(transform.rotation.z, allocator);
-            transformObject.AddMember("rotation", rotation, allocator);
-
-            rapidjson::Value scale(rapidjson::kArrayType);
-            scale.PushBack(transform.scale.x, allocator)
-                    .PushBack(transform.scale.y, allocator)
-                    .PushBack(transform.scale.z, allocator);
-            transformObject.AddMember("scale", scale, allocator);
-
-            entityObject.AddMember("transform", transformObject, allocator);
-        }
-
-        // Camera
-        if (_scene.getEntityComponentSystem().hasComponent<CameraComponent>(entity)) {
-            auto &camera = _scene.getEntityComponentSystem().getComponent<CameraComponent>(entity);
-            rapidjson::Value cameraObject(rapidjson::kObjectType);
-            // Add a camera type
-            if (camera.type == CameraComponentType::Editor) {
-                cameraObject.AddMember("type", rapidjson::Value("editor", allocator), allocator);
-            } else if (camera.type == CameraComponentType::Game) {
-                cameraObject.AddMember("type", rapidjson::Value("game", allocator), allocator);
-            } else if (camera.type == CameraComponentType::UI) {
-                cameraObject.AddMember("type", rapidjson::Value("ui", allocator), allocator);
-            } else {
-                cameraObject.AddMember("type", rapidjson::Value("unknown", allocator), allocator);
-            }
-            cameraObject.AddMember("isPrimary", camera.isPrimary, allocator);
-            cameraObject.AddMember("fov", camera.fov, allocator);
-            cameraObject.AddMember("nearClip", camera.nearClip, allocator);
-            cameraObject.AddMember("farClip", camera.farClip, allocator);
-
-            rapidjson::Value targetObject(rapidjson::kObjectType);
-            rapidjson::Value targetArray(rapidjson::kArrayType);
-            targetArray.PushBack(camera.target.x, allocator)
-                    .PushBack(camera.target.y, allocator)
-                    .PushBack(camera.target.z, allocator);
-            cameraObject.AddMember("target", targetArray, allocator);
-            cameraObject.AddMember("distance", camera.distance, allocator);
-            cameraObject.AddMember("yaw", camera.yaw, allocator);
-            cameraObject.AddMember("pitch", camera.pitch, allocator);
-
-            entityObject.AddMember("camera", cameraObject, allocator);
-        }
-
-        // Directional light component
-        if (_scene.getEntityComponentSystem().hasComponent<DirectionalLightComponent>(entity)) {
-            auto &directionlLight = _scene.getEntityComponentSystem().getComponent<DirectionalLightComponent>(entity);
-            rapidjson::Value directionalLightObject(rapidjson::kObjectType);
-            rapidjson::Value directionArray(rapidjson::kArrayType);
-            directionArray.PushBack(directionlLight.direction.x, allocator)
-                    .PushBack(directionlLight.direction.y, allocator)
-                    .PushBack(directionlLight.direction.z, allocator);
-            directionalLightObject.AddMember("direction", directionArray, allocator);
-
-            rapidjson::Value colorArray(rapidjson::kArrayType);
-            colorArray.PushBack(directionlLight.color.r, allocator)
-                    .PushBack(directionlLight.color.g, allocator)
-                    .PushBack(directionlLight.color.b, allocator);
-            directionalLightObject.AddMember("color", colorArray, allocator);
-
-            rapidjson::Value ambientArray(rapidjson::kArrayType);
-            ambientArray.PushBack(directionlLight.ambient.r, allocator)
-                    .PushBack(directionlLight.ambient.g, allocator)
-                    .PushBack(directionlLight.ambient.b, allocator);
-            directionalLightObject.AddMember("ambient", ambientArray, allocator);
-            entityObject.AddMember("directionalLight", directionalLightObject, allocator);
-        }
-
-        // Point light component
-        if (_scene.getEntityComponentSystem().hasComponent<PointLightComponent>(entity)) {
-            auto &pointLight = _scene.getEntityComponentSystem().getComponent<PointLightComponent>(entity);
-            rapidjson::Value pointLightObject(rapidjson::kObjectType);
-            rapidjson::Value position(rapidjson::kArrayType);
-            position.PushBack(pointLight.position.x, allocator)
-                    .PushBack(pointLight.position.y, allocator)
-                    .PushBack(pointLight.position.z, allocator);
-
-            rapidjson::Value color(rapidjson::kArrayType);
-            color.PushBack(pointLight.color.r, allocator)
-                    .PushBack(pointLight.color.g, allocator)
-                    .PushBack(pointLight.color.b, allocator);
-
-            pointLightObject.AddMember("position", position, allocator);
-            pointLightObject.AddMember("color", color, allocator);
-            pointLightObject.AddMember("constant", pointLight.constant, allocator);
-            pointLightObject.AddMember("linear", pointLight.linear, allocator);
-            pointLightObject.AddMember("quadratic", pointLight.quadratic, allocator);
-            entityObject.AddMember("pointLight", pointLightObject, allocator);
-        }
-
-        // Spotlight component
-        if (_scene.getEntityComponentSystem().hasComponent<SpotLightComponent>(entity)) {
-            auto &spotLight = _scene.getEntityComponentSystem().getComponent<SpotLightComponent>(entity);
-            rapidjson::Value spotLightObject(rapidjson::kObjectType);
-            rapidjson::Value position(rapidjson::kArrayType);
-            position.PushBack(spotLight.position.x, allocator)
-                    .PushBack(spotLight.position.y, allocator)
-                    .PushBack(spotLight.position.z, allocator);
-
-            rapidjson::Value direction(rapidjson::kArrayType);
-            direction.PushBack(spotLight.direction.x, allocator)
-                    .PushBack(spotLight.direction.y, allocator)
-                    .PushBack(spotLight.direction.z, allocator);
-
-            rapidjson::Value color(rapidjson::kArrayType);
-            color.PushBack(spotLight.color.r, allocator)
-                    .PushBack(spotLight.color.g, allocator)
-                    .PushBack(spotLight.color.b, allocator);
-
-            spotLightObject.AddMember("position", position, allocator);
-            spotLightObject.AddMember("direction", direction, allocator);
-            spotLightObject.AddMember("color", color, allocator);
-            spotLightObject.AddMember("cutOff", spotLight.cutOff, allocator);
-            spotLightObject.AddMember("outerCutOff", spotLight.outerCutOff, allocator);
-            entityObject.AddMember("spotLight", spotLightObject, allocator);
-        }
-
-        // Quad component
-        if (_scene.getEntityComponentSystem().hasComponent<QuadComponent>(entity)) {
-            auto &quad = _scene.getEntityComponentSystem().getComponent<QuadComponent>(entity);
-            rapidjson::Value quadObject(rapidjson::kObjectType);
-            rapidjson::Value color(rapidjson::kArrayType);
-            color.PushBack(quad.mesh.color.r, allocator)
-                    .PushBack(quad.mesh.color.g, allocator)
-                    .PushBack(quad.mesh.color.b, allocator)
-                    .PushBack(quad.mesh.color.a, allocator);
-            quadObject.AddMember("color", color, allocator);
-            entityObject.AddMember("quad", quadObject, allocator);
-        }
-
-        // Cube component
-        if (_scene.getEntityComponentSystem().hasComponent<CubeComponent>(entity)) {
-            auto &cube = _scene.getEntityComponentSystem().getComponent<CubeComponent>(entity);
-            rapidjson::Value cubeObject(rapidjson::kObjectType);
-            rapidjson::Value color(rapidjson::kArrayType);
-            color.PushBack(cube.mesh.color.r, allocator)
-                    .PushBack(cube.mesh.color.g, allocator)
-                    .PushBack(cube.mesh.color.b, allocator)
-                    .PushBack(cube.mesh.color.a, allocator);
-            cubeObject.AddMember("color", color, allocator);
-            entityObject.AddMember("cube", cubeObject, allocator);
-        }
-
-        // Texture component
-        if (_scene.getEntityComponentSystem().hasComponent<TextureComponent>(entity)) {
-            auto &texture = _scene.getEntityComponentSystem().getComponent<TextureComponent>(entity);
-            rapidjson::Value textureObject(rapidjson::kObjectType);
-            textureObject.AddMember("path", rapidjson::Value(texture.path.c_str(), allocator), allocator);
-            entityObject.AddMember("texture", textureObject, allocator);
-        }
-
-        entities.PushBack(entityObject, allocator);
-    }
-
-    document.AddMember("entities", entities, allocator);
+    // goes through the same writer as saveToFile so the two outputs can't drift apart
+    std::vector<EntityRecord> entities;
+    capture(entities);
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer writer(buffer);
+    writeScene(_scene.getName(), entities, writer);
+    document.Parse(buffer.GetString(), buffer.GetSize());
 }
 
 void SceneSerializer::fromJson(const rapidjson::Document &document) const {
@@ -278,14 +536,8 @@ void SceneSerializer::fromJson(const rapidjson::Document &document) const {
         const std::string tag = entityValue["tag"].GetString();
         const std::string uuid = entityValue["uuid"].GetString();
 
-        // Create the GameObject (also auto‐adds Tag and a fresh IdComponent)
-        GameObject gameObject = _scene.getEntityComponentSystem().createGameObject(tag);
-
-        // Override the generated IdComponent with the saved uuid
-        {
-            auto &idCompenent = gameObject.getComponent<IdComponent>();
-            idCompenent.uuid = uuid;
-        }
+        // Create the GameObject with its saved Tag and IdComponent
+        GameObject gameObject = _scene.getEntityComponentSystem().createGameObject(tag, uuid);
 
         // Restore TransformComponent
         if (entityValue.HasMember("transform")) {
@@ -307,7 +559,9 @@ void SceneSerializer::fromJson(const rapidjson::Document &document) const {
 
             // Replace or add
             if (gameObject.hasComponent<TransformComponent>()) {
-                gameObject.getComponent<TransformComponent>() = transformComponent;
+                gameObject.patchComponent<TransformComponent>([&transformComponent](TransformComponent &transform) {
+                    transform = transformComponent;
+                });
             } else {
                 gameObject.addComponent<TransformComponent>(
                     transformComponent.position, transformComponent.rotation, transformComponent.scale
@@ -459,6 +713,10 @@ void SceneSerializer::fromJson(const rapidjson::Document &document) const {
             }
             spotLightComponent.cutOff = cutOff;
             spotLightComponent.outerCutOff = outerCutOff;
+            // older scenes were saved before spotlights had a range
+            if (spotLightObject.HasMember("range")) {
+                spotLightComponent.range = spotLightObject["range"].GetFloat();
+            }
 
             // Add if missing
             if (!gameObject.hasComponent<SpotLightComponent>()) {
@@ -510,8 +768,204 @@ void SceneSerializer::fromJson(const rapidjson::Document &document) const {
             if (!gameObject.hasComponent<TextureComponent>()) {
                 gameObject.addComponent<TextureComponent>(path);
             } else {
-                gameObject.getComponent<TextureComponent>().path = path;
+                gameObject.getComponent<TextureComponent>().load(path);
             }
         }
     }
 }
+
+bool SceneSerializer::parseFile(const std::string &filePath, std::vector<EntityRecord> &entities) {
+    entities.clear();
+
+    simdjson::padded_string json;
+    if (const auto error = simdjson::padded_string::load(filePath).get(json)) {
+        LOG_ERROR("Failed to open scene file '{}': {}", filePath, simdjson::error_message(error));
+        return false;
+    }
+
+    try {
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document document = parser.iterate(json);
+
+        simdjson::ondemand::array array;
+        if (document["entities"].get_array().get(array)) {
+            LOG_WARN("Scene JSON is missing \"entities\": {}", filePath);
+            return false;
+        }
+
+        for (auto entityValue: array) {
+            entities.push_back(readEntity(entityValue.get_object()));
+        }
+    } catch (const simdjson::simdjson_error &error) {
+        // don't leave half a scene behind
+        entities.clear();
+        LOG_ERROR("Scene JSON is invalid: {} ({})", filePath, error.what());
+        return false;
+    }
+    return true;
+}
+
+void SceneSerializer::instantiate(const std::vector<EntityRecord> &entities) const {
+    auto &ecs = _scene.getEntityComponentSystem();
+    ecs.cleanup();
+    for (const EntityRecord &entity: entities) {
+        createEntity(ecs, entity);
+    }
+}
+
+bool SceneSerializer::_loadWithSimdjson(const std::string &filePath) const {
+    std::vector<EntityRecord> entities;
+    if (!parseFile(filePath, entities)) {
+        return false;
+    }
+    instantiate(entities);
+
+    LOG_INFO("Loading scene from '{}'", filePath);
+    return true;
+}
+
+bool SceneSerializer::appendToJournal(const std::string &journalPath, const std::vector<entt::entity> &entities,
+                                      const std::vector<std::string> &removedUuids) const {
+    FILE *file = std::fopen(journalPath.c_str(), "ab");
+    if (!file) {
+        LOG_ERROR("Could not open scene journal for writing: {}", journalPath);
+        return false;
+    }
+
+    // one record per line, so a crash in the middle of an append can only tear the last one
+    std::vector<char> buffer(WRITE_BUFFER_BYTES);
+    rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+    rapidjson::Writer writer(stream);
+
+    for (const auto &uuid: removedUuids) {
+        writer.Reset(stream);
+        writer.StartObject();
+        writeString(writer, "remove", uuid);
+        writer.EndObject();
+        stream.Put('\n');
+    }
+
+    const entt::registry &registry = _scene.getEntityComponentSystem().getRegistry();
+    for (const auto entity: entities) {
+        // destroyed after being changed, its removal is already in the list above
+        if (!registry.valid(entity) || !registry.all_of<TagComponent, IdComponent>(entity)) {
+            continue;
+        }
+        writer.Reset(stream);
+        writer.StartObject();
+        writeKey(writer, "upsert");
+        writeEntity(captureEntity(registry, entity), writer);
+        writer.EndObject();
+        stream.Put('\n');
+    }
+    stream.Flush();
+
+    const bool written = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !written) {
+        LOG_ERROR("Could not write scene journal: {}", journalPath);
+        return false;
+    }
+    return true;
+}
+
+bool SceneSerializer::replayJournal(const std::string &journalPath) const {
+    simdjson::padded_string json;
+    if (const auto error = simdjson::padded_string::load(journalPath).get(json)) {
+        LOG_ERROR("Failed to open scene journal '{}': {}", journalPath, simdjson::error_message(error));
+        return false;
+    }
+
+    auto &ecs = _scene.getEntityComponentSystem();
+    auto &registry = ecs.getRegistry();
+
+    std::unordered_map<std::string, entt::entity> entitiesByUuid;
+    for (const auto view = registry.view<IdComponent>(); const auto entity: view) {
+        entitiesByUuid.emplace(view.get<IdComponent>(entity).uuid, entity);
+    }
+
+    // later records win; an upsert replaces the whole entity rather than merging into it
+    std::size_t applied = 0;
+    std::size_t skipped = 0;
+    simdjson::ondemand::parser parser;
+    for (std::size_t lineStart = 0; lineStart < json.size();) {
+        const char *newline = static_cast<const char *>(
+            std::memchr(json.data() + lineStart, '\n', json.size() - lineStart));
+        const std::size_t lineEnd = newline ? static_cast<std::size_t>(newline - json.data()) : json.size();
+        const std::string_view line(json.data() + lineStart, lineEnd - lineStart);
+        const std::size_t recordStart = lineStart;
+        lineStart = newline ? lineEnd + 1 : lineEnd;
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+            continue;
+        }
+
+        // read the whole record before applying any of it, so a bad one leaves the scene alone
+        std::vector<std::string> removed;
+        std::vector<EntityRecord> upserted;
+        try {
+            // the rest of the file is padding as far as the parser is concerned, it stops at the end of the line
+            const std::size_t capacity = json.size() - recordStart + simdjson::SIMDJSON_PADDING;
+            simdjson::ondemand::document record = parser.iterate(
+                simdjson::padded_string_view(line.data(), line.size(), capacity));
+            for (auto field: record.get_object()) {
+                const std::string_view key = field.unescaped_key();
+                if (key == "remove") {
+                    removed.emplace_back(std::string_view(field.value().get_string()));
+                } else if (key == "upsert") {
+                    upserted.push_back(readEntity(field.value().get_object()));
+                }
+            }
+            if (!record.at_end()) {
+                throw simdjson::simdjson_error(simdjson::TRAILING_CONTENT);
+            }
+        } catch (const simdjson::simdjson_error &error) {
+            if (newline) {
+                // a damaged record in the middle: the ones after it are intact, so skip just this line
+                LOG_WARN("Skipped unreadable record at byte {} of scene journal '{}': {}", recordStart, journalPath,
+                         error.what());
+                ++skipped;
+                continue;
+            }
+
+            // a crash in the middle of an append leaves a torn last line. The next append would glue its first
+            // record onto it, so cut it off; everything before it has been read.
+            std::error_code resizeError;
+            std::filesystem::resize_file(journalPath, recordStart, resizeError);
+            if (resizeError) {
+                LOG_ERROR("Could not cut the torn record off scene journal '{}': {}", journalPath,
+                          resizeError.message());
+            } else {
+                LOG_WARN("Dropped a torn record of {} bytes at the end of scene journal '{}'", line.size(),
+                         journalPath);
+            }
+            break;
+        }
+
+        for (const auto &uuid: removed) {
+            if (const auto entity = entitiesByUuid.find(uuid); entity != entitiesByUuid.end()) {
+                registry.destroy(entity->second);
+                entitiesByUuid.erase(entity);
+            }
+        }
+        for (const EntityRecord &entity: upserted) {
+            if (const auto existing = entitiesByUuid.find(entity.uuid); existing != entitiesByUuid.end()) {
+                registry.destroy(existing->second);
+            }
+            entitiesByUuid[entity.uuid] = createEntity(ecs, entity);
+        }
+        ++applied;
+
+        // a complete last record that only lost its newline: restore it, so the next append starts a new line
+        if (!newline) {
+            if (FILE *file = std::fopen(journalPath.c_str(), "ab")) {
+                std::fputc('\n', file);
+                std::fclose(file);
+            }
+        }
+    }
+
+    if (skipped > 0) {
+        LOG_WARN("Skipped {} unreadable records in scene journal '{}'", skipped, journalPath);
+    }
+    LOG_INFO("Replayed {} records from scene journal '{}'", applied, journalPath);
+    return true;
+}
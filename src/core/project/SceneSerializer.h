@@ -9,20 +9,78 @@
 #ifndef SCENESERIALIZER_H
 #define SCENESERIALIZER_H
 
+#include "JsonBackend.h"
 #include "Scene.h"
+#include <optional>
 #include <rapidjson/document.h>
+#include <string>
+#include <vector>
 
 class SceneSerializer {
 public:
+    /**
+     * Components of one entity as plain data. The on-demand parser hands out fields in file order, so an entity
+     * is only created once its whole object has been read and the tag and uuid are known. Saves capture() the
+     * scene into records too, so the files can be written on a worker thread while the registry keeps changing.
+     */
+    struct EntityRecord {
+        std::string tag;
+        std::string uuid;
+        std::optional<TransformComponent> transform;
+        std::optional<CameraComponent> camera;
+        std::optional<DirectionalLightComponent> directionalLight;
+        std::optional<PointLightComponent> pointLight;
+        std::optional<SpotLightComponent> spotLight;
+        std::optional<glm::vec4> quadColor;
+        std::optional<glm::vec4> cubeColor;
+        std::optional<std::string> texturePath;
+    };
+
     explicit SceneSerializer(Scene &scene);
 
+    // capture() then saveRecords() on the calling thread
     bool saveToFile(const std::string &filePath) const;
+
+    // Copies every entity the scene file holds; reads the registry, so it runs on the main thread
+    void capture(std::vector<EntityRecord> &entities) const;
+
+    // Writes captured entities as a scene file; touches no registry, so it may run on any thread
+    static bool saveRecords(const std::string &filePath, const std::string &sceneName,
+                            const std::vector<EntityRecord> &entities);
+
+    // Parses with the backend selected in JsonSettings
     bool loadFromFile(const std::string &filePath) const;
 
+    bool loadFromFile(const std::string &filePath, JsonBackend backend) const;
+
+    /**
+     * Appends the current state of the given entities, and removals of entities that no longer exist, to a
+     * JSON-lines journal. Each record is {"upsert": entity} or {"remove": uuid}.
+     */
+    bool appendToJournal(const std::string &journalPath, const std::vector<entt::entity> &entities,
+                         const std::vector<std::string> &removedUuids) const;
+
+    // Applies a journal on top of the entities already loaded, matching them by uuid
+    bool replayJournal(const std::string &journalPath) const;
+
+    /**
+     * Reads the entities of a scene file with simdjson without touching a registry, so it can run on a worker
+     * thread; instantiate() then creates them on the main thread. On failure `entities` is left empty.
+     */
+    static bool parseFile(const std::string &filePath, std::vector<EntityRecord> &entities);
+
+    // Replaces the scene's entities with the given ones
+    void instantiate(const std::vector<EntityRecord> &entities) const;
+
     void toJson(rapidjson::Document &document) const;
     void fromJson(const rapidjson::Document &document) const;
 private:
     Scene &_scene;
+
+    bool _loadWithRapidJson(const std::string &filePath) const;
+
+    // parseFile() then instantiate(); no DOM is built
+    bool _loadWithSimdjson(const std::string &filePath) const;
 };
 
 
@@ -0,0 +1,608 @@
+/**
+ * @file    SceneSnapshot.cpp
+ * @brief   SceneSnapshot class implementation file
+ * @details This file contains the implementation of the SceneSnapshot class which saves and loads scenes in the
+ *          binary, column oriented `.cbscene` format.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "SceneSnapshot.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "SceneSerializer.h"
+#include "../ecs/Components.h"
+#include "../../utilities/Logger.h"
+#include "../../utilities/MappedFile.h"
+
+namespace {
+    // Fixed-size column records; only 4-byte fields so they can be read in place from the mapping
+    struct TransformRecord {
+        float position[3];
+        float rotation[3];
+        float scale[3];
+    };
+
+    struct CameraRecord {
+        std::uint32_t type;
+        std::uint32_t isPrimary;
+        float fov;
+        float nearClip;
+        float farClip;
+        float target[3];
+        float distance;
+        float yaw;
+        float pitch;
+        float orthographic[4]; // left, right, bottom, top
+    };
+
+    struct DirectionalLightRecord {
+        float direction[3];
+        float color[3];
+        float ambient[3];
+    };
+
+    struct PointLightRecord {
+        float position[3];
+        float color[3];
+        float constant;
+        float linear;
+        float quadratic;
+    };
+
+    struct SpotLightRecord {
+        float position[3];
+        float direction[3];
+        float color[3];
+        float cutOff;
+        float outerCutOff;
+        float range;
+    };
+
+    struct ColorRecord {
+        float rgba[4];
+    };
+
+    using StringRecord = std::uint32_t;
+
+    constexpr std::uint32_t DENSE = 0; // entitiesOffset of a column that covers every entity
+
+    void put(float (&out)[3], const glm::vec3 &value) {
+        out[0] = value.x;
+        out[1] = value.y;
+        out[2] = value.z;
+    }
+
+    glm::vec3 get(const float (&in)[3]) {
+        return {in[0], in[1], in[2]};
+    }
+
+    std::uint64_t alignTo8(const std::uint64_t value) {
+        return (value + 7u) & ~static_cast<std::uint64_t>(7u);
+    }
+
+    struct PendingColumn {
+        SceneSnapshot::Column id;
+        std::uint32_t stride;
+        std::uint32_t count = 0;
+        bool dense = false;
+        std::vector<std::uint32_t> entities;
+        std::vector<unsigned char> data;
+    };
+
+    class StringTable {
+    public:
+        std::uint32_t intern(const std::string &text) {
+            const auto [it, inserted] = _indices.try_emplace(text, static_cast<std::uint32_t>(_offsets.size() - 1));
+            if (inserted) {
+                _data.insert(_data.end(), text.begin(), text.end());
+                _offsets.push_back(static_cast<std::uint32_t>(_data.size()));
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] std::uint32_t size() const { return static_cast<std::uint32_t>(_offsets.size() - 1); }
+        [[nodiscard]] const std::vector<std::uint32_t> &offsets() const { return _offsets; }
+        [[nodiscard]] const std::vector<char> &data() const { return _data; }
+
+    private:
+        std::unordered_map<std::string, std::uint32_t> _indices;
+        std::vector<std::uint32_t> _offsets{0};
+        std::vector<char> _data;
+    };
+
+    using EntityRecord = SceneSerializer::EntityRecord;
+
+    // Append one record per entity whose `member` is set, converted by `convert`
+    template<typename Record, typename Component, typename Convert>
+    void gatherColumn(const std::vector<EntityRecord> &entities, const SceneSnapshot::Column id,
+                      std::optional<Component> EntityRecord::*member, Convert convert,
+                      std::vector<PendingColumn> &columns) {
+        PendingColumn column{id, sizeof(Record)};
+        for (std::uint32_t i = 0; i < entities.size(); ++i) {
+            if (const auto &component = entities[i].*member) {
+                const Record record = convert(*component);
+                const auto *bytes = reinterpret_cast<const unsigned char *>(&record);
+                column.data.insert(column.data.end(), bytes, bytes + sizeof(Record));
+                column.entities.push_back(i);
+            }
+        }
+        column.count = static_cast<std::uint32_t>(column.entities.size());
+        if (column.count > 0) {
+            columns.push_back(std::move(column));
+        }
+    }
+
+    // Validated view of a mapped snapshot
+    class SnapshotReader {
+    public:
+        bool open(const std::string &path) {
+            if (!_file.open(path)) {
+                LOG_ERROR("Failed to open scene snapshot '{}'", path);
+                return false;
+            }
+
+            const unsigned char *data = _file.data();
+            const std::size_t size = _file.size();
+            if (size < sizeof(SceneSnapshotHeader)) {
+                LOG_ERROR("Scene snapshot '{}' is truncated", path);
+                return false;
+            }
+
+            _header = reinterpret_cast<const SceneSnapshotHeader *>(data);
+            if (std::memcmp(_header->magic, SceneSnapshot::MAGIC, sizeof(SceneSnapshot::MAGIC)) != 0) {
+                LOG_ERROR("'{}' is not a scene snapshot", path);
+                return false;
+            }
+            if (_header->version != SceneSnapshot::VERSION) {
+                LOG_WARN("Scene snapshot '{}' has version {}, expected {}", path, _header->version,
+                         SceneSnapshot::VERSION);
+                return false;
+            }
+
+            const std::uint64_t offsetsBytes = (static_cast<std::uint64_t>(_header->stringCount) + 1) * 4;
+            const std::uint64_t columnBytes = static_cast<std::uint64_t>(_header->columnCount) *
+                                              sizeof(SceneSnapshotColumn);
+            if (!_inside(_header->stringOffsetsOffset, offsetsBytes) ||
+                !_inside(_header->columnTableOffset, columnBytes)) {
+                LOG_ERROR("Scene snapshot '{}' points outside of the file", path);
+                return false;
+            }
+
+            _stringOffsets = reinterpret_cast<const std::uint32_t *>(data + _header->stringOffsetsOffset);
+            _strings = reinterpret_cast<const char *>(data + _header->stringDataOffset);
+            for (std::uint32_t i = 0; i < _header->stringCount; ++i) {
+                if (_stringOffsets[i] > _stringOffsets[i + 1]) {
+                    LOG_ERROR("Scene snapshot '{}' has a corrupt string table", path);
+                    return false;
+                }
+            }
+            if (!_inside(_header->stringDataOffset, _stringOffsets[_header->stringCount])) {
+                LOG_ERROR("Scene snapshot '{}' has a corrupt string table", path);
+                return false;
+            }
+
+            _columns = reinterpret_cast<const SceneSnapshotColumn *>(data + _header->columnTableOffset);
+            std::unordered_set<std::uint32_t> columnIds;
+            for (std::uint32_t i = 0; i < _header->columnCount; ++i) {
+                const SceneSnapshotColumn &column = _columns[i];
+                // a second column of the same kind would add its component to entities that already have it
+                if (!columnIds.insert(column.id).second) {
+                    LOG_ERROR("Scene snapshot '{}' has column {} more than once", path, column.id);
+                    return false;
+                }
+                const bool dense = column.entitiesOffset == DENSE;
+                if ((dense && column.count != _header->entityCount) || column.count > _header->entityCount ||
+                    (!dense && !_inside(column.entitiesOffset, static_cast<std::uint64_t>(column.count) * 4)) ||
+                    !_inside(column.dataOffset, static_cast<std::uint64_t>(column.count) * column.stride)) {
+                    LOG_ERROR("Scene snapshot '{}' has a corrupt column {}", path, column.id);
+                    return false;
+                }
+                if (!dense) {
+                    const auto *indices = entityIndices(column);
+                    // strictly ascending, as written: a repeated index would add the component twice
+                    for (std::uint32_t e = 0; e < column.count; ++e) {
+                        if (indices[e] >= _header->entityCount || (e > 0 && indices[e] <= indices[e - 1])) {
+                            LOG_ERROR("Scene snapshot '{}' has a corrupt column {}", path, column.id);
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] const SceneSnapshotHeader &header() const { return *_header; }
+
+        [[nodiscard]] const SceneSnapshotColumn *columns() const { return _columns; }
+
+        [[nodiscard]] const std::uint32_t *entityIndices(const SceneSnapshotColumn &column) const {
+            return reinterpret_cast<const std::uint32_t *>(_file.data() + column.entitiesOffset);
+        }
+
+        template<typename Record>
+        [[nodiscard]] const Record *records(const SceneSnapshotColumn &column) const {
+            return reinterpret_cast<const Record *>(_file.data() + column.dataOffset);
+        }
+
+        // Out of range indices read as the empty string
+        [[nodiscard]] std::string string(const std::uint32_t index) const {
+            if (index >= _header->stringCount) {
+                return {};
+            }
+            return {_strings + _stringOffsets[index], _stringOffsets[index + 1] - _stringOffsets[index]};
+        }
+
+    private:
+        [[nodiscard]] bool _inside(const std::uint64_t offset, const std::uint64_t bytes) const {
+            return offset <= _file.size() && bytes <= _file.size() - offset;
+        }
+
+        MappedFile _file;
+        const SceneSnapshotHeader *_header = nullptr;
+        const std::uint32_t *_stringOffsets = nullptr;
+        const char *_strings = nullptr;
+        const SceneSnapshotColumn *_columns = nullptr;
+    };
+}
+
+SceneSnapshot::SceneSnapshot(Scene &scene) : _scene(scene) {
+}
+
+bool SceneSnapshot::saveToFile(const std::string &filePath) const {
+    // same entity set and order as the JSON format
+    std::vector<EntityRecord> entities;
+    SceneSerializer(_scene).capture(entities);
+    return saveRecords(filePath, _scene.getName(), entities);
+}
+
+bool SceneSnapshot::saveRecords(const std::string &filePath, const std::string &sceneName,
+                                const std::vector<SceneSerializer::EntityRecord> &entities) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    StringTable strings;
+    const std::uint32_t nameString = strings.intern(sceneName);
+    std::vector<PendingColumn> columns;
+
+    // tags and uuids cover every entity, no index list needed
+    for (const Column id: {Column::Tag, Column::Uuid}) {
+        PendingColumn column{id, sizeof(StringRecord)};
+        column.dense = true;
+        column.count = static_cast<std::uint32_t>(entities.size());
+        column.data.resize(entities.size() * sizeof(StringRecord));
+        auto *records = reinterpret_cast<StringRecord *>(column.data.data());
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            records[i] = strings.intern(id == Column::Tag ? entities[i].tag : entities[i].uuid);
+        }
+        columns.push_back(std::move(column));
+    }
+
+    gatherColumn<TransformRecord>(
+        entities, Column::Transform, &EntityRecord::transform, [](const TransformComponent &transform) {
+            TransformRecord record{};
+            put(record.position, transform.position);
+            put(record.rotation, transform.rotation);
+            put(record.scale, transform.scale);
+            return record;
+        }, columns);
+
+    gatherColumn<CameraRecord>(
+        entities, Column::Camera, &EntityRecord::camera, [](const CameraComponent &camera) {
+            CameraRecord record{};
+            record.type = static_cast<std::uint32_t>(camera.type);
+            record.isPrimary = camera.isPrimary ? 1u : 0u;
+            record.fov = camera.fov;
+            record.nearClip = camera.nearClip;
+            record.farClip = camera.farClip;
+            put(record.target, camera.target);
+            record.distance = camera.distance;
+            record.yaw = camera.yaw;
+            record.pitch = camera.pitch;
+            record.orthographic[0] = camera.orthographicLeft;
+            record.orthographic[1] = camera.orthographicRight;
+            record.orthographic[2] = camera.orthographicBottom;
+            record.orthographic[3] = camera.orthographicTop;
+            return record;
+        }, columns);
+
+    gatherColumn<DirectionalLightRecord>(
+        entities, Column::DirectionalLight, &EntityRecord::directionalLight, [](const DirectionalLightComponent &light) {
+            DirectionalLightRecord record{};
+            put(record.direction, light.direction);
+            put(record.color, light.color);
+            put(record.ambient, light.ambient);
+            return record;
+        }, columns);
+
+    gatherColumn<PointLightRecord>(
+        entities, Column::PointLight, &EntityRecord::pointLight, [](const PointLightComponent &light) {
+            PointLightRecord record{};
+            put(record.position, light.position);
+            put(record.color, light.color);
+            record.constant = light.constant;
+            record.linear = light.linear;
+            record.quadratic = light.quadratic;
+            return record;
+        }, columns);
+
+    gatherColumn<SpotLightRecord>(
+        entities, Column::SpotLight, &EntityRecord::spotLight, [](const SpotLightComponent &light) {
+            SpotLightRecord record{};
+            put(record.position, light.position);
+            put(record.direction, light.direction);
+            put(record.color, light.color);
+            record.cutOff = light.cutOff;
+            record.outerCutOff = light.outerCutOff;
+            record.range = light.range;
+            return record;
+        }, columns);
+
+    const auto toColorRecord = [](const glm::vec4 &color) {
+        return ColorRecord{{color.r, color.g, color.b, color.a}};
+    };
+    gatherColumn<ColorRecord>(entities, Column::Quad, &EntityRecord::quadColor, toColorRecord, columns);
+    gatherColumn<ColorRecord>(entities, Column::Cube, &EntityRecord::cubeColor, toColorRecord, columns);
+
+    gatherColumn<StringRecord>(
+        entities, Column::Texture, &EntityRecord::texturePath, [&strings](const std::string &path) {
+            return strings.intern(path);
+        }, columns);
+
+    // lay the sections out, then write the file in one go
+    SceneSnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entityCount = static_cast<std::uint32_t>(entities.size());
+    header.columnCount = static_cast<std::uint32_t>(columns.size());
+    header.stringCount = strings.size();
+    header.nameString = nameString;
+    header.stringOffsetsOffset = alignTo8(sizeof(SceneSnapshotHeader));
+    header.stringDataOffset = alignTo8(header.stringOffsetsOffset + strings.offsets().size() * 4);
+    header.columnTableOffset = alignTo8(header.stringDataOffset + strings.data().size());
+
+    std::vector<SceneSnapshotColumn> table(columns.size());
+    std::uint64_t end = header.columnTableOffset + table.size() * sizeof(SceneSnapshotColumn);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        table[i].id = static_cast<std::uint32_t>(columns[i].id);
+        table[i].count = columns[i].count;
+        table[i].stride = columns[i].stride;
+        if (columns[i].dense) {
+            table[i].entitiesOffset = DENSE;
+        } else {
+            table[i].entitiesOffset = alignTo8(end);
+            end = table[i].entitiesOffset + columns[i].entities.size() * 4;
+        }
+        table[i].dataOffset = alignTo8(end);
+        end = table[i].dataOffset + columns[i].data.size();
+    }
+
+    std::vector<unsigned char> buffer(end, 0);
+    const auto place = [&buffer](const std::uint64_t offset, const void *data, const std::size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(buffer.data() + offset, data, bytes);
+        }
+    };
+    place(0, &header, sizeof(header));
+    place(header.stringOffsetsOffset, strings.offsets().data(), strings.offsets().size() * 4);
+    place(header.stringDataOffset, strings.data().data(), strings.data().size());
+    place(header.columnTableOffset, table.data(), table.size() * sizeof(SceneSnapshotColumn));
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (!columns[i].dense) {
+            place(table[i].entitiesOffset, columns[i].entities.data(), columns[i].entities.size() * 4);
+        }
+        place(table[i].dataOffset, columns[i].data.data(), columns[i].data.size());
+    }
+
+    // same temp file and rename as the JSON, a snapshot is either the old one or the new one
+    const std::string tempPath = filePath + ".tmp";
+    std::error_code error;
+    {
+        std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            LOG_ERROR("Could not create file for writing: {}", tempPath);
+            return false;
+        }
+        ofs.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        ofs.close();
+        if (!ofs) {
+            LOG_ERROR("Failed to write scene snapshot '{}'", tempPath);
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        LOG_ERROR("Could not replace scene snapshot '{}': {}", filePath, error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    LOG_INFO("Saved scene snapshot '{}' ({} entities, {} KB) in {:.2f} ms", filePath, entities.size(),
+             buffer.size() / 1024, elapsed.count());
+    return true;
+}
+
+bool SceneSnapshot::loadFromFile(const std::string &filePath) const {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Clear out any existing entities
+    _scene.getEntityComponentSystem().cleanup();
+
+    SnapshotReader reader;
+    if (!reader.open(filePath)) {
+        return false;
+    }
+
+    entt::registry &registry = _scene.getEntityComponentSystem().getRegistry();
+    const SceneSnapshotHeader &header = reader.header();
+
+    std::vector<entt::entity> created(header.entityCount);
+    registry.create(created.begin(), created.end());
+
+    // entities of one column, in record order
+    std::vector<entt::entity> targets;
+    const auto columnEntities = [&](const SceneSnapshotColumn &column) -> const std::vector<entt::entity> & {
+        if (column.entitiesOffset == DENSE) {
+            return created;
+        }
+        const std::uint32_t *indices = reader.entityIndices(column);
+        targets.resize(column.count);
+        for (std::uint32_t i = 0; i < column.count; ++i) {
+            targets[i] = created[indices[i]];
+        }
+        return targets;
+    };
+
+    // bulk insert: convert a whole column into components, then hand them to the registry at once
+    const auto insertColumn = [&]<typename Component, typename Record>(const SceneSnapshotColumn &column,
+                                                                       auto convert) {
+        const std::vector<entt::entity> &entities = columnEntities(column);
+        const Record *records = reader.records<Record>(column);
+        std::vector<Component> components;
+        components.reserve(column.count);
+        for (std::uint32_t i = 0; i < column.count; ++i) {
+            components.push_back(convert(records[i]));
+        }
+        registry.insert<Component>(entities.begin(), entities.end(), components.begin());
+    };
+
+    // Record size of every known column; columns of another size come from a different layout and are skipped
+    const auto expectedStride = [](const Column id) -> std::uint32_t {
+        switch (id) {
+            case Column::Tag:
+            case Column::Uuid:
+            case Column::Texture:
+                return sizeof(StringRecord);
+            case Column::Transform:
+                return sizeof(TransformRecord);
+            case Column::Camera:
+                return sizeof(CameraRecord);
+            case Column::DirectionalLight:
+                return sizeof(DirectionalLightRecord);
+            case Column::PointLight:
+                return sizeof(PointLightRecord);
+            case Column::SpotLight:
+                return sizeof(SpotLightRecord);
+            case Column::Quad:
+            case Column::Cube:
+                return sizeof(ColorRecord);
+        }
+        return 0;
+    };
+
+    for (std::uint32_t c = 0; c < header.columnCount; ++c) {
+        const SceneSnapshotColumn &column = reader.columns()[c];
+        const auto id = static_cast<Column>(column.id);
+        if (expectedStride(id) == 0 || column.stride != expectedStride(id)) {
+            LOG_WARN("Skipping unknown column {} in scene snapshot '{}'", column.id, filePath);
+            continue;
+        }
+
+        switch (id) {
+            case Column::Tag:
+                insertColumn.operator()<TagComponent, StringRecord>(column, [&reader](const StringRecord record) {
+                    return TagComponent{reader.string(record)};
+                });
+                break;
+            case Column::Uuid:
+                insertColumn.operator()<IdComponent, StringRecord>(column, [&reader](const StringRecord record) {
+                    return IdComponent{reader.string(record)};
+                });
+                break;
+            case Column::Transform:
+                insertColumn.operator()<TransformComponent, TransformRecord>(
+                    column, [](const TransformRecord &record) {
+                        return TransformComponent(get(record.position), get(record.rotation), get(record.scale));
+                    });
+                break;
+            case Column::Camera:
+                insertColumn.operator()<CameraComponent, CameraRecord>(column, [](const CameraRecord &record) {
+                    CameraComponent camera;
+                    camera.type = record.type <= static_cast<std::uint32_t>(CameraComponentType::UI)
+                                      ? static_cast<CameraComponentType>(record.type)
+                                      : CameraComponentType::Game;
+                    camera.isPrimary = record.isPrimary != 0;
+                    camera.fov = record.fov;
+                    camera.nearClip = record.nearClip;
+                    camera.farClip = record.farClip;
+                    camera.target = get(record.target);
+                    camera.distance = record.distance;
+                    camera.yaw = record.yaw;
+                    camera.pitch = record.pitch;
+                    camera.orthographicLeft = record.orthographic[0];
+                    camera.orthographicRight = record.orthographic[1];
+                    camera.orthographicBottom = record.orthographic[2];
+                    camera.orthographicTop = record.orthographic[3];
+                    return camera;
+                });
+                break;
+            case Column::DirectionalLight:
+                insertColumn.operator()<DirectionalLightComponent, DirectionalLightRecord>(
+                    column, [](const DirectionalLightRecord &record) {
+                        return DirectionalLightComponent{
+                            get(record.direction), get(record.color), get(record.ambient)
+                        };
+                    });
+                break;
+            case Column::PointLight:
+                insertColumn.operator()<PointLightComponent, PointLightRecord>(
+                    column, [](const PointLightRecord &record) {
+                        return PointLightComponent{
+                            get(record.position), get(record.color), record.constant, record.linear,
+                            record.quadratic
+                        };
+                    });
+                break;
+            case Column::SpotLight:
+                insertColumn.operator()<SpotLightComponent, SpotLightRecord>(
+                    column, [](const SpotLightRecord &record) {
+                        return SpotLightComponent{
+                            get(record.position), get(record.direction), get(record.color), record.cutOff,
+                            record.outerCutOff, record.range
+                        };
+                    });
+                break;
+            case Column::Quad:
+            case Column::Cube: {
+                // meshes own GPU handles, so these are emplaced one by one
+                const std::vector<entt::entity> &entities = columnEntities(column);
+                const ColorRecord *records = reader.records<ColorRecord>(column);
+                for (std::uint32_t i = 0; i < column.count; ++i) {
+                    const glm::vec4 color(records[i].rgba[0], records[i].rgba[1], records[i].rgba[2],
+                                          records[i].rgba[3]);
+                    if (id == Column::Quad) {
+                        registry.emplace<QuadComponent>(entities[i]).mesh.color = color;
+                    } else {
+                        registry.emplace<CubeComponent>(entities[i]).mesh.color = color;
+                    }
+                }
+                break;
+            }
+            case Column::Texture: {
+                const std::vector<entt::entity> &entities = columnEntities(column);
+                const StringRecord *records = reader.records<StringRecord>(column);
+                for (std::uint32_t i = 0; i < column.count; ++i) {
+                    registry.emplace<TextureComponent>(entities[i], reader.string(records[i]));
+                }
+                break;
+            }
+        }
+    }
+
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    LOG_INFO("Loaded scene snapshot '{}' ({} entities) in {:.2f} ms", filePath, header.entityCount,
+             elapsed.count());
+    return true;
+}
+
+std::string SceneSnapshot::getSnapshotPath(const std::string &jsonPath) {
+    return std::filesystem::path(jsonPath).replace_extension(".cbscene").string();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file    SceneSnapshot.h
+ * @brief   SceneSnapshot class header file
+ * @details This file contains the definition of the SceneSnapshot class which saves and loads scenes in the binary
+ *          `.cbscene` format. Components are stored column by column (all transforms together, all point lights
+ *          together, ...) with tags, uuids and texture paths in one deduplicated string table. Loading maps the
+ *          file and creates entities and components in bulk. JSON (SceneSerializer) stays the interchange and diff
+ *          format; the snapshot is the fast runtime copy written next to it.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef SCENESNAPSHOT_H
+#define SCENESNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Scene.h"
+#include "SceneSerializer.h"
+
+// On-disk header, little endian; every section starts 8-byte aligned
+struct SceneSnapshotHeader {
+    char magic[4];                     // "CBSC"
+    std::uint32_t version;             // SceneSnapshot::VERSION
+    std::uint32_t entityCount;
+    std::uint32_t columnCount;
+    std::uint32_t stringCount;
+    std::uint32_t nameString;          // scene name, index into the string table
+    std::uint64_t stringOffsetsOffset; // uint32[stringCount + 1] byte offsets into the string data
+    std::uint64_t stringDataOffset;
+    std::uint64_t columnTableOffset;   // SceneSnapshotColumn[columnCount]
+};
+
+// One component column: `count` records of `stride` bytes, for the entities listed at entitiesOffset
+struct SceneSnapshotColumn {
+    std::uint32_t id;             // SceneSnapshot::Column
+    std::uint32_t count;
+    std::uint32_t stride;
+    std::uint32_t reserved;
+    std::uint64_t entitiesOffset; // uint32[count] strictly ascending entity indices; 0 when the column covers every entity
+    std::uint64_t dataOffset;
+};
+
+static_assert(sizeof(SceneSnapshotHeader) == 48, "SceneSnapshotHeader is read straight from disk");
+static_assert(sizeof(SceneSnapshotColumn) == 32, "SceneSnapshotColumn is read straight from disk");
+
+class SceneSnapshot {
+public:
+    static constexpr char MAGIC[4] = {'C', 'B', 'S', 'C'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    // Column ids are part of the format: append new ones, never renumber. Unknown columns are skipped on load.
+    enum class Column : std::uint32_t {
+        Tag = 1,
+        Uuid = 2,
+        Transform = 3,
+        Camera = 4,
+        DirectionalLight = 5,
+        PointLight = 6,
+        SpotLight = 7,
+        Quad = 8,
+        Cube = 9,
+        Texture = 10,
+    };
+
+    explicit SceneSnapshot(Scene &scene);
+
+    // SceneSerializer::capture() then saveRecords() on the calling thread
+    bool saveToFile(const std::string &filePath) const;
+
+    // Writes captured entities as a snapshot; touches no registry, so it may run on any thread
+    static bool saveRecords(const std::string &filePath, const std::string &sceneName,
+                            const std::vector<SceneSerializer::EntityRecord> &entities);
+
+    // Replaces the scene's entities with the snapshot's
+    bool loadFromFile(const std::string &filePath) const;
+
+    // `scenes/level.json` -> `scenes/level.cbscene`
+    static std::string getSnapshotPath(const std::string &jsonPath);
+
+private:
+    Scene &_scene;
+};
+
+
+#endif //SCENESNAPSHOT_H
@@ -71,8 +71,7 @@ void SplashScreen::render() {
         glGetUniformLocation(_shaderProgram.getProgramID(), "uTexture"),
         0
     );
-    glActiveTexture(GL_TEXTURE0);
-    _logoTexture.bind();
+    _logoTexture.bind(0);
     _logoQuad.draw();
 
     // Compute quad bottom in pixels
@@ -106,4 +105,6 @@ void SplashScreen::render() {
     _textRenderer->renderTextTopAligned(
         buildVersion, buildX, buildTopY, buildScale, {1, 1, 1}
     );
+    // both lines go out in a single draw
+    _textRenderer->flush();
 }
@@ -35,7 +35,7 @@ private:
     ShaderProgram _shaderProgram;
     Quad _logoQuad; // changed from GLuint to Quad
 
-    // Handles all text rendering (VAO/VBO + glyph textures)
+    // Handles all text rendering (VAO/VBO + glyph atlas)
     std::unique_ptr<TextRenderer> _textRenderer;
 };
 
@@ -17,6 +17,7 @@
 #include "../core/ecs/Components.h"
 #include "../utilities/Logger.h"
 #include "../core/ecs/GameObject.h"
+#include "../core/graphic/RenderState.h"
 #include "glm/gtc/type_ptr.hpp"
 #include "imgui/ImGuiFileDialog.h"
 #include "utilities/AssetsManager.h"
@@ -306,22 +307,22 @@ void Editor::renderScenePanel(SceneManager &sceneManager, const CameraManager &c
             _fboWidth = viewportWidth;
             _fboHeight = viewportHeight;
             _setCameraAspect(viewportWidth, viewportHeight);
-            glBindTexture(GL_TEXTURE_2D, _gameTexture);
+            RenderState::bindTexture(0, GL_TEXTURE_2D, _gameTexture);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, viewportWidth, viewportHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
             glBindRenderbuffer(GL_RENDERBUFFER, _gameDepth);
             glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, viewportWidth, viewportHeight);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            RenderState::bindTexture(0, GL_TEXTURE_2D, 0);
             glBindRenderbuffer(GL_RENDERBUFFER, 0);
         }
 
         // Render scene to FBO
         glBindFramebuffer(GL_FRAMEBUFFER, _gameFBO);
         glViewport(0, 0, _fboWidth, _fboHeight);
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LEQUAL);
+        RenderState::setDepthTest(true);
+        RenderState::setDepthFunc(GL_LEQUAL);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         sceneManager.render(cameraManager);
-        glDisable(GL_DEPTH_TEST);
+        RenderState::setDepthTest(false);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // Draw the image (get its screen position)
@@ -344,8 +345,9 @@ void Editor::renderScenePanel(SceneManager &sceneManager, const CameraManager &c
 
         // Manipulate if an entity is selected
         if (_selectedEntity != entt::null && ecs.hasComponent<TransformComponent>(_selectedEntity)) {
-            auto &transform = ecs.getComponent<TransformComponent>(_selectedEntity);
-            glm::mat4 model = transform.getMatrix();
+            // the cached world matrix is what the renderers drew this frame
+            const auto *world = ecs.getRegistry().try_get<WorldMatrixComponent>(_selectedEntity);
+            glm::mat4 model = world ? world->matrix : ecs.getComponent<TransformComponent>(_selectedEntity).getMatrix();
 
 
             ImGuizmo::Manipulate(
@@ -357,11 +359,9 @@ void Editor::renderScenePanel(SceneManager &sceneManager, const CameraManager &c
             );
 
             if (ImGuizmo::IsUsing()) {
-                float translation[3], rotation[3], scale[3];
-                ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(model), translation, rotation, scale);
-                transform.position = glm::make_vec3(translation);
-                transform.rotation = glm::make_vec3(rotation);
-                transform.scale = glm::make_vec3(scale);
+                ecs.patchComponent<TransformComponent>(_selectedEntity, [&model](TransformComponent &transform) {
+                    _setTransformFromMatrix(transform, model);
+                });
             }
         }
     } else {
@@ -517,7 +517,9 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
                     case 1: // Camera
                         ecs.addComponent<CameraComponent>(_selectedEntity);
                         // adjust the transform to a default position
-                        ecs.getComponent<TransformComponent>(_selectedEntity).position = glm::vec3(0.0f, 0.0f, 5.0f);
+                        ecs.patchComponent<TransformComponent>(_selectedEntity, [](TransformComponent &transform) {
+                            transform.position = glm::vec3(0.0f, 0.0f, 5.0f);
+                        });
                         break;
                     case 2: // Directional Lighting
                         ecs.addComponent<DirectionalLightComponent>(_selectedEntity);
@@ -553,9 +555,12 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             // Transform
             if (ImGui::CollapsingHeader("Transform")) {
                 ImGui::PushID("Transform");
-                ImGui::DragFloat3("Position", glm::value_ptr(transform.position), 0.2f);
-                ImGui::DragFloat3("Rotation", glm::value_ptr(transform.rotation), 0.4f);
-                ImGui::DragFloat3("Scale", glm::value_ptr(transform.scale), 0.1f);
+                bool changed = ImGui::DragFloat3("Position", glm::value_ptr(transform.position), 0.2f);
+                changed |= ImGui::DragFloat3("Rotation", glm::value_ptr(transform.rotation), 0.4f);
+                changed |= ImGui::DragFloat3("Scale", glm::value_ptr(transform.scale), 0.1f);
+                if (changed) {
+                    ecs.patchComponent<TransformComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -564,14 +569,18 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Camera")) {
                 ImGui::PushID("Camera");
                 // Camera properties
-                ImGui::Checkbox("Primary Camera", &camera.isPrimary);
-                ImGui::DragFloat("FOV", &camera.fov, 0.1f, 1.0f, 180.0f);
-                ImGui::DragFloat("Near Clip", &camera.nearClip, 0.01f, 0.01f, camera.farClip - 0.01f);
-                ImGui::DragFloat("Far Clip", &camera.farClip, 0.1f, camera.nearClip + 0.01f);
-                ImGui::DragFloat3("Target", glm::value_ptr(camera.target), 0.1f);
-                ImGui::DragFloat("Distance", &camera.distance, 0.1f, 0.1f, 100.0f);
-                ImGui::DragFloat("Yaw", &camera.yaw, 0.1f, -180.0f, 180.0f);
-                ImGui::DragFloat("Pitch", &camera.pitch, 0.1f, -89.0f, 89.0f);
+                bool changed = ImGui::Checkbox("Primary Camera", &camera.isPrimary);
+                changed |= ImGui::DragFloat("FOV", &camera.fov, 0.1f, 1.0f, 180.0f);
+                changed |= ImGui::DragFloat("Near Clip", &camera.nearClip, 0.01f, 0.01f, camera.farClip - 0.01f);
+                changed |= ImGui::DragFloat("Far Clip", &camera.farClip, 0.1f, camera.nearClip + 0.01f);
+                changed |= ImGui::DragFloat3("Target", glm::value_ptr(camera.target), 0.1f);
+                changed |= ImGui::DragFloat("Distance", &camera.distance, 0.1f, 0.1f, 100.0f);
+                changed |= ImGui::DragFloat("Yaw", &camera.yaw, 0.1f, -180.0f, 180.0f);
+                changed |= ImGui::DragFloat("Pitch", &camera.pitch, 0.1f, -89.0f, 89.0f);
+                // patching lets the scene journal see the edit
+                if (changed) {
+                    ecs.patchComponent<CameraComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -580,9 +589,12 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Directional Light")) {
                 ImGui::PushID("DirectionalLight");
                 // Directional light properties
-                ImGui::DragFloat3("Direction", glm::value_ptr(directionalLight.direction), 0.1f);
-                ImGui::ColorEdit3("Color", glm::value_ptr(directionalLight.color));
-                ImGui::ColorEdit3("Ambient", glm::value_ptr(directionalLight.ambient));
+                bool changed = ImGui::DragFloat3("Direction", glm::value_ptr(directionalLight.direction), 0.1f);
+                changed |= ImGui::ColorEdit3("Color", glm::value_ptr(directionalLight.color));
+                changed |= ImGui::ColorEdit3("Ambient", glm::value_ptr(directionalLight.ambient));
+                if (changed) {
+                    ecs.patchComponent<DirectionalLightComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -591,11 +603,14 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Point Light")) {
                 ImGui::PushID("PointLight");
                 // Point light properties
-                ImGui::DragFloat3("Position", glm::value_ptr(pointLight.position), 0.1f);
-                ImGui::ColorEdit3("Color", glm::value_ptr(pointLight.color));
-                ImGui::DragFloat("Constant", &pointLight.constant, 0.1f, 0.0f, 100.0f);
-                ImGui::DragFloat("Linear", &pointLight.linear, 0.01f, 0.0f, 10.0f);
-                ImGui::DragFloat("Quadratic", &pointLight.quadratic, 0.01f, 0.0f, 10.0f);
+                bool changed = ImGui::DragFloat3("Position", glm::value_ptr(pointLight.position), 0.1f);
+                changed |= ImGui::ColorEdit3("Color", glm::value_ptr(pointLight.color));
+                changed |= ImGui::DragFloat("Constant", &pointLight.constant, 0.1f, 0.0f, 100.0f);
+                changed |= ImGui::DragFloat("Linear", &pointLight.linear, 0.01f, 0.0f, 10.0f);
+                changed |= ImGui::DragFloat("Quadratic", &pointLight.quadratic, 0.01f, 0.0f, 10.0f);
+                if (changed) {
+                    ecs.patchComponent<PointLightComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -604,11 +619,15 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Spot Light")) {
                 ImGui::PushID("SpotLight");
                 // Spotlight properties
-                ImGui::DragFloat3("Position", glm::value_ptr(spotLight.position), 0.1f);
-                ImGui::DragFloat3("Direction", glm::value_ptr(spotLight.direction), 0.1f);
-                ImGui::ColorEdit3("Color", glm::value_ptr(spotLight.color));
-                ImGui::DragFloat("Cutoff", &spotLight.cutOff, 0.1f, 0.0f, 90.0f);
-                ImGui::DragFloat("Outer Cutoff", &spotLight.outerCutOff, 0.1f, 0.0f, 90.0f);
+                bool changed = ImGui::DragFloat3("Position", glm::value_ptr(spotLight.position), 0.1f);
+                changed |= ImGui::DragFloat3("Direction", glm::value_ptr(spotLight.direction), 0.1f);
+                changed |= ImGui::ColorEdit3("Color", glm::value_ptr(spotLight.color));
+                changed |= ImGui::DragFloat("Cutoff", &spotLight.cutOff, 0.1f, 0.0f, 90.0f);
+                changed |= ImGui::DragFloat("Outer Cutoff", &spotLight.outerCutOff, 0.1f, 0.0f, 90.0f);
+                changed |= ImGui::DragFloat("Range", &spotLight.range, 0.1f, 0.1f, 1000.0f);
+                if (changed) {
+                    ecs.patchComponent<SpotLightComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -618,7 +637,9 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Quad")) {
                 ImGui::PushID("Quad");
                 // Change color
-                ImGui::ColorEdit4("Color", glm::value_ptr(quad.mesh.color));
+                if (ImGui::ColorEdit4("Color", glm::value_ptr(quad.mesh.color))) {
+                    ecs.patchComponent<QuadComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -628,7 +649,9 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
             if (ImGui::CollapsingHeader("Cube")) {
                 ImGui::PushID("Cube");
                 // Change color
-                ImGui::ColorEdit4("Color", glm::value_ptr(cube.mesh.color));
+                if (ImGui::ColorEdit4("Color", glm::value_ptr(cube.mesh.color))) {
+                    ecs.patchComponent<CubeComponent>(_selectedEntity);
+                }
                 ImGui::PopID();
             }
         }
@@ -653,14 +676,15 @@ void Editor::renderComponentsPanel(const SceneManager &sceneManager) const {
                 if (ImGui::InputText("Texture Path", texPathBuffer, bufferSize)) {
                     // If changed, copy back to std::string
                     textureComponent.path = texPathBuffer;
+                    ecs.patchComponent<TextureComponent>(_selectedEntity);
                 }
                 ImGui::SameLine();
                 if (ImGui::Button("Load Texture")) {
-                    textureComponent.texture.loadTexture(textureComponent.path); // Reload on button press
+                    textureComponent.load(textureComponent.path); // (Re)acquire through the texture cache
                 }
                 // Optional: Display texture preview using ImGui::Image if loaded
-                if (textureComponent.texture.getID()) {
-                    ImGui::Image(textureComponent.texture.getID(), ImVec2(64, 64));
+                if (textureComponent.texture) {
+                    ImGui::Image(textureComponent.texture->getID(), ImVec2(64, 64));
                 }
                 ImGui::PopID();
             }
@@ -678,6 +702,7 @@ void Editor::pushConsoleLogs(const std::vector<std::string> &logs) {
 
 void Editor::renderConsolePanel() const {
     ImGui::Begin("Console");
+    std::lock_guard lock(_consoleMutex);
     for (auto &line: _consoleLogs)
         ImGui::TextUnformatted(line.c_str());
     if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -733,6 +758,8 @@ void Editor::renderGameViewportPanel(SceneManager &sceneManager) {
 }
 
 void Editor::pushConsoleLog(const std::string &line) {
+    // scene saves log from worker threads
+    std::lock_guard lock(_consoleMutex);
     _consoleLogs.push_back(line);
 }
 
@@ -811,9 +838,6 @@ void Editor::_handleCameraInput(const float deltaTime, const Input &input) const
 }
 
 void Editor::_setTransformFromMatrix(TransformComponent &transform, const glm::mat4 &mat) {
-    float trans[3], rot[3], scl[3];
-    ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(mat), trans, rot, scl);
-    transform.position = glm::make_vec3(trans);
-    transform.rotation = glm::make_vec3(rot);
-    transform.scale = glm::make_vec3(scl);
+    // decompose with the engine's rotation order rather than ImGuizmo's, so the round trip is exact
+    transform.setFromMatrix(mat);
 }
@@ -11,6 +11,7 @@
 
 #include "../imgui/imgui.h"
 #include <SDL2/SDL.h>
+#include <mutex>
 
 #include "EditorMainMenuBar.h"
 #include "EditorThemes.h"
@@ -125,6 +126,7 @@ private:
     // console & assets
     const std::vector<std::string> *_consoleLogsRef = nullptr;
     std::vector<std::string> _consoleLogs;
+    mutable std::mutex _consoleMutex;
     std::vector<std::string> _assetList;
 
     float _fps = 0.0f;
@@ -8,6 +8,11 @@
 
 #include "ProfilePanel.h"
 #include "Editor.h"
+#include "Application.h"
+#include "../core/locator/Locator.h"
+#include "../core/graphic/RenderState.h"
+#include "../core/project/AssetManager.h"
+#include "../core/project/JsonBackend.h"
 
 ProfilePanel::ProfilePanel(Editor *editor): _editor(editor) {
 }
@@ -16,5 +21,82 @@ void ProfilePanel::render() const {
     ImGui::Begin("Profile");
     ImGui::Text("FPS: %.1f", _editor->getFPS());
     ImGui::Text("Build Version: %s", _editor->getBuildVersion().c_str());
+
+    // applies to the next scene or project load
+    bool simdjson = JsonSettings::getLoadBackend() == JsonBackend::Simdjson;
+    if (ImGui::Checkbox("simdjson Scene Loading", &simdjson)) {
+        JsonSettings::setLoadBackend(simdjson ? JsonBackend::Simdjson : JsonBackend::RapidJson);
+    }
+
+    if (const ProgramBinaryCache *programs = Locator::programBinaries()) {
+        const auto &[hits, misses, rejected, stored] = programs->getStats();
+        ImGui::Text("Program Binaries: %d hits, %d misses, %d rejected, %d stored", hits, misses, rejected, stored);
+    }
+
+    ImGui::Text("Shader Variants: %d", Locator::shaders().getVariantCount());
+
+    const auto assets = AssetManager::getInstance().getStats();
+    ImGui::Text("Assets: %d resident (%.1f / %.1f MB), %d pinned", assets.resident,
+                static_cast<float>(assets.residentBytes) / (1024.0f * 1024.0f),
+                static_cast<float>(assets.budgetBytes) / (1024.0f * 1024.0f), assets.pinned);
+    ImGui::Text("Asset Loads: %d hits, %d loads, %d reloads, %d evictions", assets.hits, assets.loads,
+                assets.reloads, assets.evictions);
+
+    Scene *scene = _editor->getApplication()->getSceneManager().getActiveScene();
+    if (scene && ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+        auto &ecs = scene->getEntityComponentSystem();
+
+        // toggle to compare the instanced path against one draw per entity on the same scene
+        bool instanced = ecs.isInstancedRendering();
+        if (ImGui::Checkbox("Instanced Rendering", &instanced)) {
+            ecs.setInstancedRendering(instanced);
+        }
+
+        bool textureArrays = ecs.isTextureArrays();
+        if (ImGui::Checkbox("Texture Arrays", &textureArrays)) {
+            ecs.setTextureArrays(textureArrays);
+        }
+
+        bool culling = ecs.isFrustumCulling();
+        if (ImGui::Checkbox("Frustum Culling", &culling)) {
+            ecs.setFrustumCulling(culling);
+        }
+
+        const auto &[renderTimeMs, drawCalls, instances] = ecs.getRenderStats();
+        ImGui::Text("Render Time: %.3f ms", renderTimeMs);
+        ImGui::Text("Draw Calls: %d", drawCalls);
+        ImGui::Text("Instances: %d", instances);
+
+        const auto &[visible, culled, cullTimeMs] = ecs.getCullingSystem().getStats();
+        ImGui::Text("Culling: %d visible, %d culled (%.3f ms)", visible, culled, cullTimeMs);
+        ImGui::Text("World Matrices Rebuilt: %d", ecs.getTransformSystem().getUpdatedCount());
+
+        const auto &[lights, clusterReferences, droppedReferences, binningTimeMs] =
+                ecs.getLightingSystem().getClusterStats();
+        ImGui::Text("Lights: %d (%d cluster refs, %d dropped, %.3f ms binning)", lights, clusterReferences,
+                    droppedReferences, binningTimeMs);
+
+        const auto &[issued, elided] = RenderState::getStats();
+        ImGui::Text("GL State Calls: %d issued, %d elided", issued, elided);
+
+        const auto &[pathHits, contentHits, misses, liveTextures, textureBytes] = Locator::textures().getStats();
+        ImGui::Text("Textures: %d live (%.1f MB), %d path hits, %d content hits, %d misses", liveTextures,
+                    static_cast<float>(textureBytes) / (1024.0f * 1024.0f), pathHits, contentHits, misses);
+
+        const auto loader = Locator::textures().getLoaderStats();
+        ImGui::Text("Texture Loads: %d queued, %d awaiting upload, %d failed", loader.queued, loader.awaitingUpload,
+                    loader.failed);
+        ImGui::Text("Texture Uploads: %d last frame (%.1f KB), latency %.1f ms avg / %.1f ms max",
+                    loader.uploadedLastFrame, static_cast<float>(loader.uploadedBytesLastFrame) / 1024.0f,
+                    loader.averageLatencyMs, loader.maxLatencyMs);
+
+        const auto &[buckets, layers, capacity, gpuBytes] = Locator::textureArrays().getStats();
+        ImGui::Text("Texture Arrays: %d buckets, %d/%d layers (%.1f MB)", buckets, layers, capacity,
+                    static_cast<float>(gpuBytes) / (1024.0f * 1024.0f));
+
+        const GeometryRegistry &geometry = Locator::geometry();
+        ImGui::Text("Shared Geometries: %d (%.1f KB)", geometry.getLiveCount(),
+                    static_cast<float>(geometry.getGpuBytes()) / 1024.0f);
+    }
     ImGui::End();
 }
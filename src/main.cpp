@@ -9,11 +9,19 @@
  */
 
 
+#include <string_view>
 #include "Application.h"
 
 int main(int argc, char *args[]) {
     Application gameEngine; // Create a game here
 
+    // compile every shader from source, to measure startup without the program binary cache
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(args[i]) == "--no-program-cache") {
+            gameEngine.setProgramBinaryCacheEnabled(false);
+        }
+    }
+
     if (!gameEngine.initialize()) {
         return -1; // if game initialization failed, return -1
     }
@@ -0,0 +1,326 @@
+/**
+ * @file    AssetDatabase.cpp
+ * @brief   AssetDatabase class implementation file
+ * @details Incremental synchronisation of the asset records with the disk, and their JSON persistence.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "AssetDatabase.h"
+#include <algorithm>
+#include <cstdio>
+#include <ranges>
+#include <unordered_set>
+#include <rapidjson/filewritestream.h>
+#include <rapidjson/writer.h>
+#include <simdjson.h>
+#include "Hash.h"
+#include "Logger.h"
+#include "MappedFile.h"
+
+namespace {
+    constexpr std::size_t WRITE_BUFFER_BYTES = 64 * 1024;
+
+    std::string toKey(const std::filesystem::path &path) {
+        std::string key = path.lexically_normal().generic_string();
+        if (key.size() > 1 && key.back() == '/') {
+            key.pop_back();
+        }
+        return key;
+    }
+
+    std::int64_t toTicks(const std::filesystem::file_time_type time) {
+        return static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    bool isDirectChild(const std::string &path, const std::string &prefix) {
+        return path.starts_with(prefix) && path.find('/', prefix.size()) == std::string::npos;
+    }
+
+    std::uint64_t hashFile(const std::string &path, const std::uint64_t size) {
+        if (size == 0) {
+            return Hash::fnv1a(nullptr, 0);
+        }
+        MappedFile file;
+        // 0 never matches a real hash in practice, so an unreadable file is reported again once it can be read
+        return file.open(path) ? Hash::fnv1a(file.data(), file.size()) : 0;
+    }
+}
+
+bool AssetDatabase::load(const std::string &databasePath, const std::filesystem::path &root) {
+    _root = toKey(root);
+    _records.clear();
+    _directories.clear();
+    _dirty = true;
+
+    simdjson::padded_string json;
+    if (simdjson::padded_string::load(databasePath).get(json) != simdjson::SUCCESS) {
+        return false; // first run
+    }
+
+    try {
+        simdjson::ondemand::parser parser;
+        simdjson::ondemand::document document = parser.iterate(json);
+
+        const std::int64_t version = document["version"];
+        const std::string_view storedRoot = document["root"];
+        if (version != VERSION || storedRoot != _root.generic_string()) {
+            LOG_INFO("Asset database {} is for another root or version, rebuilding it", databasePath);
+            return false;
+        }
+
+        for (auto directory: document["directories"]) {
+            const std::string_view path = directory["path"];
+            const std::int64_t modified = directory["modified"];
+            _directories.emplace(std::string(path), modified);
+        }
+
+        for (auto asset: document["assets"]) {
+            const std::string_view path = asset["path"];
+            AssetRecord record;
+            record.size = asset["size"];
+            record.modified = asset["modified"];
+            record.hash = asset["hash"];
+            _records.emplace(std::string(path), record);
+        }
+    } catch (const simdjson::simdjson_error &error) {
+        LOG_WARN("Asset database {} is corrupt ({}), rebuilding it", databasePath, error.what());
+        _records.clear();
+        _directories.clear();
+        return false;
+    }
+
+    _dirty = false;
+    return true;
+}
+
+bool AssetDatabase::save(const std::string &databasePath) {
+    std::error_code error;
+    if (const auto parent = std::filesystem::path(databasePath).parent_path(); !parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+
+    const std::string tempPath = databasePath + ".tmp";
+    FILE *file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Could not create file for writing: {}", tempPath);
+        return false;
+    }
+
+    std::vector<char> buffer(WRITE_BUFFER_BYTES);
+    rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+    rapidjson::Writer writer(stream);
+
+    writer.StartObject();
+    writer.Key("version");
+    writer.Int(VERSION);
+    writer.Key("root");
+    writer.String(_root.generic_string().c_str());
+
+    // sorted, so the file only changes where the tree did
+    std::vector<std::pair<std::string, std::int64_t> > directories(_directories.begin(), _directories.end());
+    std::ranges::sort(directories);
+    writer.Key("directories");
+    writer.StartArray();
+    for (const auto &[path, modified]: directories) {
+        writer.StartObject();
+        writer.Key("path");
+        writer.String(path.c_str(), static_cast<rapidjson::SizeType>(path.size()));
+        writer.Key("modified");
+        writer.Int64(modified);
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    writer.Key("assets");
+    writer.StartArray();
+    for (const auto &[path, record]: _records) {
+        writer.StartObject();
+        writer.Key("path");
+        writer.String(path.c_str(), static_cast<rapidjson::SizeType>(path.size()));
+        writer.Key("size");
+        writer.Uint64(record.size);
+        writer.Key("modified");
+        writer.Int64(record.modified);
+        writer.Key("hash");
+        writer.Uint64(record.hash);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    stream.Flush();
+
+    const bool written = writer.IsComplete() && std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !written) {
+        LOG_ERROR("Could not write asset database: {}", tempPath);
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, databasePath, error);
+    if (error) {
+        LOG_ERROR("Could not replace asset database '{}': {}", databasePath, error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    _dirty = false;
+    return true;
+}
+
+std::vector<std::string> AssetDatabase::getDirectories() const {
+    std::vector<std::string> directories;
+    directories.reserve(_directories.size());
+    for (const auto &directory: _directories | std::views::keys) {
+        directories.push_back(directory);
+    }
+    return directories;
+}
+
+void AssetDatabase::refresh(std::vector<std::string> &changed) {
+    const std::string root = _root.generic_string();
+    if (_directories.empty()) {
+        update(root, changed);
+        return;
+    }
+
+    // a directory's time changes when entries are added, removed or renamed in it, and only then is it listed;
+    // sorted so parents come first and a removed parent takes its children with it
+    std::vector<std::string> directories = getDirectories();
+    std::ranges::sort(directories);
+
+    for (const auto &directory: directories) {
+        const auto known = _directories.find(directory);
+        if (known == _directories.end()) {
+            continue;
+        }
+        std::error_code error;
+        const auto modified = std::filesystem::last_write_time(directory, error);
+        if (error || !std::filesystem::is_directory(directory, error)) {
+            _remove(directory, changed);
+        } else if (toTicks(modified) != known->second) {
+            _syncDirectory(directory, false, changed);
+        }
+    }
+
+    // edits in place leave the directory alone, so every known file is still stat'ed (but not read)
+    std::vector<std::string> files;
+    files.reserve(_records.size());
+    for (const auto &path: _records | std::views::keys) {
+        files.push_back(path);
+    }
+    for (const auto &path: files) {
+        _updateFile(path, changed);
+    }
+}
+
+void AssetDatabase::update(const std::string &path, std::vector<std::string> &changed) {
+    const std::string key = toKey(path);
+    const std::string root = _root.generic_string();
+    if (key != root && !key.starts_with(root + '/')) {
+        return;
+    }
+
+    std::error_code error;
+    const auto status = std::filesystem::status(key, error);
+    if (std::filesystem::is_directory(status)) {
+        _syncDirectory(key, true, changed);
+    } else if (std::filesystem::is_regular_file(status)) {
+        _updateFile(key, changed);
+    } else {
+        _remove(key, changed);
+    }
+}
+
+void AssetDatabase::_syncDirectory(const std::string &directory, const bool recursive,
+                                   std::vector<std::string> &changed) {
+    // read before listing: a change made meanwhile leaves a newer time and is picked up next time
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(directory, error);
+
+    std::unordered_set<std::string> present;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        std::string key = toKey(it->path());
+        std::error_code typeError;
+        if (it->is_directory(typeError)) {
+            if (recursive || !_directories.contains(key)) {
+                _syncDirectory(key, true, changed);
+            }
+        } else if (it->is_regular_file(typeError)) {
+            if (recursive || !_records.contains(key)) {
+                _updateFile(key, changed);
+            }
+        } else {
+            continue;
+        }
+        present.insert(std::move(key));
+    }
+
+    const std::string prefix = directory + '/';
+    std::vector<std::string> gone;
+    for (auto it = _records.lower_bound(prefix); it != _records.end() && it->first.starts_with(prefix); ++it) {
+        if (isDirectChild(it->first, prefix) && !present.contains(it->first)) {
+            gone.push_back(it->first);
+        }
+    }
+    for (const auto &known: _directories | std::views::keys) {
+        if (isDirectChild(known, prefix) && !present.contains(known)) {
+            gone.push_back(known);
+        }
+    }
+    for (const auto &path: gone) {
+        _remove(path, changed);
+    }
+
+    _directories[directory] = toTicks(modified);
+    _dirty = true;
+}
+
+void AssetDatabase::_updateFile(const std::string &path, std::vector<std::string> &changed) {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    const auto modified = error ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(path, error);
+    if (error) {
+        _remove(path, changed);
+        return;
+    }
+
+    const auto existing = _records.find(path);
+    if (existing != _records.end() && existing->second.size == size && existing->second.modified == toTicks(modified)) {
+        return;
+    }
+
+    AssetRecord record;
+    record.size = size;
+    record.modified = toTicks(modified);
+    record.hash = hashFile(path, size);
+
+    // saving a file unchanged still updates the record, but nothing needs to reload
+    if (existing == _records.end() || existing->second.hash != record.hash) {
+        changed.push_back(path);
+    }
+    _records[path] = record;
+    _dirty = true;
+}
+
+void AssetDatabase::_remove(const std::string &path, std::vector<std::string> &changed) {
+    if (const auto it = _records.find(path); it != _records.end()) {
+        changed.push_back(path);
+        _records.erase(it);
+        _dirty = true;
+    }
+
+    const std::string prefix = path + '/';
+    auto it = _records.lower_bound(prefix);
+    while (it != _records.end() && it->first.starts_with(prefix)) {
+        changed.push_back(it->first);
+        it = _records.erase(it);
+        _dirty = true;
+    }
+
+    if (_directories.erase(path) > 0) {
+        _dirty = true;
+    }
+    std::erase_if(_directories, [&prefix](const auto &directory) {
+        return directory.first.starts_with(prefix);
+    });
+}
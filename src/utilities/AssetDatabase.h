@@ -0,0 +1,73 @@
+/**
+ * @file    AssetDatabase.h
+ * @brief   AssetDatabase class header file
+ * @details Persistent record of every file under a directory tree: size, modification time and a content hash.
+ *          It is saved between runs, so startup only stats what it already knows and lists the directories whose
+ *          modification time changed, instead of walking the whole tree; a file is hashed again only when its
+ *          size or time differs. Afterwards it is kept current one path at a time from file system events.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef ASSETDATABASE_H
+#define ASSETDATABASE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AssetRecord {
+    std::uint64_t size = 0;
+    std::int64_t modified = 0; // file clock ticks, only ever compared for equality
+    std::uint64_t hash = 0; // FNV-1a of the contents
+};
+
+class AssetDatabase {
+public:
+    static constexpr int VERSION = 1;
+
+    // Records of another root or version are dropped, the next refresh() then walks the tree once
+    bool load(const std::string &databasePath, const std::filesystem::path &root);
+
+    // Clears the dirty flag once written
+    bool save(const std::string &databasePath);
+
+    /**
+     * Brings the records in line with the disk. Appends the paths of files that were added, changed or removed
+     * to `changed`; files touched without a change of contents are not reported.
+     */
+    void refresh(std::vector<std::string> &changed);
+
+    // Same, for one file or directory; a path that no longer exists is removed with everything below it
+    void update(const std::string &path, std::vector<std::string> &changed);
+
+    // Keyed by generic path including the root, e.g. "resources/shaders/color.vert"; sorted for listing
+    [[nodiscard]] const std::map<std::string, AssetRecord> &getRecords() const { return _records; }
+
+    [[nodiscard]] const std::filesystem::path &getRoot() const { return _root; }
+
+    // Every known directory including the root, e.g. to watch them without walking the tree
+    [[nodiscard]] std::vector<std::string> getDirectories() const;
+
+    [[nodiscard]] bool isDirty() const { return _dirty; }
+
+private:
+    std::filesystem::path _root;
+    std::map<std::string, AssetRecord> _records;
+    std::unordered_map<std::string, std::int64_t> _directories; // directory -> modification time
+    bool _dirty = false;
+
+    // Lists `directory` and drops what is gone from it. Recursive syncs check every entry below; otherwise only
+    // entries that are new are looked at, the caller checks the known ones.
+    void _syncDirectory(const std::string &directory, bool recursive, std::vector<std::string> &changed);
+
+    void _updateFile(const std::string &path, std::vector<std::string> &changed);
+
+    void _remove(const std::string &path, std::vector<std::string> &changed);
+};
+
+
+#endif //ASSETDATABASE_H
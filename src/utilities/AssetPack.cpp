@@ -0,0 +1,303 @@
+/**
+ * @file    AssetPack.cpp
+ * @brief   AssetPack class implementation file
+ * @details Mounting, lookups and building of `.cbpak` archives.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "AssetPack.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "Hash.h"
+#include "Logger.h"
+#include "Lz4.h"
+
+namespace {
+    std::uint64_t alignUp(const std::uint64_t value, const std::uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool readWholeFile(const std::filesystem::path &path, std::vector<unsigned char> &bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        bytes.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        return file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())).good()
+               || bytes.empty();
+    }
+
+    bool writePadding(std::FILE *file, const std::uint64_t from, const std::uint64_t to) {
+        static constexpr unsigned char zeros[AssetPack::DATA_ALIGNMENT] = {};
+        return to == from || std::fwrite(zeros, 1, to - from, file) == to - from;
+    }
+}
+
+bool AssetPack::mount(const std::string &path) {
+    unmount();
+
+    if (!_file.open(path)) {
+        LOG_ERROR("Failed to open asset pack {}", path);
+        return false;
+    }
+
+    const unsigned char *base = _file.data();
+    if (_file.size() < sizeof(AssetPackHeader)) {
+        LOG_ERROR("Asset pack {} is truncated", path);
+        _file.close();
+        return false;
+    }
+    _header = reinterpret_cast<const AssetPackHeader *>(base);
+
+    if (!_validate()) {
+        LOG_ERROR("Asset pack {} is corrupt or has an unsupported version", path);
+        unmount();
+        return false;
+    }
+
+    _entries = reinterpret_cast<const AssetPackEntry *>(base + _header->entriesOffset);
+    _buckets = reinterpret_cast<const std::uint32_t *>(base + _header->bucketsOffset);
+    _strings = reinterpret_cast<const char *>(base + _header->stringsOffset);
+
+    LOG_INFO("Mounted asset pack {} ({} entries)", path, _header->entryCount);
+    return true;
+}
+
+void AssetPack::unmount() {
+    _header = nullptr;
+    _entries = nullptr;
+    _buckets = nullptr;
+    _strings = nullptr;
+    _file.close();
+}
+
+bool AssetPack::_validate() const {
+    const std::uint64_t fileSize = _file.size();
+    const AssetPackHeader &header = *_header;
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return false;
+    }
+
+    // more buckets than entries, so the table below can have an empty one
+    if (!std::has_single_bit(header.bucketCount) || header.bucketCount <= header.entryCount) {
+        return false;
+    }
+
+    const auto fits = [fileSize](const std::uint64_t offset, const std::uint64_t size) {
+        return offset <= fileSize && size <= fileSize - offset;
+    };
+    if (header.entriesOffset % alignof(AssetPackEntry) != 0 || header.bucketsOffset % alignof(std::uint32_t) != 0
+        || !fits(header.entriesOffset, std::uint64_t{header.entryCount} * sizeof(AssetPackEntry))
+        || !fits(header.bucketsOffset, std::uint64_t{header.bucketCount} * sizeof(std::uint32_t))
+        || !fits(header.stringsOffset, header.stringsSize)) {
+        return false;
+    }
+
+    // checked once here so find() and read() can trust every offset afterwards
+    const unsigned char *base = _file.data();
+    const auto *entries = reinterpret_cast<const AssetPackEntry *>(base + header.entriesOffset);
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        const AssetPackEntry &entry = entries[i];
+        if (!fits(entry.dataOffset, entry.storedSize)
+            || std::uint64_t{entry.pathOffset} + entry.pathLength > header.stringsSize) {
+            return false;
+        }
+        if (entry.compression == AssetCompression::None ? entry.storedSize != entry.size
+                                                         : entry.compression != AssetCompression::Lz4) {
+            return false;
+        }
+    }
+
+    // an empty bucket must actually exist, or a lookup for a missing path would never stop probing. Each entry
+    // may sit in one bucket at most, which leaves at least bucketCount - entryCount of them empty.
+    const auto *buckets = reinterpret_cast<const std::uint32_t *>(base + header.bucketsOffset);
+    std::vector<bool> placed(header.entryCount, false);
+    std::uint32_t used = 0;
+    for (std::uint32_t i = 0; i < header.bucketCount; ++i) {
+        const std::uint32_t bucket = buckets[i];
+        if (bucket == 0) {
+            continue;
+        }
+        if (bucket > header.entryCount || placed[bucket - 1]) {
+            return false;
+        }
+        placed[bucket - 1] = true;
+        ++used;
+    }
+    return used <= header.entryCount;
+}
+
+const AssetPackEntry *AssetPack::find(const std::string_view path) const {
+    if (!_header) {
+        return nullptr;
+    }
+
+    const std::uint64_t hash = Hash::fnv1a(path);
+    const std::uint32_t mask = _header->bucketCount - 1;
+    for (std::uint32_t bucket = static_cast<std::uint32_t>(hash) & mask; _buckets[bucket] != 0;
+         bucket = (bucket + 1) & mask) {
+        const AssetPackEntry &entry = _entries[_buckets[bucket] - 1];
+        if (entry.pathHash == hash && getPath(entry) == path) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::span<const unsigned char> AssetPack::view(const AssetPackEntry &entry) const {
+    if (entry.compression != AssetCompression::None) {
+        return {};
+    }
+    return {_file.data() + entry.dataOffset, static_cast<std::size_t>(entry.size)};
+}
+
+bool AssetPack::read(const AssetPackEntry &entry, std::vector<unsigned char> &bytes) const {
+    const unsigned char *stored = _file.data() + entry.dataOffset;
+    bytes.resize(static_cast<std::size_t>(entry.size));
+
+    if (entry.compression == AssetCompression::None) {
+        std::memcpy(bytes.data(), stored, bytes.size());
+        return true;
+    }
+
+    if (!Lz4::decompress(stored, static_cast<std::size_t>(entry.storedSize), bytes.data(), bytes.size())) {
+        LOG_ERROR("Corrupt entry {} in asset pack", getPath(entry));
+        bytes.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string_view AssetPack::getPath(const AssetPackEntry &entry) const {
+    return {_strings + entry.pathOffset, entry.pathLength};
+}
+
+std::span<const AssetPackEntry> AssetPack::getEntries() const {
+    if (!_header) {
+        return {};
+    }
+    return {_entries, _header->entryCount};
+}
+
+bool AssetPack::build(const std::filesystem::path &directory, const std::string &outputPath, const bool compress) {
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end;
+         it.increment(error)) {
+        if (it->is_regular_file()) {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        LOG_ERROR("Failed to list {}: {}", directory.string(), error.message());
+        return false;
+    }
+
+    // sorted so that the same tree always produces the same pack
+    std::vector<std::pair<std::string, std::filesystem::path> > sorted;
+    sorted.reserve(files.size());
+    for (const auto &file: files) {
+        sorted.emplace_back(file.lexically_relative(directory).generic_string(), file);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::string tempPath = outputPath + ".tmp";
+    std::FILE *output = std::fopen(tempPath.c_str(), "wb");
+    if (!output) {
+        LOG_ERROR("Failed to open {} for writing", tempPath);
+        return false;
+    }
+
+    AssetPackHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entryCount = static_cast<std::uint32_t>(sorted.size());
+
+    std::vector<AssetPackEntry> entries;
+    entries.reserve(sorted.size());
+    std::string strings;
+    std::vector<unsigned char> bytes;
+    std::uint64_t offset = alignUp(sizeof(AssetPackHeader), DATA_ALIGNMENT);
+    bool ok = std::fwrite(&header, sizeof(header), 1, output) == 1
+              && writePadding(output, sizeof(AssetPackHeader), offset);
+
+    for (const auto &[relative, file]: sorted) {
+        if (!ok) {
+            break;
+        }
+        if (!readWholeFile(file, bytes)) {
+            LOG_ERROR("Failed to read {}", file.string());
+            ok = false;
+            break;
+        }
+
+        AssetPackEntry entry{};
+        entry.pathHash = Hash::fnv1a(relative);
+        entry.dataOffset = offset;
+        entry.size = bytes.size();
+        entry.pathOffset = static_cast<std::uint32_t>(strings.size());
+        entry.pathLength = static_cast<std::uint32_t>(relative.size());
+        strings += relative;
+
+        const std::vector<unsigned char> compressed = compress
+                                                          ? Lz4::compress(bytes.data(), bytes.size())
+                                                          : std::vector<unsigned char>{};
+        // a small saving is not worth the decompression, and stored entries can be used in place
+        const bool useCompressed = compress && compressed.size() <= bytes.size() - bytes.size() / 8
+                                   && !bytes.empty();
+        const std::vector<unsigned char> &stored = useCompressed ? compressed : bytes;
+        entry.compression = useCompressed ? AssetCompression::Lz4 : AssetCompression::None;
+        entry.storedSize = stored.size();
+
+        const std::uint64_t end = offset + stored.size();
+        const std::uint64_t next = alignUp(end, DATA_ALIGNMENT);
+        ok = (stored.empty() || std::fwrite(stored.data(), 1, stored.size(), output) == stored.size())
+             && writePadding(output, end, next);
+        offset = next;
+        entries.push_back(entry);
+    }
+
+    header.bucketCount = std::bit_ceil(std::max<std::uint32_t>(2 * header.entryCount, 1u) + 1);
+    std::vector<std::uint32_t> buckets(header.bucketCount, 0);
+    const std::uint32_t mask = header.bucketCount - 1;
+    for (std::uint32_t i = 0; i < entries.size(); ++i) {
+        std::uint32_t bucket = static_cast<std::uint32_t>(entries[i].pathHash) & mask;
+        while (buckets[bucket] != 0) {
+            bucket = (bucket + 1) & mask;
+        }
+        buckets[bucket] = i + 1;
+    }
+
+    header.entriesOffset = offset;
+    header.bucketsOffset = header.entriesOffset + entries.size() * sizeof(AssetPackEntry);
+    header.stringsOffset = header.bucketsOffset + buckets.size() * sizeof(std::uint32_t);
+    header.stringsSize = strings.size();
+
+    ok = ok && (entries.empty() || std::fwrite(entries.data(), sizeof(AssetPackEntry), entries.size(), output)
+                == entries.size())
+         && std::fwrite(buckets.data(), sizeof(std::uint32_t), buckets.size(), output) == buckets.size()
+         && (strings.empty() || std::fwrite(strings.data(), 1, strings.size(), output) == strings.size())
+         // the header goes last, so a pack cut short by a crash never passes validation
+         && std::fseek(output, 0, SEEK_SET) == 0
+         && std::fwrite(&header, sizeof(header), 1, output) == 1;
+    ok = std::fclose(output) == 0 && ok;
+
+    if (ok) {
+        std::filesystem::rename(tempPath, outputPath, error);
+        ok = !error;
+    }
+    if (!ok) {
+        LOG_ERROR("Failed to write asset pack {}", outputPath);
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    LOG_INFO("Packed {} files from {} into {}", entries.size(), directory.string(), outputPath);
+    return true;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file    AssetPack.h
+ * @brief   AssetPack class header file
+ * @details A `.cbpak` archive holds every file of a directory tree in one memory-mapped file. Entries start on
+ *          DATA_ALIGNMENT boundaries and may be LZ4 compressed when that saves enough. They are found through an
+ *          open-addressing hash table of FNV-1a path hashes stored in the file. Mounting a pack validates its
+ *          whole table of contents (entries and buckets) but no entry data, and a lookup never touches the file
+ *          system.
+ *
+ *          Layout: header | entry data... | entries[entryCount] | buckets[bucketCount] | path strings
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+enum class AssetCompression : std::uint32_t { None = 0, Lz4 = 1 };
+
+struct AssetPackHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t bucketCount; // power of two, at least twice the entry count
+    std::uint64_t entriesOffset;
+    std::uint64_t bucketsOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+
+static_assert(sizeof(AssetPackHeader) == 48, "AssetPackHeader layout is part of the file format");
+
+struct AssetPackEntry {
+    std::uint64_t pathHash;
+    std::uint64_t dataOffset;
+    std::uint64_t storedSize; // bytes in the pack
+    std::uint64_t size; // bytes once decompressed
+    std::uint32_t pathOffset; // into the string section, paths use '/' and are relative to the packed directory
+    std::uint32_t pathLength;
+    AssetCompression compression;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry layout is part of the file format");
+
+class AssetPack {
+public:
+    static constexpr char MAGIC[4] = {'C', 'B', 'P', 'K'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint64_t DATA_ALIGNMENT = 64;
+
+    bool mount(const std::string &path);
+
+    void unmount();
+
+    [[nodiscard]] bool isMounted() const { return _header != nullptr; }
+
+    // O(1); nullptr when the pack has no such file
+    [[nodiscard]] const AssetPackEntry *find(std::string_view path) const;
+
+    // The stored bytes in place, without a copy; empty for compressed entries, use read() for those
+    [[nodiscard]] std::span<const unsigned char> view(const AssetPackEntry &entry) const;
+
+    // Decompresses if needed. Safe to call from several threads at once.
+    bool read(const AssetPackEntry &entry, std::vector<unsigned char> &bytes) const;
+
+    [[nodiscard]] std::string_view getPath(const AssetPackEntry &entry) const;
+
+    [[nodiscard]] std::span<const AssetPackEntry> getEntries() const;
+
+    /**
+     * Packs every regular file under `directory`. With `compress`, entries are LZ4 compressed when that saves at
+     * least an eighth of their size; images and audio are usually compressed already and stay stored.
+     */
+    static bool build(const std::filesystem::path &directory, const std::string &outputPath, bool compress = true);
+
+private:
+    MappedFile _file;
+    const AssetPackHeader *_header = nullptr;
+    const AssetPackEntry *_entries = nullptr;
+    const std::uint32_t *_buckets = nullptr; // entry index + 1, 0 for an empty bucket
+    const char *_strings = nullptr;
+
+    bool _validate() const;
+};
+
+
+#endif //ASSETPACK_H
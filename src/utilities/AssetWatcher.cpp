@@ -0,0 +1,169 @@
+/**
+ * @file    AssetWatcher.cpp
+ * @brief   AssetWatcher class implementation file
+ * @details inotify based implementation on Linux, a stub that never starts elsewhere.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "AssetWatcher.h"
+#include <algorithm>
+#include <cstdint>
+#include "Logger.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+AssetWatcher::~AssetWatcher() {
+    stop();
+}
+
+#ifdef __linux__
+
+namespace {
+    // directory events matter for new subtrees; a file only counts once it has been written and closed
+    constexpr std::uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+}
+
+bool AssetWatcher::start(const std::filesystem::path &root) {
+    stop();
+
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd < 0) {
+        LOG_WARN("Asset hot reload is off, inotify_init1 failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    _root = root.lexically_normal().generic_string();
+    return _watch(_root);
+}
+
+void AssetWatcher::watch(const std::vector<std::string> &directories) {
+    if (_fd < 0) {
+        return;
+    }
+    const std::size_t before = _watches.size();
+    for (const auto &directory: directories) {
+        if (!_watched.contains(directory)) {
+            _watch(directory);
+        }
+    }
+    if (_watches.size() != before) {
+        LOG_INFO("Watching {} directories under {} for asset changes", _watches.size(), _root);
+    }
+}
+
+void AssetWatcher::stop() {
+    if (_fd >= 0) {
+        // closing the descriptor removes all of its watches
+        close(_fd);
+        _fd = -1;
+    }
+    _watches.clear();
+    _watched.clear();
+}
+
+std::vector<std::string> AssetWatcher::poll() {
+    std::vector<std::string> paths;
+    if (_fd < 0) {
+        return paths;
+    }
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    ssize_t length;
+    while ((length = read(_fd, buffer, sizeof(buffer))) > 0) {
+        for (const char *cursor = buffer; cursor < buffer + length;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // events were lost, only a sync of the whole tree can tell what changed
+                LOG_WARN("Asset watcher queue overflowed, rescanning {}", _root);
+                paths.push_back(_root);
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                if (const auto watch = _watches.find(event->wd); watch != _watches.end()) {
+                    _watched.erase(watch->second);
+                    _watches.erase(watch);
+                }
+                continue;
+            }
+
+            const auto watch = _watches.find(event->wd);
+            if (watch == _watches.end() || event->len == 0) {
+                continue;
+            }
+            std::string path = watch->second + '/' + event->name;
+
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    _watchTree(path);
+                }
+            } else if (event->mask & IN_CREATE) {
+                continue; // still empty, IN_CLOSE_WRITE follows
+            }
+            paths.push_back(std::move(path));
+        }
+    }
+
+    std::ranges::sort(paths);
+    const auto duplicates = std::ranges::unique(paths);
+    paths.erase(duplicates.begin(), duplicates.end());
+    return paths;
+}
+
+bool AssetWatcher::_watch(const std::string &directory) {
+    const int wd = inotify_add_watch(_fd, directory.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        LOG_WARN("Could not watch {}: {}", directory, std::strerror(errno));
+        return false;
+    }
+    _watches[wd] = directory;
+    _watched.insert(directory);
+    return true;
+}
+
+void AssetWatcher::_watchTree(const std::string &directory) {
+    if (!_watch(directory)) {
+        return;
+    }
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (std::error_code typeError; it->is_directory(typeError) && !it->is_symlink(typeError)) {
+            _watchTree(it->path().generic_string());
+        }
+    }
+}
+
+#else
+
+bool AssetWatcher::start(const std::filesystem::path &root) {
+    LOG_INFO("Asset hot reload is only available on Linux, changes under {} are picked up at startup",
+             root.generic_string());
+    return false;
+}
+
+void AssetWatcher::stop() {
+}
+
+void AssetWatcher::watch(const std::vector<std::string> &) {
+}
+
+std::vector<std::string> AssetWatcher::poll() {
+    return {};
+}
+
+bool AssetWatcher::_watch(const std::string &) {
+    return false;
+}
+
+void AssetWatcher::_watchTree(const std::string &) {
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file    AssetWatcher.h
+ * @brief   AssetWatcher class header file
+ * @details Watches a directory tree for file changes through inotify, polled without blocking once per frame.
+ *          inotify watches are per directory: the known ones are handed in through watch(), and directories
+ *          created later are walked and added as they appear. Only Linux has an implementation; elsewhere start() fails and changes are
+ *          picked up at the next startup.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef ASSETWATCHER_H
+#define ASSETWATCHER_H
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class AssetWatcher {
+public:
+    AssetWatcher() = default;
+
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher &) = delete;
+
+    AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+    // Watches `root` itself; the directories below it are added with watch()
+    bool start(const std::filesystem::path &root);
+
+    // Add a watch for each directory not watched yet, without listing them
+    void watch(const std::vector<std::string> &directories);
+
+    void stop();
+
+    [[nodiscard]] bool isWatching() const { return _fd >= 0; }
+
+    /**
+     * Paths written, created, moved or removed since the last call, each once. A directory path stands for
+     * everything below it: one that was created or moved in, or the root after the event queue overflowed.
+     */
+    std::vector<std::string> poll();
+
+private:
+    int _fd = -1;
+    std::string _root;
+    std::unordered_map<int, std::string> _watches; // watch descriptor -> directory
+    std::unordered_set<std::string> _watched;
+
+    bool _watch(const std::string &directory);
+
+    // Watches a directory that just appeared, and everything below it
+    void _watchTree(const std::string &directory);
+};
+
+
+#endif //ASSETWATCHER_H
@@ -7,6 +7,21 @@
  */
 
 #include "AssetsManager.h"
+#include <fstream>
+#include <ranges>
+#include "Logger.h"
+
+namespace {
+    // the key a path has inside the pack, or nothing when it lies outside the mount point
+    std::optional<std::string> toPackKey(const std::string &path) {
+        const std::string normal = std::filesystem::path(path).lexically_normal().generic_string();
+        const std::string_view prefix = AssetsManager::PACK_MOUNT_POINT;
+        if (normal.size() <= prefix.size() || !normal.starts_with(prefix) || normal[prefix.size()] != '/') {
+            return std::nullopt;
+        }
+        return normal.substr(prefix.size() + 1);
+    }
+}
 
 AssetsManager &AssetsManager::Get() {
     static AssetsManager inst;
@@ -15,35 +30,117 @@ AssetsManager &AssetsManager::Get() {
 
 void AssetsManager::initialize(const std::filesystem::path &basePath) {
     _basePath = basePath;
+
+    if (std::filesystem::exists(PACK_PATH) && _pack.mount(PACK_PATH)) {
+        _indexPack();
+        return;
+    }
+
     // create base + subdirectories if missing
     for (auto sub: {"scenes", "shaders", "textures", "audio", "fonts", "models"}) {
         std::filesystem::create_directories(_basePath / sub);
     }
-    _scanAssets();
+
+    // the known directories are watched before the sync, so nothing changed in them between the sync and the
+    // first poll goes unnoticed; the database lists them, so the tree is not walked for this. Directories the
+    // sync finds are added after it.
+    _watcher.start(PACK_MOUNT_POINT);
+    const bool loaded = _database.load(DATABASE_PATH, PACK_MOUNT_POINT);
+    _watcher.watch(_database.getDirectories());
+
+    std::vector<std::string> changed;
+    _database.refresh(changed);
+    _watcher.watch(_database.getDirectories());
+    LOG_INFO("Asset database {}: {} files, {} changed since the last run", loaded ? "loaded" : "rebuilt",
+             _database.getRecords().size(), changed.size());
+    if (_database.isDirty()) {
+        _database.save(DATABASE_PATH);
+    }
+    _indexDatabase();
+}
+
+void AssetsManager::shutdown() {
+    _watcher.stop();
+    if (_database.isDirty()) {
+        _database.save(DATABASE_PATH);
+    }
 }
 
-void AssetsManager::_scanAssets() {
+std::vector<std::string> AssetsManager::pollChanges() {
+    std::vector<std::string> changed;
+    if (!_watcher.isWatching()) {
+        return changed;
+    }
+
+    const bool wasDirty = _database.isDirty();
+    for (const auto &path: _watcher.poll()) {
+        _database.update(path, changed);
+    }
+    if (!changed.empty()) {
+        _indexDatabase();
+    }
+
+    // a burst of writes (an image editor saving, a git checkout) is saved once instead of on every frame
+    const auto now = std::chrono::steady_clock::now();
+    if (!_database.isDirty()) {
+        return changed;
+    }
+    if (!wasDirty) {
+        _databaseSaveDue = now + DATABASE_SAVE_DELAY;
+    } else if (now >= _databaseSaveDue && !_database.save(DATABASE_PATH)) {
+        _databaseSaveDue = now + DATABASE_SAVE_DELAY; // try again later rather than every frame
+    }
+    return changed;
+}
+
+void AssetsManager::_indexDatabase() {
     _allAssets.clear();
     _byType.clear();
 
-    for (auto &ent: std::filesystem::recursive_directory_iterator(_basePath)) {
-        if (!ent.is_regular_file()) continue;
-        auto rel = std::filesystem::relative(ent.path(), _basePath).string();
-        _allAssets.push_back(rel);
+    const std::string prefix = std::filesystem::path(_basePath).lexically_normal().generic_string() + '/';
+    for (const auto &path: _database.getRecords() | std::views::keys) {
+        if (!path.starts_with(prefix)) {
+            continue;
+        }
+        const std::filesystem::path relative(path.substr(prefix.size()));
+        _addAsset(relative.string(), relative.parent_path().filename().string());
+    }
+}
+
+void AssetsManager::_indexPack() {
+    _allAssets.clear();
+    _byType.clear();
 
-        auto parent = ent.path().parent_path().filename().string();
-        AssetType t = AssetType::Other;
-        if (parent == "scenes") t = AssetType::Scene;
-        else if (parent == "shaders") t = AssetType::Shader;
-        else if (parent == "textures") t = AssetType::Texture;
-        else if (parent == "audio") t = AssetType::Audio;
-        else if (parent == "fonts") t = AssetType::Font;
-        else if (parent == "models") t = AssetType::Model;
+    const auto base = toPackKey(_basePath.generic_string());
+    if (!base) {
+        return;
+    }
+    const std::string prefix = *base + '/';
 
-        _byType[t].push_back(rel);
+    for (const AssetPackEntry &entry: _pack.getEntries()) {
+        const std::string_view path = _pack.getPath(entry);
+        if (!path.starts_with(prefix)) {
+            continue;
+        }
+        const std::filesystem::path relative(path.substr(prefix.size()));
+        _addAsset(relative.string(), relative.parent_path().filename().string());
     }
 }
 
+void AssetsManager::_addAsset(const std::string &relative, const std::string &parent) {
+    _allAssets.push_back(relative);
+
+    AssetType t = AssetType::Other;
+    if (parent == "scenes") t = AssetType::Scene;
+    else if (parent == "shaders") t = AssetType::Shader;
+    else if (parent == "textures") t = AssetType::Texture;
+    else if (parent == "audio") t = AssetType::Audio;
+    else if (parent == "fonts") t = AssetType::Font;
+    else if (parent == "models") t = AssetType::Model;
+
+    _byType[t].push_back(relative);
+}
+
 const std::vector<std::string> &AssetsManager::getAssets() const {
     return _allAssets;
 }
@@ -53,3 +150,35 @@ const std::vector<std::string> &AssetsManager::getAssets(AssetType t) const {
     auto it = _byType.find(t);
     return it == _byType.end() ? empty : it->second;
 }
+
+const AssetPackEntry *AssetsManager::_findPacked(const std::string &path) const {
+    if (!_pack.isMounted()) {
+        return nullptr;
+    }
+    const auto key = toPackKey(path);
+    return key ? _pack.find(*key) : nullptr;
+}
+
+bool AssetsManager::readFile(const std::string &path, std::vector<unsigned char> &bytes) const {
+    if (const AssetPackEntry *entry = _findPacked(path)) {
+        return _pack.read(*entry, bytes);
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    bytes.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    return file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())).good()
+           || bytes.empty();
+}
+
+std::span<const unsigned char> AssetsManager::view(const std::string &path) const {
+    const AssetPackEntry *entry = _findPacked(path);
+    return entry ? _pack.view(*entry) : std::span<const unsigned char>{};
+}
+
+bool AssetsManager::exists(const std::string &path) const {
+    return _findPacked(path) != nullptr || std::filesystem::is_regular_file(path);
+}
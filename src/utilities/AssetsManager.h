@@ -2,6 +2,11 @@
 *  @file    AssetsManager.h
  * @brief   Header file for the AssetsManager class.
  * @details This file contains the definition of the AssetsManager class which is responsible for managing
+ *          the assets. When a `resources.cbpak` archive sits next to the executable it is mounted in place of the
+ *          `resources` directory: files are then served from the pack and the asset list comes from its table of
+ *          contents, so shipped builds start without walking any directory. Otherwise the `resources` tree is
+ *          tracked by an asset database that is saved between runs and kept current from file system events,
+ *          which is what shader and texture hot reload listen to.
  * @author  Nur Akmal bin Jalil
  * @date    2025-05-06
  */
@@ -9,34 +14,73 @@
 #ifndef ASSETSMANAGER_H
 #define ASSETSMANAGER_H
 
+#include <chrono>
 #include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
 #include <unordered_map>
 #include <vector>
+#include "AssetDatabase.h"
+#include "AssetPack.h"
+#include "AssetWatcher.h"
 
 class AssetsManager {
 public:
     enum class AssetType { Scene, Shader, Texture, Audio, Font, Model, Other };
 
+    static constexpr auto PACK_PATH = "resources.cbpak";
+    static constexpr auto PACK_MOUNT_POINT = "resources"; // packed paths are relative to this directory
+    static constexpr auto DATABASE_PATH = "config/asset_database.json";
+    static constexpr std::chrono::seconds DATABASE_SAVE_DELAY{2};
+
     // singleton access
     static AssetsManager &Get();
 
-    // ensure all sub‐dirs exist and scan contents
+    // mount the pack if there is one, otherwise ensure all sub‐dirs exist and bring the database up to date
     void initialize(const std::filesystem::path &basePath);
 
+    // Main thread, once per frame: paths under `resources` whose contents changed since the last call. The
+    // database is written DATABASE_SAVE_DELAY after the first unsaved change, so a burst of changes is one write.
+    std::vector<std::string> pollChanges();
+
+    // Stop watching and write the database if it has unsaved changes
+    void shutdown();
+
     // get all asset paths *relative* to basePath
     const std::vector<std::string> &getAssets() const;
 
     // get by category
     const std::vector<std::string> &getAssets(AssetType type) const;
 
+    [[nodiscard]] bool isPacked() const { return _pack.isMounted(); }
+
+    // Reads from the pack when it has the file and from disk otherwise. Safe to call from worker threads.
+    bool readFile(const std::string &path, std::vector<unsigned char> &bytes) const;
+
+    // The file's bytes inside the mapped pack, without a copy; empty when it isn't packed or is compressed
+    [[nodiscard]] std::span<const unsigned char> view(const std::string &path) const;
+
+    [[nodiscard]] bool exists(const std::string &path) const;
+
 private:
     AssetsManager() = default;
 
-    void _scanAssets();
+    void _indexDatabase();
+
+    void _indexPack();
+
+    void _addAsset(const std::string &relative, const std::string &parent);
+
+    [[nodiscard]] const AssetPackEntry *_findPacked(const std::string &path) const;
 
     std::filesystem::path _basePath;
     std::vector<std::string> _allAssets;
     std::unordered_map<AssetType, std::vector<std::string> > _byType;
+    AssetPack _pack;
+    AssetDatabase _database;
+    std::chrono::steady_clock::time_point _databaseSaveDue;
+    AssetWatcher _watcher;
 };
 
 
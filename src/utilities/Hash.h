@@ -0,0 +1,35 @@
+/**
+ * @file    Hash.h
+ * @brief   Hash helpers
+ * @details Non-cryptographic 64-bit FNV-1a hashing, used to key caches by content.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Hash {
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    // Pass a previous result as `seed` to hash several pieces as one stream
+    inline std::uint64_t fnv1a(const void *data, const std::size_t size, std::uint64_t seed = FNV_OFFSET_BASIS) {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            seed ^= bytes[i];
+            seed *= FNV_PRIME;
+        }
+        return seed;
+    }
+
+    inline std::uint64_t fnv1a(const std::string_view text, const std::uint64_t seed = FNV_OFFSET_BASIS) {
+        return fnv1a(text.data(), text.size(), seed);
+    }
+}
+
+#endif //HASH_H
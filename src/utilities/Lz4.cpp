@@ -0,0 +1,177 @@
+/**
+ * @file    Lz4.cpp
+ * @brief   LZ4 block compression implementation
+ * @details Follows the LZ4 block format: sequences of a token, literals, a 16-bit match offset and a match
+ *          length, with the last five bytes always stored as literals.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "Lz4.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr std::size_t MIN_MATCH = 4;
+    constexpr std::size_t LAST_LITERALS = 5; // the format ends every block with at least this many literals
+    constexpr std::size_t MATCH_FIND_LIMIT = 12; // and no match may start closer than this to the end
+    constexpr std::size_t MAX_OFFSET = 65535;
+    constexpr int HASH_BITS = 16;
+    constexpr std::uint32_t NO_POSITION = 0xFFFFFFFFu;
+
+    std::uint32_t read32(const unsigned char *bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    std::uint32_t hashSequence(const std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // lengths of 15 and more spill over into extra bytes of 255 each, ended by a smaller one
+    void writeLength(std::vector<unsigned char> &output, std::size_t length) {
+        while (length >= 255) {
+            output.push_back(255);
+            length -= 255;
+        }
+        output.push_back(static_cast<unsigned char>(length));
+    }
+
+    bool readLength(const unsigned char *input, const std::size_t inputSize, std::size_t &position,
+                    std::size_t &length) {
+        unsigned char next;
+        do {
+            if (position >= inputSize) {
+                return false;
+            }
+            next = input[position++];
+            length += next;
+        } while (next == 255);
+        return true;
+    }
+
+    void writeSequence(std::vector<unsigned char> &output, const unsigned char *literals, const std::size_t literalCount,
+                       const std::size_t offset, const std::size_t matchLength) {
+        const std::size_t matchCode = matchLength - MIN_MATCH;
+        output.push_back(static_cast<unsigned char>((std::min<std::size_t>(literalCount, 15) << 4) |
+                                                    std::min<std::size_t>(matchCode, 15)));
+        if (literalCount >= 15) {
+            writeLength(output, literalCount - 15);
+        }
+        output.insert(output.end(), literals, literals + literalCount);
+        output.push_back(static_cast<unsigned char>(offset & 0xFF));
+        output.push_back(static_cast<unsigned char>(offset >> 8));
+        if (matchCode >= 15) {
+            writeLength(output, matchCode - 15);
+        }
+    }
+
+    void writeLastLiterals(std::vector<unsigned char> &output, const unsigned char *literals,
+                           const std::size_t literalCount) {
+        output.push_back(static_cast<unsigned char>(std::min<std::size_t>(literalCount, 15) << 4));
+        if (literalCount >= 15) {
+            writeLength(output, literalCount - 15);
+        }
+        output.insert(output.end(), literals, literals + literalCount);
+    }
+}
+
+std::vector<unsigned char> Lz4::compress(const unsigned char *input, const std::size_t size) {
+    std::vector<unsigned char> output;
+    output.reserve(size + size / 255 + 16);
+
+    std::vector<std::uint32_t> table(std::size_t{1} << HASH_BITS, NO_POSITION);
+    std::size_t anchor = 0;
+    std::size_t position = 0;
+
+    if (size > MATCH_FIND_LIMIT) {
+        const std::size_t matchStartLimit = size - MATCH_FIND_LIMIT;
+        const std::size_t matchEndLimit = size - LAST_LITERALS;
+
+        while (position < matchStartLimit) {
+            const std::uint32_t sequence = read32(input + position);
+            std::uint32_t &slot = table[hashSequence(sequence)];
+            const std::size_t candidate = slot;
+            slot = static_cast<std::uint32_t>(position);
+
+            if (candidate == NO_POSITION || position - candidate > MAX_OFFSET || read32(input + candidate) != sequence) {
+                ++position;
+                continue;
+            }
+
+            std::size_t matchEnd = position + MIN_MATCH;
+            while (matchEnd < matchEndLimit && input[matchEnd] == input[candidate + (matchEnd - position)]) {
+                ++matchEnd;
+            }
+
+            writeSequence(output, input + anchor, position - anchor, position - candidate, matchEnd - position);
+            position = matchEnd;
+            anchor = position;
+        }
+    }
+
+    writeLastLiterals(output, input + anchor, size - anchor);
+    return output;
+}
+
+bool Lz4::decompress(const unsigned char *input, const std::size_t inputSize, unsigned char *output,
+                     const std::size_t outputSize) {
+    std::size_t in = 0;
+    std::size_t out = 0;
+
+    while (in < inputSize) {
+        const unsigned char token = input[in++];
+
+        std::size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(input, inputSize, in, literalCount)) {
+            return false;
+        }
+        if (literalCount > inputSize - in || literalCount > outputSize - out) {
+            return false;
+        }
+        if (literalCount != 0) {
+            // output is null when nothing is expected, and memcpy wants valid pointers even for zero bytes
+            std::memcpy(output + out, input + in, literalCount);
+        }
+        in += literalCount;
+        out += literalCount;
+
+        // the last sequence has literals only
+        if (in == inputSize) {
+            break;
+        }
+
+        if (inputSize - in < 2) {
+            return false;
+        }
+        const std::size_t offset = input[in] | (static_cast<std::size_t>(input[in + 1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > out) {
+            return false;
+        }
+
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(input, inputSize, in, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > outputSize - out) {
+            return false;
+        }
+
+        const unsigned char *match = output + out - offset;
+        if (offset >= matchLength) {
+            std::memcpy(output + out, match, matchLength);
+        } else {
+            // overlapping copy repeats the last `offset` bytes, it has to go forward one byte at a time
+            for (std::size_t i = 0; i < matchLength; ++i) {
+                output[out + i] = match[i];
+            }
+        }
+        out += matchLength;
+    }
+
+    return out == outputSize;
+}
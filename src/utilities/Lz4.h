@@ -0,0 +1,24 @@
+/**
+ * @file    Lz4.h
+ * @brief   LZ4 block compression
+ * @details A small, dependency-free implementation of the LZ4 block format: a greedy single-probe compressor
+ *          and a bounds-checked decompressor. It favours decompression speed over ratio, which is what packed
+ *          assets need; blocks it writes can be read by any LZ4 block decoder and the other way round.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Lz4 {
+    std::vector<unsigned char> compress(const unsigned char *input, std::size_t size);
+
+    // `outputSize` must be the exact decompressed size; false for corrupt or truncated input
+    bool decompress(const unsigned char *input, std::size_t inputSize, unsigned char *output, std::size_t outputSize);
+}
+
+#endif //LZ4_H
@@ -0,0 +1,51 @@
+/**
+ * @file    MappedFile.h
+ * @brief   MappedFile class header file
+ * @details Read-only memory mapping of a whole file (mmap on POSIX, file mappings on Windows), so binary assets
+ *          can be used in place without reading them into a buffer first.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Map `path` read-only; closes any previous mapping. Empty files fail, there is nothing to map.
+    bool open(const std::string &path);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return _data != nullptr; }
+
+    [[nodiscard]] const unsigned char *data() const { return _data; }
+
+    [[nodiscard]] std::size_t size() const { return _size; }
+
+private:
+    const unsigned char *_data = nullptr;
+    std::size_t _size = 0;
+#ifdef _WIN32
+    void *_file = nullptr;
+    void *_mapping = nullptr;
+#endif
+};
+
+
+#endif //MAPPEDFILE_H
@@ -0,0 +1,255 @@
+/**
+ * @file    TaskGraph.cpp
+ * @brief   TaskGraph class implementation file
+ * @details Dependency-ordered scheduling of main thread and worker tasks, and the Chrome trace export.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include "TaskGraph.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <rapidjson/filewritestream.h>
+#include <rapidjson/writer.h>
+#include "Logger.h"
+
+namespace {
+    constexpr std::size_t WRITE_BUFFER_BYTES = 16 * 1024;
+
+    const char *toString(const TaskGraph::Status status) {
+        switch (status) {
+            case TaskGraph::Status::Done:
+                return "done";
+            case TaskGraph::Status::Failed:
+                return "failed";
+            case TaskGraph::Status::Skipped:
+                return "skipped";
+            default:
+                return "pending";
+        }
+    }
+
+    double toMicroseconds(const std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+}
+
+TaskGraph::TaskId TaskGraph::add(std::string name, const Affinity affinity, std::function<bool()> work,
+                                 const std::vector<TaskId> &dependencies) {
+    const TaskId id = _tasks.size();
+    Task task;
+    task.name = std::move(name);
+    task.affinity = affinity;
+    task.work = std::move(work);
+    for (const TaskId dependency: dependencies) {
+        if (dependency >= id) {
+            LOG_ERROR("Task '{}' depends on a task added after it, the dependency is ignored", task.name);
+            continue;
+        }
+        _tasks[dependency].dependents.push_back(id);
+        ++task.dependencies;
+    }
+    _tasks.push_back(std::move(task));
+    return id;
+}
+
+bool TaskGraph::run(unsigned workerCount) {
+    _runStart = std::chrono::steady_clock::now();
+    _stats = {};
+    _stats.tasks = static_cast<int>(_tasks.size());
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<TaskId> mainReady;
+    std::deque<TaskId> workerReady;
+    std::vector<std::size_t> waiting(_tasks.size());
+    std::size_t finished = 0;
+
+    const auto enqueue = [&](const TaskId id) {
+        (_tasks[id].affinity == Affinity::Main ? mainReady : workerReady).push_back(id);
+    };
+
+    for (TaskId id = 0; id < _tasks.size(); ++id) {
+        _tasks[id].status = Status::Pending;
+        waiting[id] = _tasks[id].dependencies;
+        if (_tasks[id].affinity == Affinity::Worker) {
+            ++_stats.workerTasks;
+        }
+        if (waiting[id] == 0) {
+            enqueue(id);
+        }
+    }
+
+    // called with the lock held; a failure skips every task that can no longer run
+    const auto finish = [&](const TaskId id, const Status status) {
+        std::vector<std::pair<TaskId, Status> > pending{{id, status}};
+        while (!pending.empty()) {
+            const auto [current, result] = pending.back();
+            pending.pop_back();
+            _tasks[current].status = result;
+            ++finished;
+            for (const TaskId dependent: _tasks[current].dependents) {
+                if (result != Status::Done) {
+                    if (_tasks[dependent].status == Status::Pending) {
+                        // marked right away, so a second failed dependency doesn't skip it twice
+                        _tasks[dependent].status = Status::Skipped;
+                        pending.emplace_back(dependent, Status::Skipped);
+                    }
+                } else if (--waiting[dependent] == 0 && _tasks[dependent].status == Status::Pending) {
+                    enqueue(dependent);
+                }
+            }
+        }
+    };
+
+    const auto next = [&](std::deque<TaskId> &queue, std::unique_lock<std::mutex> &lock, TaskId &id) {
+        for (;;) {
+            wake.wait(lock, [&] { return !queue.empty() || finished == _tasks.size(); });
+            if (queue.empty()) {
+                return false;
+            }
+            id = queue.front();
+            queue.pop_front();
+            // skipped while it was queued
+            if (_tasks[id].status == Status::Pending) {
+                return true;
+            }
+        }
+    };
+
+    const auto process = [&](std::deque<TaskId> &queue, const int lane) {
+        std::unique_lock lock(mutex);
+        TaskId id = 0;
+        while (next(queue, lock, id)) {
+            lock.unlock();
+            const bool succeeded = _execute(_tasks[id], lane);
+            lock.lock();
+            finish(id, succeeded ? Status::Done : Status::Failed);
+            wake.notify_all();
+        }
+    };
+
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workerCount = std::min(workerCount, static_cast<unsigned>(_stats.workerTasks));
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(process, std::ref(workerReady), static_cast<int>(i) + 1);
+    }
+    process(mainReady, 0);
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    for (const Task &task: _tasks) {
+        if (task.status == Status::Failed) {
+            ++_stats.failed;
+        } else if (task.status == Status::Skipped) {
+            ++_stats.skipped;
+        }
+        if (task.affinity == Affinity::Worker && task.status != Status::Skipped) {
+            _stats.workerMs += std::chrono::duration<float, std::milli>(task.end - task.start).count();
+        }
+    }
+    _stats.elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _runStart).
+            count();
+    return _stats.failed == 0 && _stats.skipped == 0;
+}
+
+TaskGraph::Status TaskGraph::getStatus(const TaskId task) const {
+    return task < _tasks.size() ? _tasks[task].status : Status::Pending;
+}
+
+bool TaskGraph::writeTrace(const std::string &tracePath) const {
+    std::error_code error;
+    if (const auto parent = std::filesystem::path(tracePath).parent_path(); !parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+
+    const std::string tempPath = tracePath + ".tmp";
+    FILE *file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Could not create file for writing: {}", tempPath);
+        return false;
+    }
+
+    std::vector<char> buffer(WRITE_BUFFER_BYTES);
+    rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+    rapidjson::Writer writer(stream);
+
+    writer.StartObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (const Task &task: _tasks) {
+        // complete events ("X"): start and duration in microseconds since the run started
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(task.name.c_str(), static_cast<rapidjson::SizeType>(task.name.size()));
+        writer.Key("cat");
+        writer.String(task.affinity == Affinity::Main ? "main" : "worker");
+        writer.Key("ph");
+        writer.String("X");
+        writer.Key("pid");
+        writer.Int(1);
+        writer.Key("tid");
+        writer.Int(task.lane);
+        writer.Key("ts");
+        writer.Double(task.status == Status::Skipped ? 0.0 : toMicroseconds(task.start - _runStart));
+        writer.Key("dur");
+        writer.Double(task.status == Status::Skipped ? 0.0 : toMicroseconds(task.end - task.start));
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("status");
+        writer.String(toString(task.status));
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    stream.Flush();
+
+    const bool written = writer.IsComplete() && std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !written) {
+        LOG_ERROR("Could not write task trace: {}", tempPath);
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, tracePath, error);
+    if (error) {
+        LOG_ERROR("Could not replace task trace '{}': {}", tracePath, error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool TaskGraph::_execute(Task &task, const int lane) {
+    task.lane = lane;
+    task.start = std::chrono::steady_clock::now();
+    bool succeeded = false;
+    try {
+        succeeded = task.work();
+    } catch (const std::exception &exception) {
+        LOG_ERROR("Task '{}' threw: {}", task.name, exception.what());
+    } catch (...) {
+        LOG_ERROR("Task '{}' threw a non-standard exception", task.name);
+    }
+    task.end = std::chrono::steady_clock::now();
+    if (!succeeded) {
+        LOG_ERROR("Task '{}' failed", task.name);
+    }
+    return succeeded;
+}
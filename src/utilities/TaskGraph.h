@@ -0,0 +1,89 @@
+/**
+ * @file    TaskGraph.h
+ * @brief   TaskGraph class header file
+ * @details Runs a set of named tasks in dependency order. Worker tasks (file reads, parsing, decoding, directory
+ *          scans) run on a small pool of threads; main thread tasks (SDL, OpenGL, ImGui) run on the thread that
+ *          calls run(), as soon as their dependencies are done. Every task records when and on which thread it
+ *          ran, so a run can be written out as a Chrome trace (chrome://tracing, Perfetto).
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class TaskGraph {
+public:
+    enum class Affinity {
+        Main,
+        Worker
+    };
+
+    enum class Status {
+        Pending,
+        Done,
+        Failed,
+        Skipped // a dependency failed, the task never ran
+    };
+
+    using TaskId = std::size_t;
+
+    struct Stats {
+        int tasks = 0;
+        int workerTasks = 0;
+        int failed = 0;
+        int skipped = 0;
+        float elapsedMs = 0.0f; // wall time of the whole run
+        float workerMs = 0.0f; // summed run time of the worker tasks, i.e. what no longer blocks the main thread
+    };
+
+    /**
+     * Tasks may only depend on tasks added before them, which keeps the graph acyclic. A task returning false
+     * (or throwing) fails the run, and everything that depends on it is skipped.
+     */
+    TaskId add(std::string name, Affinity affinity, std::function<bool()> work,
+               const std::vector<TaskId> &dependencies = {});
+
+    /**
+     * Runs every task once and returns when all are done, failed or skipped. At most `workerCount` worker
+     * threads are started, 0 picks one per core (never more than there are worker tasks).
+     * @return  True if every task succeeded.
+     */
+    bool run(unsigned workerCount = 0);
+
+    [[nodiscard]] Status getStatus(TaskId task) const;
+
+    [[nodiscard]] const Stats &getStats() const { return _stats; }
+
+    // Chrome trace event JSON of the last run, one lane per thread; written next to the target and renamed over it
+    bool writeTrace(const std::string &tracePath) const;
+
+private:
+    struct Task {
+        std::string name;
+        Affinity affinity = Affinity::Worker;
+        std::function<bool()> work;
+        std::vector<TaskId> dependents;
+        std::size_t dependencies = 0;
+        Status status = Status::Pending;
+        int lane = 0; // 0 is the main thread, workers count from 1
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    std::vector<Task> _tasks;
+    std::chrono::steady_clock::time_point _runStart;
+    Stats _stats;
+
+    // Runs one task on the calling thread and records its timing; never throws
+    static bool _execute(Task &task, int lane);
+};
+
+
+#endif //TASKGRAPH_H
@@ -0,0 +1,114 @@
+/**
+ * @file   AssetPackTest.cpp
+ * @brief  Building, mounting and validating asset packs.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "TestSupport.h"
+#include "utilities/AssetPack.h"
+
+namespace {
+    class AssetPackTest : public testing::Test {
+    protected:
+        std::filesystem::path _directory;
+        std::string _packPath;
+
+        void SetUp() override {
+            _directory = makeScratchDirectory("AssetPackTest");
+            writeFile(_directory / "tree/shaders/color.vert", std::string(5000, 'x') + "void main() {}");
+            writeFile(_directory / "tree/textures/empty.png", "");
+            std::string noise(3000, '\0');
+            for (std::size_t i = 0; i < noise.size(); ++i) {
+                noise[i] = static_cast<char>(i * 2654435761u >> 13);
+            }
+            writeFile(_directory / "tree/audio/noise.wav", noise);
+            _packPath = (_directory / "resources.cbpak").string();
+        }
+
+        // Rewrites the bucket table of the built pack and tries to mount the result
+        bool mountWithBuckets(const std::function<void(std::uint32_t *buckets, std::uint32_t count)> &edit) const {
+            std::ifstream in(_packPath, std::ios::binary);
+            std::string bytes((std::istreambuf_iterator(in)), std::istreambuf_iterator<char>());
+            AssetPackHeader header{};
+            std::memcpy(&header, bytes.data(), sizeof(header));
+
+            std::vector<std::uint32_t> buckets(header.bucketCount);
+            std::memcpy(buckets.data(), bytes.data() + header.bucketsOffset, buckets.size() * sizeof(std::uint32_t));
+            edit(buckets.data(), header.bucketCount);
+            std::memcpy(bytes.data() + header.bucketsOffset, buckets.data(), buckets.size() * sizeof(std::uint32_t));
+
+            const auto editedPath = _directory / "edited.cbpak";
+            writeFile(editedPath, bytes);
+            AssetPack pack;
+            return pack.mount(editedPath.string());
+        }
+    };
+}
+
+TEST_F(AssetPackTest, FindsAndReadsEveryFile) {
+    for (const bool compress: {false, true}) {
+        ASSERT_TRUE(AssetPack::build(_directory / "tree", _packPath, compress));
+        AssetPack pack;
+        ASSERT_TRUE(pack.mount(_packPath));
+        EXPECT_EQ(pack.getEntries().size(), 3u);
+
+        std::vector<unsigned char> bytes;
+        const AssetPackEntry *shader = pack.find("shaders/color.vert");
+        ASSERT_NE(shader, nullptr);
+        ASSERT_TRUE(pack.read(*shader, bytes));
+        EXPECT_EQ(std::string(bytes.begin(), bytes.end()), std::string(5000, 'x') + "void main() {}");
+        EXPECT_EQ(shader->compression, compress ? AssetCompression::Lz4 : AssetCompression::None);
+
+        const AssetPackEntry *empty = pack.find("textures/empty.png");
+        ASSERT_NE(empty, nullptr);
+        ASSERT_TRUE(pack.read(*empty, bytes));
+        EXPECT_TRUE(bytes.empty());
+
+        EXPECT_NE(pack.find("audio/noise.wav"), nullptr);
+        EXPECT_EQ(pack.find("shaders/color.frag"), nullptr);
+        EXPECT_EQ(pack.find("shaders/color.ver"), nullptr);
+    }
+}
+
+TEST_F(AssetPackTest, RejectsACorruptHeader) {
+    ASSERT_TRUE(AssetPack::build(_directory / "tree", _packPath));
+    {
+        std::fstream file(_packPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(0);
+        file.put('X');
+    }
+    AssetPack pack;
+    EXPECT_FALSE(pack.mount(_packPath));
+}
+
+TEST_F(AssetPackTest, RejectsBucketTablesALookupCouldLoopOn) {
+    ASSERT_TRUE(AssetPack::build(_directory / "tree", _packPath));
+
+    EXPECT_TRUE(mountWithBuckets([](std::uint32_t *, std::uint32_t) {}));
+
+    // no empty bucket at all: a lookup for a missing path would probe forever
+    EXPECT_FALSE(mountWithBuckets([](std::uint32_t *buckets, const std::uint32_t count) {
+        std::fill(buckets, buckets + count, 1u);
+    }));
+
+    // one entry in two buckets
+    EXPECT_FALSE(mountWithBuckets([](std::uint32_t *buckets, const std::uint32_t count) {
+        const auto empty = std::find(buckets, buckets + count, 0u);
+        const auto used = std::find_if(buckets, buckets + count, [](const std::uint32_t bucket) {
+            return bucket != 0;
+        });
+        *empty = *used;
+    }));
+
+    // an entry index past the end
+    EXPECT_FALSE(mountWithBuckets([](std::uint32_t *buckets, const std::uint32_t count) {
+        *std::find(buckets, buckets + count, 0u) = 4u;
+    }));
+}
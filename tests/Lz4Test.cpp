@@ -0,0 +1,68 @@
+/**
+ * @file   Lz4Test.cpp
+ * @brief  Round trips through the LZ4 block compressor.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "utilities/Lz4.h"
+
+namespace {
+    std::vector<unsigned char> roundTrip(const std::vector<unsigned char> &input) {
+        const std::vector<unsigned char> compressed = Lz4::compress(input.data(), input.size());
+        std::vector<unsigned char> output(input.size());
+        EXPECT_TRUE(Lz4::decompress(compressed.data(), compressed.size(), output.data(), output.size()));
+        return output;
+    }
+
+    std::vector<unsigned char> randomBytes(const std::size_t size) {
+        std::mt19937 random(42);
+        std::vector<unsigned char> bytes(size);
+        for (auto &byte: bytes) {
+            byte = static_cast<unsigned char>(random());
+        }
+        return bytes;
+    }
+}
+
+TEST(Lz4Test, RepetitiveInputShrinksAndRoundTrips) {
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += "uniform mat4 model; // line " + std::to_string(i % 7) + "\n";
+    }
+    const std::vector<unsigned char> input(text.begin(), text.end());
+
+    EXPECT_LT(Lz4::compress(input.data(), input.size()).size(), input.size() / 4);
+    EXPECT_EQ(roundTrip(input), input);
+}
+
+TEST(Lz4Test, IncompressibleInputRoundTrips) {
+    const auto input = randomBytes(100000);
+
+    // stored as literals, the output may only grow by the length bytes
+    EXPECT_LE(Lz4::compress(input.data(), input.size()).size(), input.size() + input.size() / 255 + 16);
+    EXPECT_EQ(roundTrip(input), input);
+}
+
+TEST(Lz4Test, ShortAndEmptyInputsRoundTrip) {
+    for (const std::size_t size: {0u, 1u, 5u, 12u, 13u, 64u}) {
+        std::vector<unsigned char> input(size, 'a');
+        EXPECT_EQ(roundTrip(input), input) << size << " bytes";
+    }
+}
+
+TEST(Lz4Test, RejectsTruncatedInputAndWrongSize) {
+    const auto input = randomBytes(4096);
+    std::vector<unsigned char> compressed = Lz4::compress(input.data(), input.size());
+    std::vector<unsigned char> output(input.size() + 1);
+
+    EXPECT_FALSE(Lz4::decompress(compressed.data(), compressed.size(), output.data(), input.size() - 1));
+    EXPECT_FALSE(Lz4::decompress(compressed.data(), compressed.size(), output.data(), input.size() + 1));
+
+    compressed.pop_back();
+    EXPECT_FALSE(Lz4::decompress(compressed.data(), compressed.size(), output.data(), input.size()));
+}
@@ -0,0 +1,165 @@
+/**
+ * @file   MeshTest.cpp
+ * @brief  OBJ parsing and mesh optimization.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/mesh/MeshOptimizer.h"
+#include "core/mesh/ObjParser.h"
+
+namespace {
+    constexpr std::size_t FLOATS_PER_VERTEX = 8;
+
+    bool parse(const std::string &text, GeometryData &data) {
+        return ObjParser::parse(text.data(), text.size(), data);
+    }
+
+    std::array<float, 3> positionOf(const GeometryData &data, const unsigned int vertex) {
+        const float *position = &data.vertices[vertex * FLOATS_PER_VERTEX];
+        return {position[0], position[1], position[2]};
+    }
+
+    // Triangles as corner positions, each rotated to start at its smallest corner so winding is kept
+    std::vector<std::array<std::array<float, 3>, 3> > triangles(const GeometryData &data) {
+        std::vector<std::array<std::array<float, 3>, 3> > result;
+        for (std::size_t i = 0; i < data.indices.size(); i += 3) {
+            std::array<std::array<float, 3>, 3> triangle{
+                positionOf(data, data.indices[i]), positionOf(data, data.indices[i + 1]),
+                positionOf(data, data.indices[i + 2])
+            };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            result.push_back(triangle);
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // A size x size grid of quads as an OBJ, with negative (relative) face indices if asked
+    std::string makeGrid(const int size, const bool relative) {
+        std::string text;
+        for (int y = 0; y <= size; ++y) {
+            for (int x = 0; x <= size; ++x) {
+                text += "v " + std::to_string(x) + " " + std::to_string(y) + " 0\n";
+            }
+        }
+        const int vertexCount = (size + 1) * (size + 1);
+        const auto index = [&](const int x, const int y) {
+            const int absolute = y * (size + 1) + x + 1;
+            return std::to_string(relative ? absolute - vertexCount - 1 : absolute);
+        };
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                text += "f " + index(x, y) + " " + index(x + 1, y) + " " + index(x + 1, y + 1) + " " +
+                        index(x, y + 1) + "\n";
+            }
+        }
+        return text;
+    }
+}
+
+TEST(ObjParserTest, DeduplicatesCornersAndTriangulatesPolygons) {
+    const std::string text =
+            "# quad with a normal and texcoords\n"
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+            "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+            "vn 0 0 1\n"
+            "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+            "f 1/1/1 3/3/1 4/4/1\n";
+    GeometryData data;
+    ASSERT_TRUE(parse(text, data));
+
+    EXPECT_EQ(data.vertices.size(), 4 * FLOATS_PER_VERTEX);
+    EXPECT_EQ(data.indices, (std::vector<unsigned int>{0, 1, 2, 0, 2, 3, 0, 2, 3}));
+
+    const float *corner = &data.vertices[2 * FLOATS_PER_VERTEX];
+    EXPECT_EQ(std::vector(corner, corner + FLOATS_PER_VERTEX),
+              (std::vector<float>{1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f}));
+}
+
+TEST(ObjParserTest, SameCornerWithOtherAttributesIsANewVertex) {
+    GeometryData data;
+    ASSERT_TRUE(parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvt 1 1\nf 1/1 2/1 3/1\nf 1/2 2/1 3/1\n", data));
+    EXPECT_EQ(data.vertices.size(), 4 * FLOATS_PER_VERTEX);
+}
+
+TEST(ObjParserTest, RejectsMissingReferences) {
+    GeometryData data;
+    EXPECT_FALSE(parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n", data));
+    EXPECT_FALSE(parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1/4 2 3\n", data));
+    EXPECT_FALSE(parse("v 0 0 0\nf -2 -1 1\n", data));
+}
+
+TEST(ObjParserTest, RelativeIndicesMatchAbsoluteOnesAcrossChunks) {
+    // big enough to be split into several chunks, so relative indices reach across chunk boundaries
+    const std::string absolute = makeGrid(300, false);
+    const std::string relative = makeGrid(300, true);
+    ASSERT_GT(relative.size(), 2 * ObjParser::MIN_CHUNK_BYTES);
+
+    GeometryData expected, actual;
+    ASSERT_TRUE(parse(absolute, expected));
+    ASSERT_TRUE(parse(relative, actual));
+    EXPECT_EQ(actual.vertices, expected.vertices);
+    EXPECT_EQ(actual.indices, expected.indices);
+    EXPECT_EQ(actual.indices.size(), 300u * 300u * 6u);
+}
+
+TEST(MeshOptimizerTest, VertexCacheOrderKeepsTrianglesAndLowersAcmr) {
+    GeometryData data;
+    ASSERT_TRUE(parse(makeGrid(40, false), data));
+
+    // shuffled triangles are about the worst order a cache can get
+    std::vector<std::array<unsigned int, 3> > shuffled;
+    for (std::size_t i = 0; i < data.indices.size(); i += 3) {
+        shuffled.push_back({data.indices[i], data.indices[i + 1], data.indices[i + 2]});
+    }
+    std::ranges::shuffle(shuffled, std::mt19937(7));
+    data.indices.clear();
+    for (const auto &triangle: shuffled) {
+        data.indices.insert(data.indices.end(), triangle.begin(), triangle.end());
+    }
+
+    const auto before = triangles(data);
+    const float acmrBefore = MeshOptimizer::getACMR(data.indices);
+    MeshOptimizer::optimizeVertexCache(data.indices, data.vertices.size() / FLOATS_PER_VERTEX);
+
+    EXPECT_EQ(triangles(data), before);
+    EXPECT_LT(MeshOptimizer::getACMR(data.indices), acmrBefore * 0.6f);
+    EXPECT_LT(MeshOptimizer::getACMR(data.indices), 1.0f);
+}
+
+TEST(MeshOptimizerTest, VertexFetchOrderFollowsFirstUseAndDropsUnused) {
+    GeometryData data;
+    data.vertices = {
+        9, 9, 9, 0, 0, 1, 0, 0, // never referenced
+        2, 0, 0, 0, 0, 1, 0, 0,
+        1, 0, 0, 0, 0, 1, 0, 0,
+        0, 0, 0, 0, 0, 1, 0, 0,
+    };
+    data.indices = {3, 2, 1};
+
+    const auto before = triangles(data);
+    MeshOptimizer::optimizeVertexFetch(data);
+
+    EXPECT_EQ(data.indices, (std::vector<unsigned int>{0, 1, 2}));
+    EXPECT_EQ(data.vertices.size(), 3 * FLOATS_PER_VERTEX);
+    EXPECT_EQ(triangles(data), before);
+}
+
+TEST(MeshOptimizerTest, QuantizedVerticesUseTheFormatStride) {
+    GeometryData data;
+    ASSERT_TRUE(parse(makeGrid(4, false), data));
+    const std::size_t vertexCount = data.vertices.size() / FLOATS_PER_VERTEX;
+
+    for (const VertexFormat format: {VertexFormat::Float32, VertexFormat::Compact,
+                                     VertexFormat::CompactHalfPositions}) {
+        const auto packed = MeshOptimizer::quantize(data.vertices, format);
+        EXPECT_EQ(packed.size(), vertexCount * static_cast<std::size_t>(VertexLayout::get(format).stride));
+    }
+}
@@ -0,0 +1,250 @@
+/**
+ * @file   SceneTest.cpp
+ * @brief  Round trips of scenes through snapshots, scene files and journals.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "TestSupport.h"
+#include "core/ecs/GameObject.h"
+#include "core/project/Scene.h"
+#include "core/project/SceneJournal.h"
+#include "core/project/SceneSerializer.h"
+#include "core/project/SceneSnapshot.h"
+
+namespace {
+    class SceneTest : public testing::Test {
+    protected:
+        std::filesystem::path _directory;
+        Scene _scene;
+
+        void SetUp() override {
+            _directory = makeScratchDirectory("SceneTest");
+            _scene.setName("level");
+
+            auto &ecs = _scene.getEntityComponentSystem();
+            GameObject player = ecs.createGameObject("player", "uuid-player");
+            player.addComponent<TransformComponent>(glm::vec3{1.0f, 2.0f, 3.0f}, glm::vec3{0.0f, 90.0f, 0.0f},
+                                                    glm::vec3{2.0f});
+            player.addComponent<PointLightComponent>().color = glm::vec3{1.0f, 0.5f, 0.25f};
+
+            GameObject sun = ecs.createGameObject("sun", "uuid-sun");
+            sun.addComponent<DirectionalLightComponent>().direction = glm::vec3{0.0f, -1.0f, 0.0f};
+
+            ecs.createGameObject("marker", "uuid-marker");
+        }
+
+        [[nodiscard]] std::string path(const std::string &name) const {
+            return (_directory / name).string();
+        }
+
+        static entt::entity find(Scene &scene, const std::string &uuid) {
+            auto &registry = scene.getEntityComponentSystem().getRegistry();
+            for (const auto view = registry.view<IdComponent>(); const auto entity: view) {
+                if (view.get<IdComponent>(entity).uuid == uuid) {
+                    return entity;
+                }
+            }
+            return entt::null;
+        }
+
+        static std::size_t entityCount(Scene &scene) {
+            return scene.getEntityComponentSystem().getRegistry().view<IdComponent>().size();
+        }
+
+        // What SetUp() created, as loaded into `scene`
+        static void expectInitialEntities(Scene &scene) {
+            auto &registry = scene.getEntityComponentSystem().getRegistry();
+            EXPECT_EQ(entityCount(scene), 3u);
+
+            const entt::entity player = find(scene, "uuid-player");
+            ASSERT_TRUE(registry.valid(player));
+            EXPECT_EQ(registry.get<TagComponent>(player).tag, "player");
+            const auto &transform = registry.get<TransformComponent>(player);
+            EXPECT_EQ(transform.position, (glm::vec3{1.0f, 2.0f, 3.0f}));
+            EXPECT_EQ(transform.rotation, (glm::vec3{0.0f, 90.0f, 0.0f}));
+            EXPECT_EQ(transform.scale, glm::vec3{2.0f});
+            EXPECT_EQ(registry.get<PointLightComponent>(player).color, (glm::vec3{1.0f, 0.5f, 0.25f}));
+            EXPECT_FALSE(registry.any_of<DirectionalLightComponent>(player));
+
+            const entt::entity sun = find(scene, "uuid-sun");
+            ASSERT_TRUE(registry.valid(sun));
+            EXPECT_EQ(registry.get<DirectionalLightComponent>(sun).direction, (glm::vec3{0.0f, -1.0f, 0.0f}));
+            EXPECT_FALSE(registry.any_of<TransformComponent>(sun));
+
+            const entt::entity marker = find(scene, "uuid-marker");
+            ASSERT_TRUE(registry.valid(marker));
+            EXPECT_EQ(registry.get<TagComponent>(marker).tag, "marker");
+        }
+    };
+}
+
+TEST_F(SceneTest, SnapshotRoundTrip) {
+    const std::string snapshotPath = path("level.cbscene");
+    ASSERT_TRUE(SceneSnapshot(_scene).saveToFile(snapshotPath));
+
+    Scene loaded;
+    ASSERT_TRUE(SceneSnapshot(loaded).loadFromFile(snapshotPath));
+    expectInitialEntities(loaded);
+}
+
+TEST_F(SceneTest, SnapshotWithRepeatedEntitiesOrColumnsIsRejected) {
+    // a second transform makes the transform column sparse with two entries
+    _scene.getEntityComponentSystem().createGameObject("extra", "uuid-extra")
+            .addComponent<TransformComponent>(glm::vec3{1.0f});
+    const std::string snapshotPath = path("level.cbscene");
+    ASSERT_TRUE(SceneSnapshot(_scene).saveToFile(snapshotPath));
+
+    std::string intact;
+    {
+        std::ifstream file(snapshotPath, std::ios::binary);
+        intact.assign(std::istreambuf_iterator<char>(file), {});
+    }
+    SceneSnapshotHeader header;
+    std::memcpy(&header, intact.data(), sizeof(header));
+    const auto columnAt = [&](const std::string &bytes, const std::uint32_t i) {
+        SceneSnapshotColumn column;
+        std::memcpy(&column, bytes.data() + header.columnTableOffset + i * sizeof(column), sizeof(column));
+        return column;
+    };
+    const auto findColumn = [&](const SceneSnapshot::Column id) {
+        for (std::uint32_t i = 0; i < header.columnCount; ++i) {
+            if (columnAt(intact, i).id == static_cast<std::uint32_t>(id)) {
+                return i;
+            }
+        }
+        return header.columnCount;
+    };
+
+    // the same entity twice in one column
+    const std::uint32_t transformColumn = findColumn(SceneSnapshot::Column::Transform);
+    ASSERT_LT(transformColumn, header.columnCount);
+    const SceneSnapshotColumn transforms = columnAt(intact, transformColumn);
+    ASSERT_EQ(transforms.count, 2u);
+    std::string corrupt = intact;
+    std::memcpy(corrupt.data() + transforms.entitiesOffset + 4, corrupt.data() + transforms.entitiesOffset, 4);
+    writeFile(snapshotPath, corrupt);
+    Scene repeatedEntity;
+    EXPECT_FALSE(SceneSnapshot(repeatedEntity).loadFromFile(snapshotPath));
+
+    // the uuid column relabelled as a second tag column
+    const std::uint32_t uuidColumn = findColumn(SceneSnapshot::Column::Uuid);
+    ASSERT_LT(uuidColumn, header.columnCount);
+    corrupt = intact;
+    const auto tag = static_cast<std::uint32_t>(SceneSnapshot::Column::Tag);
+    std::memcpy(corrupt.data() + header.columnTableOffset + uuidColumn * sizeof(SceneSnapshotColumn), &tag,
+                sizeof(tag));
+    writeFile(snapshotPath, corrupt);
+    Scene repeatedColumn;
+    EXPECT_FALSE(SceneSnapshot(repeatedColumn).loadFromFile(snapshotPath));
+}
+
+TEST_F(SceneTest, SceneFileRoundTripWithBothParsers) {
+    const std::string jsonPath = path("level.json");
+    ASSERT_TRUE(SceneSerializer(_scene).saveToFile(jsonPath));
+
+    for (const JsonBackend backend: {JsonBackend::RapidJson, JsonBackend::Simdjson}) {
+        Scene loaded;
+        ASSERT_TRUE(SceneSerializer(loaded).loadFromFile(jsonPath, backend));
+        expectInitialEntities(loaded);
+    }
+}
+
+TEST_F(SceneTest, JournalReplaysEditsOnTopOfTheSceneFile) {
+    const std::string jsonPath = path("level.json");
+    const std::string journalPath = SceneJournal::getJournalPath(jsonPath);
+    ASSERT_TRUE(SceneSerializer(_scene).saveToFile(jsonPath));
+
+    auto &ecs = _scene.getEntityComponentSystem();
+    SceneJournal journal(_scene);
+    EXPECT_FALSE(journal.hasChanges());
+
+    ecs.patchComponent<TransformComponent>(find(_scene, "uuid-player"), [](TransformComponent &transform) {
+        transform.position = glm::vec3{4.0f, 5.0f, 6.0f};
+    });
+    ecs.destroyGameObject(GameObject(find(_scene, "uuid-sun"), &ecs));
+    ecs.createGameObject("added", "uuid-added").addComponent<TransformComponent>(glm::vec3{7.0f});
+    ASSERT_TRUE(journal.hasChanges());
+    ASSERT_TRUE(journal.append(journalPath));
+    EXPECT_FALSE(journal.hasChanges());
+
+    Scene loaded;
+    const SceneSerializer serializer(loaded);
+    ASSERT_TRUE(serializer.loadFromFile(jsonPath, JsonBackend::Simdjson));
+    ASSERT_TRUE(serializer.replayJournal(journalPath));
+
+    auto &registry = loaded.getEntityComponentSystem().getRegistry();
+    EXPECT_EQ(entityCount(loaded), 3u);
+    EXPECT_EQ(find(loaded, "uuid-sun"), entt::entity{entt::null});
+    EXPECT_EQ(registry.get<TransformComponent>(find(loaded, "uuid-player")).position,
+              (glm::vec3{4.0f, 5.0f, 6.0f}));
+    // an upsert carries the whole entity, not just the component that changed
+    EXPECT_EQ(registry.get<PointLightComponent>(find(loaded, "uuid-player")).color, (glm::vec3{1.0f, 0.5f, 0.25f}));
+    EXPECT_EQ(registry.get<TransformComponent>(find(loaded, "uuid-added")).position, glm::vec3{7.0f});
+}
+
+TEST_F(SceneTest, ReplayCutsATornLastRecord) {
+    const std::string jsonPath = path("level.json");
+    const std::string journalPath = SceneJournal::getJournalPath(jsonPath);
+    ASSERT_TRUE(SceneSerializer(_scene).saveToFile(jsonPath));
+
+    SceneJournal journal(_scene);
+    _scene.getEntityComponentSystem().createGameObject("added", "uuid-added");
+    ASSERT_TRUE(journal.append(journalPath));
+    const auto intactSize = std::filesystem::file_size(journalPath);
+
+    // what a crash in the middle of an append leaves behind
+    std::ofstream(journalPath, std::ios::binary | std::ios::app) << R"({"upsert":{"tag":"tor)";
+
+    Scene loaded;
+    const SceneSerializer serializer(loaded);
+    ASSERT_TRUE(serializer.loadFromFile(jsonPath, JsonBackend::Simdjson));
+    ASSERT_TRUE(serializer.replayJournal(journalPath));
+
+    EXPECT_EQ(entityCount(loaded), 4u);
+    EXPECT_NE(find(loaded, "uuid-added"), entt::entity{entt::null});
+    EXPECT_EQ(std::filesystem::file_size(journalPath), intactSize);
+}
+
+TEST_F(SceneTest, ReplaySkipsACorruptRecordInTheMiddle) {
+    const std::string jsonPath = path("level.json");
+    const std::string journalPath = SceneJournal::getJournalPath(jsonPath);
+    ASSERT_TRUE(SceneSerializer(_scene).saveToFile(jsonPath));
+
+    auto &ecs = _scene.getEntityComponentSystem();
+    SceneJournal journal(_scene);
+    for (const std::string name: {"first", "second", "third"}) {
+        ecs.createGameObject(name, "uuid-" + name);
+        ASSERT_TRUE(journal.append(journalPath));
+    }
+
+    // damage the second record without changing its length or line break
+    std::string contents;
+    {
+        std::ifstream file(journalPath, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), {});
+    }
+    const auto second = contents.find("uuid-second");
+    ASSERT_NE(second, std::string::npos);
+    const auto lineStart = contents.rfind('\n', second) + 1;
+    contents[lineStart] = '[';
+    writeFile(journalPath, contents);
+
+    Scene loaded;
+    const SceneSerializer serializer(loaded);
+    ASSERT_TRUE(serializer.loadFromFile(jsonPath, JsonBackend::Simdjson));
+    ASSERT_TRUE(serializer.replayJournal(journalPath));
+
+    EXPECT_EQ(entityCount(loaded), 5u);
+    EXPECT_NE(find(loaded, "uuid-first"), entt::entity{entt::null});
+    EXPECT_EQ(find(loaded, "uuid-second"), entt::entity{entt::null});
+    EXPECT_NE(find(loaded, "uuid-third"), entt::entity{entt::null});
+    EXPECT_EQ(std::filesystem::file_size(journalPath), contents.size());
+}
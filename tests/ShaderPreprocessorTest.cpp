@@ -0,0 +1,129 @@
+/**
+ * @file   ShaderPreprocessorTest.cpp
+ * @brief  Include expansion and define injection of the shader preprocessor.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "TestSupport.h"
+#include "core/graphic/ShaderPreprocessor.h"
+
+namespace {
+    class ShaderPreprocessorTest : public testing::Test {
+    protected:
+        std::filesystem::path _directory;
+
+        void SetUp() override {
+            _directory = makeScratchDirectory("ShaderPreprocessorTest");
+        }
+
+        [[nodiscard]] std::string path(const std::string &name) const {
+            return (_directory / name).lexically_normal().generic_string();
+        }
+
+        static std::size_t count(const std::string &text, const std::string &needle) {
+            std::size_t found = 0;
+            for (auto position = text.find(needle); position != std::string::npos;
+                 position = text.find(needle, position + 1)) {
+                ++found;
+            }
+            return found;
+        }
+
+        // File index and line number the compiler would report for the line holding `needle`, following #line
+        static std::pair<std::size_t, std::size_t> locate(const std::string &text, const std::string &needle) {
+            std::size_t file = 0;
+            std::size_t line = 1;
+            std::istringstream lines(text);
+            for (std::string current; std::getline(lines, current);) {
+                if (current.find(needle) != std::string::npos) {
+                    return {file, line};
+                }
+                if (current.starts_with("#line ")) {
+                    std::istringstream(current.substr(6)) >> line >> file;
+                } else {
+                    ++line;
+                }
+            }
+            return {0, 0};
+        }
+    };
+}
+
+TEST_F(ShaderPreprocessorTest, ExpandsIncludesRelativeToTheIncludingFileOnce) {
+    writeFile(_directory / "shaders/lit.frag",
+              "#version 330 core\n#include \"common/light.glsl\"\n#include \"common/math.glsl\"\nvoid main() {}\n");
+    writeFile(_directory / "shaders/common/light.glsl", "#version 330 core\n#include \"math.glsl\"\nLIGHT\n");
+    writeFile(_directory / "shaders/common/math.glsl", "MATH\n");
+
+    ShaderSource source;
+    ASSERT_TRUE(ShaderPreprocessor::process(path("shaders/lit.frag"), {}, source));
+
+    EXPECT_EQ(source.files, (std::vector<std::string>{
+                  path("shaders/lit.frag"), path("shaders/common/light.glsl"), path("shaders/common/math.glsl")
+                  }));
+    EXPECT_EQ(count(source.text, "#version"), 1u);
+    EXPECT_EQ(count(source.text, "MATH"), 1u);
+    EXPECT_LT(source.text.find("MATH"), source.text.find("LIGHT"));
+    EXPECT_LT(source.text.find("LIGHT"), source.text.find("void main"));
+    EXPECT_EQ(source.text.find("#include"), std::string::npos);
+    // errors in the main file still report its own line numbers after an include
+    EXPECT_NE(source.text.find("#line 3 0\n"), std::string::npos);
+}
+
+TEST_F(ShaderPreprocessorTest, IncludeCyclesTerminate) {
+    writeFile(_directory / "a.glsl", "#include \"b.glsl\"\nA\n");
+    writeFile(_directory / "b.glsl", "#include \"a.glsl\"\nB\n");
+
+    ShaderSource source;
+    ASSERT_TRUE(ShaderPreprocessor::process(path("a.glsl"), {}, source));
+    EXPECT_EQ(source.files.size(), 2u);
+    EXPECT_EQ(count(source.text, "A\n"), 1u);
+    EXPECT_EQ(count(source.text, "B\n"), 1u);
+}
+
+TEST_F(ShaderPreprocessorTest, SkippedLinesKeepLaterLineNumbers) {
+    writeFile(_directory / "main.frag",
+              "#version 330 core\n#include \"common.glsl\"\n#include \"common.glsl\"\nMAIN_ERROR\n");
+    writeFile(_directory / "common.glsl", "#version 330 core\nCOMMON\nCOMMON_ERROR\n");
+
+    ShaderSource source;
+    ASSERT_TRUE(ShaderPreprocessor::process(path("main.frag"), {}, source));
+    EXPECT_EQ(locate(source.text, "COMMON_ERROR"), (std::pair<std::size_t, std::size_t>{1, 3}));
+    // after the repeated include, which is skipped
+    EXPECT_EQ(locate(source.text, "MAIN_ERROR"), (std::pair<std::size_t, std::size_t>{0, 4}));
+}
+
+TEST_F(ShaderPreprocessorTest, MissingIncludeFailsButListsTheFile) {
+    writeFile(_directory / "main.vert", "#version 330 core\n#include \"missing.glsl\"\nvoid main() {}\n");
+
+    ShaderSource source;
+    EXPECT_FALSE(ShaderPreprocessor::process(path("main.vert"), {}, source));
+    EXPECT_EQ(source.files, (std::vector<std::string>{path("main.vert"), path("missing.glsl")}));
+}
+
+TEST_F(ShaderPreprocessorTest, DefinesGoRightAfterVersion) {
+    writeFile(_directory / "mesh.frag", "// comment\n#version 330 core\nvoid main() {}\n");
+
+    ShaderSource source;
+    ASSERT_TRUE(ShaderPreprocessor::process(path("mesh.frag"), {{"TEXTURED", ""}, {"MAX_LIGHTS", "8"}}, source));
+    EXPECT_EQ(source.text, "// comment\n#version 330 core\n#define MAX_LIGHTS 8\n#define TEXTURED\n#line 3 0\n"
+              "void main() {}\n");
+}
+
+TEST_F(ShaderPreprocessorTest, KeysDoNotDependOnDefineOrder) {
+    ShaderDefines first;
+    first["TEXTURED"] = "";
+    first["MAX_LIGHTS"] = "8";
+    ShaderDefines second;
+    second["MAX_LIGHTS"] = "8";
+    second["TEXTURED"] = "";
+
+    EXPECT_EQ(ShaderPreprocessor::makeKey(first), "MAX_LIGHTS=8;TEXTURED");
+    EXPECT_EQ(ShaderPreprocessor::makeKey(first), ShaderPreprocessor::makeKey(second));
+    EXPECT_EQ(ShaderPreprocessor::makeKey({}), "");
+}
@@ -0,0 +1,93 @@
+/**
+ * @file   TaskGraphTest.cpp
+ * @brief  Ordering and failure handling of the startup task graph.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "utilities/TaskGraph.h"
+
+using Affinity = TaskGraph::Affinity;
+using Status = TaskGraph::Status;
+
+TEST(TaskGraphTest, RunsDependenciesFirstAndMainTasksOnTheCallingThread) {
+    TaskGraph graph;
+    std::mutex mutex;
+    std::vector<int> order;
+    const auto record = [&](const int task) {
+        return [&, task] {
+            std::lock_guard lock(mutex);
+            order.push_back(task);
+            return true;
+        };
+    };
+
+    const std::thread::id caller = std::this_thread::get_id();
+    std::thread::id mainTaskThread;
+    const auto a = graph.add("a", Affinity::Worker, record(0));
+    const auto b = graph.add("b", Affinity::Worker, record(1));
+    const auto c = graph.add("c", Affinity::Main, [&] {
+        mainTaskThread = std::this_thread::get_id();
+        return record(2)();
+    }, {a, b});
+    graph.add("d", Affinity::Worker, record(3), {c});
+
+    ASSERT_TRUE(graph.run(2));
+    EXPECT_EQ(mainTaskThread, caller);
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[2], 2);
+    EXPECT_EQ(order[3], 3);
+    EXPECT_EQ(graph.getStats().tasks, 4);
+    EXPECT_EQ(graph.getStats().workerTasks, 3);
+}
+
+TEST(TaskGraphTest, FailureSkipsEveryDependentButNothingElse) {
+    TaskGraph graph;
+    std::atomic<int> ran = 0;
+    const auto succeed = [&] {
+        ++ran;
+        return true;
+    };
+
+    const auto failing = graph.add("failing", Affinity::Worker, [] { return false; });
+    const auto independent = graph.add("independent", Affinity::Worker, succeed);
+    const auto child = graph.add("child", Affinity::Main, succeed, {failing});
+    const auto both = graph.add("both", Affinity::Worker, succeed, {failing, independent});
+    const auto grandchild = graph.add("grandchild", Affinity::Worker, succeed, {child, independent});
+    const auto sibling = graph.add("sibling", Affinity::Main, succeed, {independent});
+
+    EXPECT_FALSE(graph.run(2));
+    EXPECT_EQ(graph.getStatus(failing), Status::Failed);
+    EXPECT_EQ(graph.getStatus(independent), Status::Done);
+    EXPECT_EQ(graph.getStatus(child), Status::Skipped);
+    EXPECT_EQ(graph.getStatus(both), Status::Skipped);
+    EXPECT_EQ(graph.getStatus(grandchild), Status::Skipped);
+    EXPECT_EQ(graph.getStatus(sibling), Status::Done);
+
+    EXPECT_EQ(ran, 2);
+    EXPECT_EQ(graph.getStats().failed, 1);
+    EXPECT_EQ(graph.getStats().skipped, 3);
+}
+
+TEST(TaskGraphTest, ThrowingTaskCountsAsFailed) {
+    TaskGraph graph;
+    bool dependentRan = false;
+    const auto throwing = graph.add("throwing", Affinity::Worker, []() -> bool {
+        throw std::runtime_error("broken asset");
+    });
+    const auto dependent = graph.add("dependent", Affinity::Main, [&] {
+        dependentRan = true;
+        return true;
+    }, {throwing});
+
+    EXPECT_FALSE(graph.run(1));
+    EXPECT_EQ(graph.getStatus(throwing), Status::Failed);
+    EXPECT_EQ(graph.getStatus(dependent), Status::Skipped);
+    EXPECT_FALSE(dependentRan);
+}
@@ -0,0 +1,22 @@
+/**
+ * @file   TestEnvironment.cpp
+ * @brief  Global set-up for the test executable.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#include <gtest/gtest.h>
+#include "utilities/Logger.h"
+
+namespace {
+    // engine code logs through Logger, so it has to exist before the first test runs
+    class LoggerEnvironment : public testing::Environment {
+    public:
+        void SetUp() override {
+            Logger::initialize();
+        }
+    };
+
+    [[maybe_unused]] const testing::Environment *const environment =
+            testing::AddGlobalTestEnvironment(new LoggerEnvironment);
+}
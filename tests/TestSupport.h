@@ -0,0 +1,30 @@
+/**
+ * @file   TestSupport.h
+ * @brief  Helpers shared by the test cases.
+ * @author Nur Akmal bin Jalil
+ * @date   2026-10-17
+ */
+
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// An empty directory under the system temp directory for the files of one test
+inline std::filesystem::path makeScratchDirectory(const std::string &name) {
+    const auto directory = std::filesystem::temp_directory_path() / "cbit_tests" / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+inline void writeFile(const std::filesystem::path &path, const std::string_view contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary).write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+
+#endif //TESTSUPPORT_H
@@ -0,0 +1,67 @@
+/**
+ * @file    AssetPacker.cpp
+ * @brief   Command line tool that packs a directory into a `.cbpak` archive.
+ * @details Usage:
+ *            CbitAssetPacker [--store] <directory> [out.cbpak]   pack every file under the directory
+ *            CbitAssetPacker --list <pack.cbpak>                 print the table of contents
+ *          Without arguments for the output the pack is written to `<directory>.cbpak`, so packing `resources`
+ *          produces the `resources.cbpak` the engine mounts at startup. `--store` turns off LZ4 compression.
+ * @author  Nur Akmal bin Jalil
+ * @date    2026-10-17
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "utilities/AssetPack.h"
+#include "utilities/Logger.h"
+
+namespace {
+    int list(const std::string &packPath) {
+        AssetPack pack;
+        if (!pack.mount(packPath)) {
+            return EXIT_FAILURE;
+        }
+
+        std::uint64_t size = 0;
+        std::uint64_t stored = 0;
+        for (const AssetPackEntry &entry: pack.getEntries()) {
+            std::cout << (entry.compression == AssetCompression::Lz4 ? "lz4   " : "store ")
+                    << entry.size << " -> " << entry.storedSize << "  " << pack.getPath(entry) << '\n';
+            size += entry.size;
+            stored += entry.storedSize;
+        }
+        std::cout << pack.getEntries().size() << " files, " << size << " bytes stored in " << stored << '\n';
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Logger::initialize();
+
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+
+    if (arguments.size() == 2 && arguments[0] == "--list") {
+        return list(arguments[1]);
+    }
+
+    bool compress = true;
+    if (!arguments.empty() && arguments[0] == "--store") {
+        compress = false;
+        arguments.erase(arguments.begin());
+    }
+
+    if (arguments.size() == 1 || arguments.size() == 2) {
+        const std::filesystem::path directory = std::filesystem::path(arguments[0]).lexically_normal();
+        const std::string output = arguments.size() == 2
+                                       ? arguments[1]
+                                       : directory.parent_path().append(directory.filename().string() + ".cbpak")
+                                       .string();
+        return AssetPack::build(directory, output, compress) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::cerr << "Usage: " << argv[0] << " [--store] <directory> [out.cbpak]\n"
+            << "       " << argv[0] << " --list <pack.cbpak>\n";
+    return EXIT_FAILURE;
+}